@@ -293,6 +293,13 @@ public:
 
   bool GetDescription(lldb::SBStream &description);
 
+  /// Print a description of this value, stopping once \a max_children
+  /// children have been printed or \a timeout_ms milliseconds have elapsed.
+  /// A value of zero disables the respective limit. If the output is
+  /// truncated, a marker is printed in place of the remaining children.
+  bool GetDescription(lldb::SBStream &description, uint32_t max_children,
+                      uint32_t timeout_ms);
+
   bool GetExpressionPath(lldb::SBStream &description);
 
   bool GetExpressionPath(lldb::SBStream &description,
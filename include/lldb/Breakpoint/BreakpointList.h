@@ -131,6 +131,12 @@ public:
   void UpdateBreakpoints(ModuleList &module_list, bool load,
                          bool delete_locations);
 
+  /// Look up the names and source files of all the breakpoints in the
+  /// modules in \a module_list at once, one module per thread, so that
+  /// resolving the breakpoints in them afterwards finds the symbols it needs
+  /// already parsed.
+  void PreloadBreakpointLookups(ModuleList &module_list);
+
   void UpdateBreakpointsWhenModuleIsReplaced(lldb::ModuleSP old_module_sp,
                                              lldb::ModuleSP new_module_sp);
 
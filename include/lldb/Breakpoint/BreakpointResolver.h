@@ -91,6 +91,13 @@ public:
   virtual void ResolveBreakpointInModules(SearchFilter &filter,
                                           ModuleList &modules);
 
+  /// Add the names this resolver looks up in a module to \a names, and the
+  /// file names of the source files it looks for to \a files. When modules
+  /// are loaded, these are looked up for all breakpoints at once before the
+  /// breakpoints are resolved one by one.
+  virtual void GetLookupNames(std::vector<ConstString> &names,
+                              std::vector<ConstString> &files) {}
+
   /// Prints a canonical description for the breakpoint to the stream \a s.
   ///
   /// \param[in] s
@@ -67,6 +67,9 @@ public:
 
   void Dump(Stream *s) const override;
 
+  void GetLookupNames(std::vector<ConstString> &names,
+                      std::vector<ConstString> &files) override;
+
   /// Methods for support type inquiry through isa, cast, and dyn_cast:
   static inline bool classof(const BreakpointResolverName *) { return true; }
   static inline bool classof(const BreakpointResolver *V) {
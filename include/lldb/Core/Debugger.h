@@ -218,7 +218,7 @@ public:
   bool EnableLog(llvm::StringRef channel,
                  llvm::ArrayRef<const char *> categories,
                  llvm::StringRef log_file, uint32_t log_options,
-                 llvm::raw_ostream &error_stream);
+                 llvm::raw_ostream &error_stream, size_t buffer_size = 0);
 
   void SetLoggingCallback(lldb::LogOutputCallback log_callback, void *baton);
 
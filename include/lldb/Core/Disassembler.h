@@ -30,6 +30,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -546,6 +547,56 @@ private:
   DISALLOW_COPY_AND_ASSIGN(Disassembler);
 };
 
+/// Caches the disassembled address ranges of one module.
+///
+/// Stepping disassembles the same function ranges over and over, both in the
+/// step range plans and when looking for the next branch to run to. As long
+/// as the bytes come from the module's file, the decoded
+/// instructions don't depend on the process, so they are kept here, keyed by
+/// the file address range and the disassembler that decoded them. Only the
+/// opcodes, their sizes and control-flow classes are decoded up front; the
+/// instruction text is still formatted the first time it is printed.
+class DisassemblerCache {
+public:
+  /// Find a disassembler that decoded exactly \a range with the given
+  /// architecture, flavor and plug-in.
+  lldb::DisassemblerSP Find(const AddressRange &range, const ArchSpec &arch,
+                            llvm::StringRef flavor,
+                            llvm::StringRef plugin_name) const;
+
+  void Insert(const AddressRange &range, const ArchSpec &arch,
+              llvm::StringRef flavor, llvm::StringRef plugin_name,
+              const lldb::DisassemblerSP &disasm_sp);
+
+  /// Drop all ranges that overlap the given file address range, e.g. because
+  /// the memory was written to.
+  void Invalidate(lldb::addr_t file_addr, lldb::addr_t size);
+
+  void Clear();
+
+  size_t GetSize() const;
+
+private:
+  struct Entry {
+    lldb::addr_t end;
+    ArchSpec arch;
+    std::string flavor;
+    std::string plugin_name;
+    lldb::DisassemblerSP disasm_sp;
+  };
+
+  /// The cache is emptied once it holds this many ranges, so that it doesn't
+  /// keep every function that was ever stepped through alive.
+  static constexpr size_t g_max_entries = 512;
+
+  mutable std::mutex m_mutex;
+  /// Entries by the file address they start at.
+  std::multimap<lldb::addr_t, Entry> m_entries;
+  /// The size of the largest cached range, which bounds how far before an
+  /// invalidated address an overlapping range can start.
+  lldb::addr_t m_max_range_size = 0;
+};
+
 } // namespace lldb_private
 
 #endif // liblldb_Disassembler_h_
@@ -39,6 +39,7 @@
 
 namespace lldb_private {
 class CompilerDeclContext;
+class DisassemblerCache;
 class Function;
 class Log;
 class ObjectFile;
@@ -602,6 +603,14 @@ public:
   ///     Unified module section list.
   virtual SectionList *GetSectionList();
 
+  /// Check whether the section list of this module has been created, without
+  /// creating it.
+  ///
+  /// \return
+  ///     \b true if the sections of the module have been parsed, \b false
+  ///     otherwise.
+  bool HasParsedSections();
+
   /// Notify the module that the file addresses for the Sections have been
   /// updated.
   ///
@@ -624,6 +633,11 @@ public:
   ///     associated object file, an empty UnwindTable is returned.
   UnwindTable &GetUnwindTable();
 
+  /// Returns the cache of address ranges in this module that have been
+  /// disassembled from the module's file. The cache is created with the
+  /// module and does its own locking, so this doesn't take the module mutex.
+  DisassemblerCache &GetDisassemblerCache();
+
   llvm::VersionTuple GetVersion();
 
   /// Load an object file from memory.
@@ -992,6 +1006,8 @@ protected:
   llvm::Optional<UnwindTable> m_unwind_table; ///< Table of FuncUnwinders
                                               /// objects created for this
                                               /// Module's functions
+  std::unique_ptr<DisassemblerCache>
+      m_disassembler_cache_up; ///< Ranges disassembled from this Module
   lldb::SymbolVendorUP
       m_symfile_up; ///< A pointer to the symbol vendor for this module.
   std::vector<lldb::SymbolVendorUP>
@@ -53,6 +53,11 @@ public:
   bool SetClangModulesCachePath(llvm::StringRef path);
   bool GetEnableExternalLookup() const;
   bool SetEnableExternalLookup(bool new_value);
+  bool GetParallelModuleSearch() const;
+  bool SetParallelModuleSearch(bool new_value);
+  FileSpec GetSymbolCachePath() const;
+  bool SetSymbolCachePath(llvm::StringRef path);
+  uint64_t GetSymbolCacheMaxSize() const;
 }; 
 
 /// \class ModuleList ModuleList.h "lldb/Core/ModuleList.h"
@@ -516,6 +521,15 @@ protected:
 
   void ClearImpl(bool use_notifier = true);
 
+  /// Runs \p search on every module, collecting the matches of each module
+  /// in a list of its own, and then hands these lists to \p merge in module
+  /// order to be added to \p results. The modules are searched on the task
+  /// pool when symbols.parallel-module-search is set. Any symbol tables or
+  /// indexes the modules still have to build then get built concurrently.
+  template <typename ResultList, typename SearchFn, typename MergeFn>
+  void SearchModules(ResultList &results, SearchFn search,
+                     MergeFn merge) const;
+
   // Member variables.
   collection m_modules; ///< The collection of modules.
   mutable std::recursive_mutex m_modules_mutex;
@@ -0,0 +1,80 @@
+//===-- NameCorpus.h --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_NameCorpus_h_
+#define liblldb_NameCorpus_h_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lldb/Utility/ConstString.h"
+
+namespace lldb_private {
+
+class RegularExpression;
+
+/// \class NameCorpus NameCorpus.h "lldb/Core/NameCorpus.h"
+/// A set of names, each with a list of values, for searching by regular
+/// expression.
+///
+/// Name indexes hold each name once per value, and their names are spread
+/// all over the string pool. A corpus holds each distinct name once, with
+/// all names back to back in one buffer. A search first looks for the
+/// substring every match has to contain in the whole buffer, and only
+/// executes the regular expression on the names containing it. The buffer is
+/// searched in chunks in parallel.
+///
+/// Call Append() for all names, then Finalize() once before searching.
+class NameCorpus {
+public:
+  void Append(ConstString name, uint32_t value) {
+    m_pending.emplace_back(name, value);
+  }
+
+  /// Move the appended names into the searchable buffer, replacing any
+  /// names finalized before.
+  void Finalize();
+
+  void Clear();
+
+  /// Get the number of distinct names.
+  size_t GetSize() const {
+    return m_name_offsets.empty() ? 0 : m_name_offsets.size() - 1;
+  }
+
+  /// Append the values of all names that \a regex matches to \a values, in
+  /// increasing order.
+  void FindValues(const RegularExpression &regex,
+                  std::vector<uint32_t> &values) const;
+
+  /// Get the number of bytes of memory used by this corpus.
+  size_t MemorySize() const;
+
+private:
+  /// Search the names with indexes [begin, end).
+  void FindValues(const RegularExpression &regex, size_t begin, size_t end,
+                  std::vector<uint32_t> &values) const;
+
+  void AppendValues(size_t name_idx, std::vector<uint32_t> &values) const;
+
+  std::vector<std::pair<ConstString, uint32_t>> m_pending;
+  /// The names, each followed by a NUL character.
+  std::string m_data;
+  /// The offset of each name in m_data, followed by the size of m_data.
+  std::vector<uint64_t> m_name_offsets;
+  /// The values of name i are m_values[m_value_offsets[i]] up to
+  /// m_values[m_value_offsets[i + 1]].
+  std::vector<uint32_t> m_value_offsets;
+  std::vector<uint32_t> m_values;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_NameCorpus_h_
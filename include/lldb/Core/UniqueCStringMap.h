@@ -14,6 +14,7 @@
 
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
+#include "llvm/ADT/ArrayRef.h"
 
 namespace lldb_private {
 
@@ -127,6 +128,30 @@ public:
     return values.size() - start_size;
   }
 
+  // Get the values for several names at once, appending the values of
+  // unique_cstrs[i] to values[i]. The names are visited in the map's order,
+  // so each search only has to look at the part of the map after the
+  // previous match.
+  void GetValues(llvm::ArrayRef<ConstString> unique_cstrs,
+                 std::vector<std::vector<T>> &values) const {
+    values.resize(unique_cstrs.size());
+
+    std::vector<size_t> order(unique_cstrs.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    llvm::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+      return Compare()(unique_cstrs[lhs], unique_cstrs[rhs]);
+    });
+
+    const_iterator pos = m_map.begin(), end = m_map.end();
+    for (size_t i : order) {
+      pos = std::lower_bound(pos, end, unique_cstrs[i], Compare());
+      for (const_iterator match = pos;
+           match != end && match->cstring == unique_cstrs[i]; ++match)
+        values[i].push_back(match->value);
+    }
+  }
+
   size_t GetValues(const RegularExpression &regex,
                    std::vector<T> &values) const {
     const size_t start_size = values.size();
@@ -14,6 +14,7 @@
 #include "lldb/lldb-private.h"
 #include "lldb/lldb-public.h"
 
+#include <chrono>
 #include <functional>
 #include <string>
 
@@ -127,6 +128,15 @@ public:
   DumpValueObjectOptions &
   SetPointerAsArray(const PointerAsArraySettings &ptr_array);
 
+  /// Stop printing once \a max_children children have been printed in
+  /// total, at any depth. Zero means no limit.
+  DumpValueObjectOptions &SetChildrenBudget(uint32_t max_children = 0);
+
+  /// Stop printing once \a timeout has elapsed since the root value started
+  /// printing. Zero means no limit.
+  DumpValueObjectOptions &
+  SetTimeBudget(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
 public:
   uint32_t m_max_depth = UINT32_MAX;
   lldb::DynamicValueType m_use_dynamic = lldb::eNoDynamicValues;
@@ -138,6 +148,8 @@ public:
   PointerDepth m_max_ptr_depth;
   DeclPrintingHelper m_decl_printing_helper;
   PointerAsArraySettings m_pointer_as_array;
+  uint32_t m_children_budget = 0;
+  std::chrono::milliseconds m_time_budget = std::chrono::milliseconds(0);
   bool m_use_synthetic : 1;
   bool m_scope_already_checked : 1;
   bool m_flat_output : 1;
@@ -201,6 +201,9 @@ public:
     Deleter m_deleter;
   };
 
+  // Escaping helpers are only consulted for bytes that are not printable
+  // ASCII, or that are the double quote or the backslash. Runs of all other
+  // bytes are copied to the stream verbatim.
   typedef std::function<StringPrinter::StringPrinterBufferPointer<
       uint8_t, char, size_t>(uint8_t *, uint8_t *, uint8_t *&)>
       EscapingHelper;
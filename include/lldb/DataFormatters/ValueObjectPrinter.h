@@ -19,6 +19,8 @@
 #include "lldb/DataFormatters/DumpValueObjectOptions.h"
 #include "lldb/Symbol/CompilerType.h"
 
+#include <chrono>
+
 namespace lldb_private {
 
 class ValueObjectPrinter {
@@ -38,13 +40,28 @@ protected:
 
   InstancePointersSetSP m_printed_instance_pointers;
 
+  /// Progress of the whole print operation, shared between a printer and the
+  /// printers it creates for the children, and checked against the budget in
+  /// the options.
+  struct PrintingBudget {
+    uint32_t num_children_printed = 0;
+    std::chrono::steady_clock::time_point start_time =
+        std::chrono::steady_clock::now();
+    bool exhausted = false;
+    bool marker_printed = false;
+  };
+  typedef std::shared_ptr<PrintingBudget> PrintingBudgetSP;
+
+  PrintingBudgetSP m_budget;
+
   // only this class (and subclasses, if any) should ever be concerned with the
   // depth mechanism
   ValueObjectPrinter(ValueObject *valobj, Stream *s,
                      const DumpValueObjectOptions &options,
                      const DumpValueObjectOptions::PointerDepth &ptr_depth,
                      uint32_t curr_depth,
-                     InstancePointersSetSP printed_instance_pointers);
+                     InstancePointersSetSP printed_instance_pointers,
+                     PrintingBudgetSP budget);
 
   // we should actually be using delegating constructors here but some versions
   // of GCC still have trouble with those
@@ -52,7 +69,8 @@ protected:
             const DumpValueObjectOptions &options,
             const DumpValueObjectOptions::PointerDepth &ptr_depth,
             uint32_t curr_depth,
-            InstancePointersSetSP printed_instance_pointers);
+            InstancePointersSetSP printed_instance_pointers,
+            PrintingBudgetSP budget = nullptr);
 
   bool GetMostSpecializedValue();
 
@@ -116,6 +134,10 @@ protected:
 
   uint32_t GetMaxNumChildrenToPrint(bool &print_dotdotdot);
 
+  bool IsBudgetExhausted();
+
+  void PrintBudgetExhaustedMarker();
+
   void
   PrintChildren(bool value_printed, bool summary_printed,
                 const DumpValueObjectOptions::PointerDepth &curr_ptr_depth);
@@ -23,6 +23,8 @@
 
 #cmakedefine01 HAVE_SYS_EVENT_H
 
+#cmakedefine01 HAVE_SYS_EPOLL_H
+
 #cmakedefine01 HAVE_PPOLL
 
 #cmakedefine01 HAVE_SIGACTION
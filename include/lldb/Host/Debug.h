@@ -24,6 +24,9 @@ struct ResumeAction {
                          // eStateRunning, and eStateStepping.
   int signal; // When resuming this thread, resume it with this signal if this
               // value is > 0
+  lldb::addr_t step_range_start = LLDB_INVALID_ADDRESS; // When stepping, keep
+  lldb::addr_t step_range_end = LLDB_INVALID_ADDRESS;   // stepping while the
+                                                        // pc is in this range
 };
 
 // A class that contains instructions for all threads for
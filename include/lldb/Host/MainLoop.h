@@ -13,17 +13,23 @@
 #include "lldb/Host/MainLoopBase.h"
 #include "llvm/ADT/DenseMap.h"
 #include <csignal>
+#include <vector>
 
-#if !HAVE_PPOLL && !HAVE_SYS_EVENT_H && !defined(__ANDROID__)
+#if !HAVE_SYS_EVENT_H && HAVE_SYS_EPOLL_H && !defined(__ANDROID__)
+#define MAINLOOP_USE_EPOLL 1
+#endif
+
+#if !HAVE_PPOLL && !HAVE_SYS_EVENT_H && !defined(MAINLOOP_USE_EPOLL) &&       \
+    !defined(__ANDROID__)
 #define SIGNAL_POLLING_UNSUPPORTED 1
 #endif
 
 namespace lldb_private {
 
 // Implementation of the MainLoopBase class. It can monitor file descriptors
-// for readability using ppoll, kqueue, poll or WSAPoll. On Windows it only
-// supports polling sockets, and will not work on generic file handles or
-// pipes. On systems without kqueue or ppoll handling singnals is not
+// for readability using kqueue, epoll, ppoll, poll or WSAPoll. On Windows it
+// only supports polling sockets, and will not work on generic file handles or
+// pipes. On systems without kqueue, epoll or ppoll handling singnals is not
 // supported. In addition to the common base, this class provides the ability
 // to invoke a given handler when a signal is received.
 //
@@ -102,6 +108,11 @@ private:
   llvm::DenseMap<int, SignalInfo> m_signals;
 #if HAVE_SYS_EVENT_H
   int m_kqueue;
+#elif defined(MAINLOOP_USE_EPOLL)
+  int m_epoll;
+  /// Descriptors epoll can't wait for, like regular files. These are always
+  /// readable, as far as poll is concerned.
+  std::vector<IOObject::WaitableHandle> m_always_readable_fds;
 #endif
   bool m_terminate_request : 1;
 };
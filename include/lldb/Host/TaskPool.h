@@ -79,9 +79,9 @@ template <> struct TaskPool::RunTaskImpl<> {
   static void Run() {}
 };
 
-// Run 'func' on every value from begin .. end-1.  Each worker will grab
-// 'batch_size' numbers at a time to work on, so for very fast functions, batch
-// should be large enough to avoid too much cache line contention.
+// Run 'func' on every value from begin .. end-1.  The calling thread takes
+// part in the work and never waits for tasks that haven't started, so unlike
+// other blocking uses of the pool this may be called from within a task.
 void TaskMapOverInt(size_t begin, size_t end,
                     const llvm::function_ref<void(size_t)> &func);
 
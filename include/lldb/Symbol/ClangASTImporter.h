@@ -65,6 +65,18 @@ public:
     ++local_counters.m_record_layout_count;
   }
 
+  /// Returns the number of Decls Clang imported since the local counters were
+  /// last cleared.
+  static uint64_t GetLocalClangImportCount() {
+    return local_counters.m_clang_import_count;
+  }
+
+  /// Returns the number of Decls completed since the local counters were last
+  /// cleared.
+  static uint64_t GetLocalDeclCompletionCount() {
+    return local_counters.m_decls_completed_count;
+  }
+
 private:
   struct Counters {
     uint64_t m_visible_query_count;
@@ -14,6 +14,8 @@
 #include "lldb/Symbol/LineEntry.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 namespace lldb_private {
@@ -209,6 +211,16 @@ public:
 
   LineTable *LinkLineTable(const FileRangeMap &file_range_map);
 
+  /// Move the entries added so far into the compact representation that
+  /// lookups use. This is done automatically by the first lookup, and by
+  /// CompileUnit::SetLineTable(), so that lookups on a finished line table
+  /// don't modify it. Adding more entries afterwards is possible but has to
+  /// expand the table again.
+  void Finalize();
+
+  /// Get the number of bytes of memory used by this line table.
+  size_t MemorySize() const;
+
 protected:
   struct Entry {
     Entry()
@@ -316,11 +328,39 @@ protected:
       section_collection; ///< The collection type for the sections.
   typedef std::vector<Entry>
       entry_collection; ///< The collection type for the line entries.
+
+  /// The number of entries that share one full address in m_block_addrs.
+  static constexpr uint32_t AddressBlockSize = 16;
+
   // Member variables.
   CompileUnit
       *m_comp_unit; ///< The compile unit that this line table belongs to.
-  entry_collection
-      m_entries; ///< The collection of line entries in this line table.
+  /// Entries that have been added to this line table but not packed into
+  /// the columns below yet. At most one of the two representations holds
+  /// entries at any time.
+  entry_collection m_entries;
+
+  /// The packed line table, sorted by address, one column per field. The
+  /// file address of the first entry of every AddressBlockSize entries.
+  std::vector<lldb::addr_t> m_block_addrs;
+  /// The file address of each entry as an offset from the first address of
+  /// its block, or UINT16_MAX if it doesn't fit, in which case the address
+  /// is found in m_far_addrs.
+  std::vector<uint16_t> m_addr_deltas;
+  /// The entry index and file address of entries too far from the start of
+  /// their block, sorted by entry index.
+  std::vector<std::pair<uint32_t, lldb::addr_t>> m_far_addrs;
+  /// The line number of each entry in the low 27 bits, and its flags above.
+  std::vector<uint32_t> m_lines;
+  std::vector<uint16_t> m_columns;
+  std::vector<uint16_t> m_file_idxs;
+
+  /// The indexes of all non-terminal entries, sorted by file index, line
+  /// and then entry index, so that lookups by line are binary searches.
+  /// Built on the first lookup by line.
+  std::vector<uint32_t> m_line_index;
+  std::atomic<bool> m_line_index_valid;
+  std::mutex m_line_index_mutex;
 
   // Helper class
   class LineSequenceImpl : public LineSequence {
@@ -337,6 +377,32 @@ protected:
 
   bool ConvertEntryAtIndexToLineEntry(uint32_t idx, LineEntry &line_entry);
 
+  /// Move the packed entries back into m_entries so that more entries can
+  /// be inserted.
+  void Unpack();
+
+  void AppendPackedEntry(const Entry &entry);
+
+  Entry GetEntryAtIndex(uint32_t idx) const;
+
+  lldb::addr_t GetFileAddressAtIndex(uint32_t idx) const;
+
+  uint32_t GetLineAtIndex(uint32_t idx) const;
+
+  bool IsTerminalEntryAtIndex(uint32_t idx) const;
+
+  /// Find the index of the first packed entry whose address is not less
+  /// than \a file_addr, or GetSize() if there is none.
+  uint32_t LowerBoundForAddress(lldb::addr_t file_addr) const;
+
+  const std::vector<uint32_t> &GetLineIndex();
+
+  /// Find the first entry at or after \a start_idx with file index \a
+  /// file_idx and the lowest line number that is at least \a line, or
+  /// exactly \a line if \a exact is true.
+  uint32_t FindEntryIndexByFileIndex(uint32_t start_idx, uint32_t file_idx,
+                                     uint32_t line, bool exact);
+
 private:
   DISALLOW_COPY_AND_ASSIGN(LineTable);
 };
@@ -21,6 +21,8 @@
 #include "lldb/lldb-private.h"
 #include "llvm/Support/VersionTuple.h"
 
+#include <chrono>
+
 namespace lldb_private {
 
 class ObjectFileJITDelegate {
@@ -318,6 +320,14 @@ public:
   ///     The symbol table for this object file.
   virtual Symtab *GetSymtab() = 0;
 
+  /// Read the symbol table that an earlier session cached for this object
+  /// file, without affecting the one GetSymtab() returns.
+  ///
+  /// \return
+  ///     The cached symbol table, or null if the object file can't be cached
+  ///     or there is no up to date cache entry for it.
+  virtual std::unique_ptr<Symtab> ReadCachedSymtab() { return nullptr; }
+
   /// Perform relocations on the section if necessary.
   ///
   virtual void RelocateSection(lldb_private::Section *section);
@@ -634,6 +644,12 @@ public:
 
   bool IsInMemory() const { return m_memory_addr != LLDB_INVALID_ADDRESS; }
 
+  /// The time spent so far decompressing the contents of compressed sections
+  /// of this object file.
+  virtual std::chrono::nanoseconds GetSectionDecompressionTime() const {
+    return std::chrono::nanoseconds(0);
+  }
+
   // Strip linker annotations (such as @@VERSION) from symbol names.
   virtual llvm::StringRef
   StripLinkerSymbolAnnotations(llvm::StringRef symbol_name) const {
@@ -14,6 +14,8 @@
 #include "lldb/Symbol/SymbolContextScope.h"
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 
 namespace lldb_private {
 
@@ -221,6 +223,21 @@ public:
 
   bool ContainsFileAddress(lldb::addr_t file_addr) const;
 
+  /// Serialize this symbol for the symbol table cache. Names are written as
+  /// indexes into a string table, which \a string_index maps them to.
+  void Encode(Stream &strm,
+              llvm::function_ref<uint32_t(ConstString)> string_index) const;
+
+  /// Restore a symbol written by Encode. Section offset addresses are
+  /// resolved by section ID in \a section_list.
+  ///
+  /// \return
+  ///     False if the data is truncated or refers to a string or section
+  ///     that doesn't exist.
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+              const SectionList *section_list,
+              llvm::ArrayRef<ConstString> strings);
+
 protected:
   // This is the internal guts of ResolveReExportedSymbol, it assumes
   // reexport_name is not null, and that module_spec is valid.  We track the
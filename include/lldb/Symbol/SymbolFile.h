@@ -172,6 +172,25 @@ public:
                                         lldb::SymbolContextItem resolve_scope,
                                         SymbolContextList &sc_list);
 
+  /// Find the compile units whose line tables may refer to a file with the
+  /// given name, without parsing their line tables.
+  ///
+  /// \param[in] filename
+  ///     The file name without any directory. It may differ in case from
+  ///     the names of files with Windows paths, which still match.
+  ///
+  /// \param[out] cu_indexes
+  ///     The sorted indexes of the compile units, as used by
+  ///     GetCompileUnitAtIndex(), that may refer to the file.
+  ///
+  /// \return
+  ///     True if \a cu_indexes was filled in, false if this symbol file
+  ///     cannot tell, in which case every compile unit has to be searched.
+  virtual bool FindCompileUnitsForFile(ConstString filename,
+                                       std::vector<uint32_t> &cu_indexes) {
+    return false;
+  }
+
   virtual void DumpClangAST(Stream &s) {}
   virtual uint32_t
   FindGlobalVariables(ConstString name,
@@ -209,6 +228,12 @@ public:
 
   virtual void PreloadSymbols();
 
+  /// Prepare for lookups of several names that are known to be coming, e.g.
+  /// the identifiers of an expression, by finding all of them in one pass
+  /// and parsing whatever debug info they live in up front. The lookups
+  /// themselves still go through the usual Find* methods.
+  virtual void PreloadNames(llvm::ArrayRef<ConstString> names);
+
   virtual llvm::Expected<lldb_private::TypeSystem &>
   GetTypeSystemForLanguage(lldb::LanguageType language);
 
@@ -9,10 +9,12 @@
 #ifndef liblldb_Symtab_h_
 #define liblldb_Symtab_h_
 
+#include "lldb/Core/NameCorpus.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -129,6 +131,20 @@ public:
     }
   }
 
+  /// Serialize the symbols along with their name and address indexes, so
+  /// that a later session can restore them with Decode instead of parsing
+  /// and demangling them again. The indexes are computed first if need be.
+  void Encode(Stream &strm);
+
+  /// Fill an empty symbol table from data written by Encode. Section offset
+  /// addresses are resolved by section ID in \a section_list.
+  ///
+  /// \return
+  ///     False if the data is malformed or was written by a different version
+  ///     of the format, in which case the symbol table is left empty.
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+              const SectionList *section_list);
+
   void AppendSymbolNamesToMap(const IndexCollection &indexes,
                               bool add_demangled, bool add_mangled,
                               NameToIndexMap &name_to_index_map) const;
@@ -143,6 +159,9 @@ protected:
       FileRangeToIndexMap;
   void InitNameIndexes();
   void InitAddressIndexes();
+  /// Get the names of all symbols with their indexes, for searching by
+  /// regular expression.
+  const NameCorpus &GetNameCorpus();
 
   ObjectFile *m_objfile;
   collection m_symbols;
@@ -151,6 +170,7 @@ protected:
   UniqueCStringMap<uint32_t> m_basename_to_index;
   UniqueCStringMap<uint32_t> m_method_to_index;
   UniqueCStringMap<uint32_t> m_selector_to_index;
+  std::unique_ptr<NameCorpus> m_name_corpus;
   mutable std::recursive_mutex
       m_mutex; // Provide thread safety for this symbol table
   bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1;
@@ -18,8 +18,11 @@
 #include "lldb/lldb-private-enumerations.h"
 #include "lldb/lldb-types.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 namespace lldb_private {
 class ModuleList;
 class Process;
@@ -217,6 +220,18 @@ public:
                                              lldb::addr_t base_addr,
                                              bool base_addr_is_offset);
 
+  /// Locates, creates and parses the modules given by \p files in parallel,
+  /// so that loading them one by one with LoadModuleAtAddress() afterwards
+  /// finds them ready in the shared module list. Files whose module is
+  /// already in the target are skipped. This leaves the target's module list
+  /// and section load list untouched.
+  ///
+  /// \return
+  ///     The prefetched modules, in the order of \p files. The caller should
+  ///     hold on to them until they have been loaded.
+  std::vector<lldb::ModuleSP>
+  PrefetchModules(llvm::ArrayRef<lldb_private::FileSpec> files);
+
   /// Get information about the shared cache for a process, if possible.
   ///
   /// On some systems (e.g. Darwin based systems), a set of libraries that are
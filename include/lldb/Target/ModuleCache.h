@@ -15,6 +15,8 @@
 #include "lldb/Host/File.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Status.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
 
 #include <functional>
 #include <string>
@@ -43,6 +45,12 @@ class UUID;
 /// /tmp/lldb/remote-
 /// linux/.cache/30C94DC6-6A1F-E951-80C3-D68D2B89E576-D5AE213C/libc.so.6
 /// Sysroot view: /tmp/lldb/remote-linux/ubuntu/lib/x86_64-linux-gnu/libc.so.6
+///
+/// The UUID view can also be used directly as a content-addressed store for
+/// anything that belongs to a module: object files, separate debug files and
+/// data derived from parsing them. Entries are installed atomically and
+/// guarded by the same per-UUID file locks, so that several debuggers can
+/// share one cache directory.
 
 class ModuleCache {
 public:
@@ -57,6 +65,42 @@ public:
                    const SymfileDownloader &symfile_downloader,
                    lldb::ModuleSP &cached_module_sp, bool *did_create_ptr);
 
+  /// Look up the entry named \a entry_name of the module with \a uuid.
+  ///
+  /// \return
+  ///     The path of the cached file, or an empty FileSpec if there is none.
+  ///     A successful lookup marks the module as recently used. The cached
+  ///     file itself, including its timestamps, is left untouched.
+  static FileSpec GetEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                           llvm::StringRef entry_name);
+
+  /// Install a copy of \a file_spec as the entry named \a entry_name of the
+  /// module with \a uuid, replacing any existing entry.
+  static Status PutEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                         llvm::StringRef entry_name, const FileSpec &file_spec);
+
+  /// Install \a data as the entry named \a entry_name of the module with
+  /// \a uuid, replacing any existing entry.
+  static Status PutEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                         llvm::StringRef entry_name,
+                         llvm::ArrayRef<uint8_t> data);
+
+  /// Remove the least recently used modules from the cache until the files
+  /// in it take up no more than \a max_size bytes. Temporary files left
+  /// behind by interrupted writes are removed as well.
+  ///
+  /// \return
+  ///     The number of bytes the cache takes up afterwards.
+  static uint64_t Prune(const FileSpec &root_dir_spec, uint64_t max_size);
+
+  /// Note that \a added_size bytes were added to the cache, and prune it if
+  /// that may have taken it past \a max_size bytes. Scanning the cache is
+  /// expensive, so this only happens for the first entry a process adds and
+  /// whenever the entries it added since the last scan could have crossed
+  /// the limit.
+  static void PruneIfNeeded(const FileSpec &root_dir_spec, uint64_t max_size,
+                            uint64_t added_size);
+
 private:
   Status Put(const FileSpec &root_dir_spec, const char *hostname,
              const ModuleSpec &module_spec, const FileSpec &tmp_file,
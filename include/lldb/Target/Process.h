@@ -1802,6 +1802,10 @@ public:
     return error;
   }
 
+  /// Returns true if this process can step a thread through a range of
+  /// addresses without stopping, see Thread::GetResumeStepRange().
+  virtual bool SupportsRangeStepping() { return false; }
+
   lldb::ModuleSP ReadModuleFromMemory(const FileSpec &file_spec,
                                       lldb::addr_t header_addr,
                                       size_t size_to_read = 512);
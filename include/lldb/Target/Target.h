@@ -9,6 +9,7 @@
 #ifndef liblldb_Target_h_
 #define liblldb_Target_h_
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
@@ -88,6 +89,10 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
+  bool GetLazyModuleParsing() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -131,6 +136,10 @@ public:
 
   bool GetEnableImportStdModule() const;
 
+  bool GetEnableLazyTypeImport() const;
+
+  bool GetPreloadExpressionNames() const;
+
   bool GetEnableAutoApplyFixIts() const;
 
   bool GetEnableNotifyAboutFixIts() const;
@@ -1269,6 +1278,10 @@ protected:
 
   void NotifyWillClearList(const ModuleList &module_list) override;
 
+  /// Resolve the breakpoints in newly loaded modules, and count the time
+  /// this takes in the statistics.
+  void ResolveBreakpointsInLoadedModules(ModuleList &module_list);
+
   void NotifyModulesRemoved(lldb_private::ModuleList &module_list) override;
 
   class Arch {
@@ -1335,23 +1348,24 @@ protected:
 
   // Utilities for `statistics` command.
 private:
-  std::vector<uint32_t> m_stats_storage;
+  std::vector<uint64_t> m_stats_storage;
   bool m_collecting_stats = false;
+  std::chrono::nanoseconds m_breakpoint_resolution_time{0};
 
 public:
   void SetCollectingStats(bool v) { m_collecting_stats = v; }
 
   bool GetCollectingStats() { return m_collecting_stats; }
 
-  void IncrementStats(lldb_private::StatisticKind key) {
+  void IncrementStats(lldb_private::StatisticKind key, uint64_t count = 1) {
     if (!GetCollectingStats())
       return;
     lldbassert(key < lldb_private::StatisticKind::StatisticMax &&
                "invalid statistics!");
-    m_stats_storage[key] += 1;
+    m_stats_storage[key] += count;
   }
 
-  std::vector<uint32_t> GetStatistics() { return m_stats_storage; }
+  std::vector<uint64_t> GetStatistics();
 
 private:
   /// Construct with optional file and arch.
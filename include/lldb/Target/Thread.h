@@ -157,6 +157,17 @@ public:
 
   void SetResumeSignal(int signal) { m_resume_signal = signal; }
 
+  /// Get the range of load addresses [start, end) that the current plan would
+  /// single step this thread through, if it is resuming by stepping.
+  ///
+  /// \return
+  ///     False if the thread should stop after each step.
+  bool GetResumeStepRange(lldb::addr_t &start, lldb::addr_t &end) const {
+    start = m_resume_step_range_start;
+    end = m_resume_step_range_end;
+    return start != LLDB_INVALID_ADDRESS && start < end;
+  }
+
   lldb::StateType GetState() const;
 
   void SetState(lldb::StateType state);
@@ -1249,6 +1260,10 @@ protected:
                                            ///the last time this thread stopped.
   int m_resume_signal; ///< The signal that should be used when continuing this
                        ///thread.
+  lldb::addr_t m_resume_step_range_start = LLDB_INVALID_ADDRESS;
+  lldb::addr_t m_resume_step_range_end =
+      LLDB_INVALID_ADDRESS; ///< The range this thread may step through without
+                            ///stopping when it resumes.
   lldb::StateType m_resume_state; ///< This state is used to force a thread to
                                   ///be suspended from outside the ThreadPlan
                                   ///logic.
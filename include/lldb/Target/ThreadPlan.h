@@ -429,6 +429,14 @@ public:
   // then calls DoWillResume.
   bool WillResume(lldb::StateType resume_state, bool current_plan);
 
+  // When this plan single steps the thread, it can return the range of load
+  // addresses [start, end) it would keep stepping through anyway. Process
+  // plug-ins that support it will then step through the range without
+  // stopping until the pc leaves it.
+  virtual bool GetResumeStepRange(lldb::addr_t &start, lldb::addr_t &end) {
+    return false;
+  }
+
   virtual bool WillStop() = 0;
 
   bool IsMasterPlan() { return m_is_master_plan; }
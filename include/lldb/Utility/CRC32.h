@@ -0,0 +1,38 @@
+//===-- CRC32.h -------------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_CRC32_H
+#define LLDB_UTILITY_CRC32_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stdint.h>
+
+namespace lldb_private {
+
+/// Computes the CRC-32 used by zlib and by .gnu_debuglink sections (the
+/// reflected 0x04C11DB7 polynomial) of \a data, continuing from \a crc, the
+/// CRC of whatever data came before it.
+///
+/// On x86-64 hosts that support it this folds the data with carry-less
+/// multiplication. Note that the SSE4.2 crc32 instruction is no use here, as
+/// it computes the Castagnoli polynomial.
+uint32_t CalculateCRC32(uint32_t crc, llvm::ArrayRef<uint8_t> data);
+
+/// Computes the same CRC as CalculateCRC32 with a portable slicing-by-8
+/// table lookup, regardless of what the host supports.
+uint32_t CalculateCRC32Portable(uint32_t crc, llvm::ArrayRef<uint8_t> data);
+
+/// Given the CRC-32 \a crc_a of some block A and the CRC-32 \a crc_b of a
+/// block B of \a length_b bytes, both computed starting from zero, returns the
+/// CRC-32 of A followed by B. This lets blocks be checksummed independently.
+uint32_t CombineCRC32(uint32_t crc_a, uint32_t crc_b, uint64_t length_b);
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_CRC32_H
@@ -191,6 +191,14 @@ public:
 
   ~Event();
 
+  // Create an event whose memory, together with that of its shared pointer,
+  // is recycled once the last reference to it goes away. Use this for events
+  // that are broadcast often.
+  static lldb::EventSP Create(uint32_t event_type, EventData *data = nullptr);
+
+  static lldb::EventSP Create(uint32_t event_type,
+                              const lldb::EventDataSP &event_data_sp);
+
   void Dump(Stream *s) const;
 
   EventData *GetData() { return m_data_sp.get(); }
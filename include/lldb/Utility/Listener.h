@@ -14,6 +14,7 @@
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-forward.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <map>
@@ -114,6 +115,19 @@ private:
   typedef std::vector<lldb::BroadcasterManagerWP>
       broadcaster_manager_collection;
 
+  // An event added by a broadcaster that hasn't been moved to m_events yet.
+  struct PendingEvent {
+    lldb::EventSP event_sp;
+    PendingEvent *next;
+  };
+
+  // Moves the events from m_pending_events to the end of m_events. Callers
+  // must hold m_events_mutex.
+  void MovePendingEvents();
+
+  // Frees the events in m_pending_events without delivering them.
+  void DiscardPendingEvents();
+
   bool
   FindNextEventInternal(std::unique_lock<std::mutex> &lock,
                         Broadcaster *broadcaster, // nullptr for any broadcaster
@@ -133,6 +147,13 @@ private:
   event_collection m_events;
   std::mutex m_events_mutex; // Protects m_broadcasters and m_events
   std::condition_variable m_events_condition;
+  // Broadcasters push their events onto this lock-free stack, most recent
+  // first, so that adding an event doesn't contend with the listener's
+  // thread for m_events_mutex.
+  std::atomic<PendingEvent *> m_pending_events;
+  // The number of threads waiting on m_events_condition. Broadcasters only
+  // need to wake up the listener if this isn't zero.
+  std::atomic<uint32_t> m_num_waiters;
   broadcaster_manager_collection m_broadcaster_managers;
 
   void BroadcasterWillDestruct(Broadcaster *);
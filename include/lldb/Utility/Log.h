@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace llvm {
 class raw_ostream;
@@ -42,6 +43,7 @@ class raw_ostream;
 #define LLDB_LOG_OPTION_BACKTRACE (1U << 7)
 #define LLDB_LOG_OPTION_APPEND (1U << 8)
 #define LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION (1U << 9)
+#define LLDB_LOG_OPTION_ASYNC (1U << 10)
 
 // Logging Functions
 namespace lldb_private {
@@ -100,11 +102,15 @@ public:
   static void Register(llvm::StringRef name, Channel &channel);
   static void Unregister(llvm::StringRef name);
 
+  // Enable the given categories of a channel. With a non-zero buffer_size,
+  // the messages aren't written to the stream, but kept in a buffer holding
+  // the last buffer_size bytes of them, which DumpLogChannel writes out. The
+  // buffers are also dumped to stderr if the process crashes.
   static bool
   EnableLogChannel(const std::shared_ptr<llvm::raw_ostream> &log_stream_sp,
                    uint32_t log_options, llvm::StringRef channel,
                    llvm::ArrayRef<const char *> categories,
-                   llvm::raw_ostream &error_stream);
+                   llvm::raw_ostream &error_stream, size_t buffer_size = 0);
 
   static bool DisableLogChannel(llvm::StringRef channel,
                                 llvm::ArrayRef<const char *> categories,
@@ -113,6 +119,16 @@ public:
   static bool ListChannelCategories(llvm::StringRef channel,
                                     llvm::raw_ostream &stream);
 
+  // Write out the messages buffered by a channel that was enabled with a
+  // buffer size.
+  static bool DumpLogChannel(llvm::StringRef channel,
+                             llvm::raw_ostream &output_stream,
+                             llvm::raw_ostream &error_stream);
+
+  // Wait until the messages logged with LLDB_LOG_OPTION_ASYNC so far have
+  // been written to their streams.
+  static void FlushAsyncMessages();
+
   /// Returns the list of log channels.
   static std::vector<llvm::StringRef> ListChannels();
   /// Calls the given lambda for every category in the given channel.
@@ -167,6 +183,10 @@ public:
   bool GetVerbose() const;
 
 private:
+  struct Record;
+  class AsyncWriter;
+  class RingBuffer;
+
   void VAPrintf(const char *format, va_list args);
   void VAError(const char *format, va_list args);
 
@@ -179,12 +199,20 @@ private:
   llvm::sys::RWMutex m_mutex;
 
   std::shared_ptr<llvm::raw_ostream> m_stream_sp;
+  std::shared_ptr<RingBuffer> m_ring_buffer_sp;
+  // The buffers this channel stopped using while a crash dump was reading
+  // them, kept alive for the crash handler.
+  std::vector<std::shared_ptr<RingBuffer>> m_crash_retired_ring_buffers;
+  // The current buffer, read by the crash handler without taking m_mutex.
+  std::atomic<RingBuffer *> m_crash_ring_buffer{nullptr};
   std::atomic<uint32_t> m_options{0};
   std::atomic<uint32_t> m_mask{0};
 
-  void WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
-                   llvm::StringRef function);
-  void WriteMessage(const std::string &message);
+  static void WriteHeader(llvm::raw_ostream &OS, const Record &record,
+                          llvm::StringRef thread_name);
+  void WriteLocation(llvm::raw_ostream &OS, llvm::StringRef file,
+                     llvm::StringRef function);
+  void WriteMessage(std::string message);
 
   void Format(llvm::StringRef file, llvm::StringRef function,
               const llvm::formatv_object_base &payload);
@@ -195,10 +223,12 @@ private:
   }
 
   void Enable(const std::shared_ptr<llvm::raw_ostream> &stream_sp,
-              uint32_t options, uint32_t flags);
+              uint32_t options, uint32_t flags, size_t buffer_size);
 
   void Disable(uint32_t flags);
 
+  void SetRingBuffer(std::shared_ptr<RingBuffer> ring_buffer_sp);
+
   typedef llvm::StringMap<Log> ChannelMap;
   static llvm::ManagedStatic<ChannelMap> g_channel_map;
 
@@ -213,6 +243,8 @@ private:
 
   static void DisableLoggingChild();
 
+  static void DumpRingBuffersOnCrash(void *);
+
   Log(const Log &) = delete;
   void operator=(const Log &) = delete;
 };
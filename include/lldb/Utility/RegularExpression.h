@@ -78,15 +78,45 @@ public:
   ///     otherwise.
   llvm::Error GetError() const;
 
+  /// Get a substring that every string this regular expression matches
+  /// contains.
+  ///
+  /// Callers testing many strings can search for this substring first and
+  /// only execute the regular expression on the strings that contain it.
+  ///
+  /// \return
+  ///     The substring, or an empty string if there is no such substring or
+  ///     it couldn't be determined.
+  llvm::StringRef GetRequiredSubstring() const { return m_required_substring; }
+
+  /// Test if this regular expression matches exactly the strings that
+  /// contain the string returned by GetRequiredSubstring() and that is not
+  /// anchored.
+  bool IsSubstringMatch() const {
+    return m_literal_match == LiteralMatch::Substring;
+  }
+
   bool operator==(const RegularExpression &rhs) const {
     return GetText() == rhs.GetText();
   }
 
 private:
+  /// How a regular expression without any special characters other than
+  /// anchors can be matched without executing it.
+  enum class LiteralMatch { None, Substring, Prefix, Suffix, Exact };
+
+  /// Compute m_required_substring and m_literal_match from the regular
+  /// expression text.
+  void AnalyzeLiterals();
+
   /// A copy of the original regular expression text.
   std::string m_regex_text;
   /// The compiled regular expression.
   mutable llvm::Regex m_regex;
+  /// A string every match contains, see GetRequiredSubstring().
+  std::string m_required_substring;
+  /// Whether matching only needs comparing with m_required_substring.
+  LiteralMatch m_literal_match = LiteralMatch::None;
 };
 
 } // namespace lldb_private
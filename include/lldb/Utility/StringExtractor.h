@@ -25,8 +25,9 @@ public:
   StringExtractor(const char *packet_cstr);
   virtual ~StringExtractor();
 
+  // Reuses the storage of the previous packet where possible.
   void Reset(llvm::StringRef str) {
-    m_packet = str;
+    m_packet.assign(str.data(), str.size());
     m_index = 0;
   }
 
@@ -225,7 +225,12 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  ExpressionDeclImports = 4,
+  ExpressionDeclCompletions = 5,
+  SectionDecompressionTime = 6,
+  ModulesNotFullyParsed = 7,
+  BreakpointResolutionTime = 8,
+  StatisticMax = 9
 };
 
 
@@ -239,6 +244,16 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::ExpressionDeclImports:
+     return "Number of decls imported into expressions";
+   case StatisticKind::ExpressionDeclCompletions:
+     return "Number of decls completed for expressions";
+   case StatisticKind::SectionDecompressionTime:
+     return "Time spent decompressing sections (ms)";
+   case StatisticKind::ModulesNotFullyParsed:
+     return "Number of modules whose sections were never parsed";
+   case StatisticKind::BreakpointResolutionTime:
+     return "Time spent resolving breakpoints in loaded modules (ms)";
    case StatisticKind::StatisticMax:
      return "";
    }
@@ -0,0 +1,45 @@
+"""
+Test that expressions don't complete the types they refer to by name in the
+debug info until they need the definition when target.lazy-type-import is
+set.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestLazyTypeImport(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def outer_is_complete(self, target):
+        outer = target.FindFirstType("Outer")
+        self.assertTrue(outer.IsValid())
+        return outer.IsTypeComplete()
+
+    def run_expressions(self, lazy):
+        self.build()
+        self.runCmd("settings set target.lazy-type-import " +
+                    ("true" if lazy else "false"))
+        self.addTearDownHook(
+            lambda: self.runCmd("settings clear target.lazy-type-import"))
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "// Break here", lldb.SBFileSpec("main.cpp"))
+        self.assertFalse(self.outer_is_complete(target))
+
+        # Naming the type without needing its definition.
+        self.expect("expr (Outer *)g_outer", substrs=["(Outer *) $"])
+        self.assertEqual(self.outer_is_complete(target), not lazy)
+
+        # Needing the definition completes the type in either mode.
+        self.expect("expr sizeof(Outer)", substrs=["= 12"])
+        self.assertTrue(self.outer_is_complete(target))
+        self.expect("expr Outer().m2.x", substrs=["= 0"])
+
+    def test_lazy(self):
+        self.run_expressions(lazy=True)
+
+    def test_eager(self):
+        self.run_expressions(lazy=False)
@@ -0,0 +1,15 @@
+struct Member {
+  int x;
+};
+
+struct Outer {
+  Member m1;
+  Member m2;
+  int y;
+};
+
+Outer *g_outer = nullptr;
+
+int main() {
+  return 0; // Break here
+}
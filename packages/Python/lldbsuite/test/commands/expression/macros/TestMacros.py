@@ -129,3 +129,42 @@ class TestMacros(TestBase):
         result = frame.EvaluateExpression("MACRO_2")
         self.assertTrue(result.GetError().Fail(),
                         "Printing MACRO_2 fails in the header file")
+
+    @expectedFailureAll(
+        compiler="clang",
+        bugnumber="clang does not emit .debug_macro[.dwo] sections.")
+    @expectedFailureAll(
+        debug_info="dwo",
+        bugnumber="GCC produces multiple .debug_macro.dwo sections and the spec is unclear as to what it means")
+    @expectedFailureAll(
+        hostoslist=["windows"],
+        compiler="gcc",
+        triple='.*-android')
+    def test_expr_reuses_macro_preamble(self):
+        """Test that expressions at the same location share the precompiled
+        macro prologue."""
+        self.build()
+
+        log_file = self.getBuildArtifact("expr.log")
+        self.runCmd("log enable -f '%s' lldb expr" % log_file)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+
+        (target, process, thread, bp1) = lldbutil.run_to_source_breakpoint(
+            self, "Break here", lldb.SBFileSpec("main.cpp"))
+        frame = thread.GetSelectedFrame()
+
+        result = frame.EvaluateExpression("MACRO_1")
+        self.assertTrue(
+            result.IsValid() and result.GetValue() == "100",
+            "MACRO_1 = 100")
+
+        result = frame.EvaluateExpression("MAX(ONE, TWO)")
+        self.assertTrue(
+            result.IsValid() and result.GetValue() == "2",
+            "MAX(ONE, TWO) = 2")
+
+        self.runCmd("log disable lldb expr")
+        with open(log_file) as f:
+            log = f.read()
+        self.assertEqual(log.count("Precompiled the"), 1, log)
+        self.assertIn("Reusing the precompiled", log)
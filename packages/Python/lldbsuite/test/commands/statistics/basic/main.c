@@ -7,7 +7,7 @@ int main(void) {
   //%self.expect("statistics enable", substrs=['already enabled'], error=True)
   //%self.expect("expr patatino", substrs=['27'])
   //%self.expect("statistics disable")
-  //%self.expect("statistics dump", substrs=['expr evaluation successes : 1', 'expr evaluation failures : 0'])
+  //%self.expect("statistics dump", substrs=['expr evaluation successes : 1', 'expr evaluation failures : 0', 'decls imported into expressions : '])
   //%self.expect("frame var", substrs=['27'])
   //%self.expect("statistics enable")
   //%self.expect("frame var", substrs=['27'])
@@ -0,0 +1,65 @@
+"""
+Test that file and line, name and regex breakpoints that are set before a
+module is loaded resolve in it when the process loads it.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class BreakpointInLoadedModuleTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @skipIfWindows  # Windows doesn't have dlopen and friends.
+    @skipIfRemote
+    def test(self):
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        line = line_number("plugin.cpp", "// Break in plugin")
+        file_line_bp = target.BreakpointCreateByLocation("plugin.cpp", line)
+        name_bp = target.BreakpointCreateByName("plugin_entry")
+        regex_bp = target.BreakpointCreateByRegex("plugin_helper_")
+        for bp in [file_line_bp, name_bp, regex_bp]:
+            self.assertTrue(bp, VALID_BREAKPOINT)
+            self.assertEqual(bp.GetNumLocations(), 0)
+
+        ext = "dylib" if self.platformIsDarwin() else "so"
+        lib = self.getBuildArtifact("libplugin." + ext)
+        process = target.LaunchSimple([lib], None,
+                                      self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        self.assertEqual(file_line_bp.GetNumLocations(), 1)
+        self.assertEqual(name_bp.GetNumLocations(), 1)
+        self.assertEqual(regex_bp.GetNumLocations(), 2)
+
+        # The breakpoints are hit in the order the plugin runs the code.
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, name_bp)
+        self.assertEqual(len(threads), 1)
+        self.assertEqual(threads[0].GetFrameAtIndex(0).GetFunctionName(),
+                         "plugin_entry")
+
+        process.Continue()
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process,
+                                                             file_line_bp)
+        self.assertEqual(len(threads), 1)
+        self.assertEqual(
+            threads[0].GetFrameAtIndex(0).GetLineEntry().GetLine(), line)
+
+        for helper in ["plugin_helper_one", "plugin_helper_two"]:
+            process.Continue()
+            threads = lldbutil.get_threads_stopped_at_breakpoint(process,
+                                                                 regex_bp)
+            self.assertEqual(len(threads), 1)
+            self.assertIn(helper,
+                          threads[0].GetFrameAtIndex(0).GetFunctionName())
+
+        process.Continue()
+        self.assertEqual(process.GetState(), lldb.eStateExited)
+        self.assertEqual(process.GetExitStatus(), 0)
@@ -0,0 +1,13 @@
+#include <dlfcn.h>
+
+int main(int argc, char const *argv[]) {
+  if (argc < 2)
+    return 1;
+  void *handle = dlopen(argv[1], RTLD_NOW);
+  if (!handle)
+    return 1;
+  int (*entry)() = (int (*)())dlsym(handle, "plugin_entry");
+  if (!entry)
+    return 1;
+  return entry();
+}
@@ -0,0 +1,10 @@
+int plugin_helper_one() { return 1; }
+
+int plugin_helper_two() { return 2; }
+
+extern "C" int plugin_entry() {
+  int sum = 0;
+  sum += plugin_helper_one(); // Break in plugin
+  sum += plugin_helper_two();
+  return sum - 3;
+}
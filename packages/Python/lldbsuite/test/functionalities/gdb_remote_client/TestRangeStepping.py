@@ -0,0 +1,91 @@
+from __future__ import print_function
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+from gdbclientutils import *
+
+
+class TestRangeStepping(GDBRemoteTestBase):
+    """Test that stepping through a range is left to a stub that supports
+    the vCont;r action, with a single packet for the whole range."""
+
+    class MyResponder(MockGDBServerResponder):
+        def __init__(self):
+            MockGDBServerResponder.__init__(self)
+            self.pc = 0x1000
+
+        def qXferRead(self, obj, annex, offset, length):
+            if annex == "target.xml":
+                return """<?xml version="1.0"?>
+                    <target version="1.0">
+                      <architecture>i386:x86-64</architecture>
+                      <feature name="org.gnu.gdb.i386.core">
+                        <reg name="rip" bitsize="64" regnum="0" type="code_ptr" group="general"/>
+                        <reg name="rsp" bitsize="64" regnum="1" type="data_ptr" group="general"/>
+                        <reg name="rbp" bitsize="64" regnum="2" type="data_ptr" group="general"/>
+                      </feature>
+                    </target>""", False
+            else:
+                return None, False
+
+        def encodedPC(self):
+            return "".join("%02x" % ((self.pc >> (8 * i)) & 0xff)
+                           for i in range(8))
+
+        def readRegisters(self):
+            return self.encodedPC() + "00" * 16
+
+        def readRegister(self, register):
+            if register == 0:
+                return self.encodedPC()
+            return "00" * 8
+
+        def haltReason(self):
+            return "T05thread:1;"
+
+        def qfThreadInfo(self):
+            return "m1"
+
+        def qC(self):
+            return "QC1"
+
+        def other(self, packet):
+            if packet == "vCont?":
+                return "vCont;c;C;s;S;r"
+            if packet.startswith("vCont;r"):
+                # Run to the end of the range, as a stub would when nothing
+                # else stops the thread there.
+                start, end = packet[len("vCont;r"):].split(":")[0].split(",")
+                self.pc = int(end, 16)
+                return "T05thread:1;reason:trace;"
+            return ""
+
+    def step(self, plan):
+        self.server.responder = self.MyResponder()
+        target = self.dbg.CreateTarget("")
+        if self.TraceOn():
+            self.runCmd("log enable gdb-remote packets")
+            self.addTearDownHook(
+                lambda: self.runCmd("log disable gdb-remote packets"))
+        process = self.connect(target)
+        thread = process.GetThreadAtIndex(0)
+        self.assertEqual(thread.GetFrameAtIndex(0).GetPC(), 0x1000)
+
+        self.runCmd("command script import '%s'" %
+                    os.path.join(self.getSourceDir(), "range_steps.py"))
+        error = thread.StepUsingScriptedThreadPlan("range_steps." + plan)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertEqual(thread.GetFrameAtIndex(0).GetPC(), 0x1010)
+
+        return [packet for packet in self.server.responder.packetLog
+                if packet.startswith("vCont;")]
+
+    @skipIfXmlSupportMissing
+    def test_step_over(self):
+        self.assertEqual(self.step("StepOver"),
+                         ["vCont;r1000,1010:0001"])
+
+    @skipIfXmlSupportMissing
+    def test_step_in(self):
+        self.assertEqual(self.step("StepIn"),
+                         ["vCont;r1000,1010:0001"])
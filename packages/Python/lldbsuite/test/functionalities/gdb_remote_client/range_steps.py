@@ -0,0 +1,31 @@
+import lldb
+
+# Plans that step through the 0x10 bytes starting at the pc, like "next"
+# and "step" do for the range of a line.
+class StepRange:
+    def __init__(self, thread_plan, dict):
+        self.thread_plan = thread_plan
+        start = thread_plan.GetThread().GetFrameAtIndex(0).GetPCAddress()
+        self.child_thread_plan = self.queue_child_thread_plan(start, 0x10)
+
+    def explains_stop(self, event):
+        return False
+
+    def should_stop(self, event):
+        if not self.child_thread_plan.IsPlanComplete():
+            return False
+
+        self.thread_plan.SetPlanComplete(True)
+
+        return True
+
+    def should_step(self):
+        return False
+
+class StepOver(StepRange):
+    def queue_child_thread_plan(self, start, size):
+        return self.thread_plan.QueueThreadPlanForStepOverRange(start, size)
+
+class StepIn(StepRange):
+    def queue_child_thread_plan(self, start, size):
+        return self.thread_plan.QueueThreadPlanForStepInRange(start, size)
@@ -30,8 +30,13 @@ class TestStatsAPI(TestBase):
         stream = lldb.SBStream()
         res = stats.GetAsJSON(stream)
         stats_json = sorted(json.loads(stream.GetData()))
-        self.assertEqual(len(stats_json), 4)
+        self.assertEqual(len(stats_json), 9)
         self.assertTrue("Number of expr evaluation failures" in stats_json)
         self.assertTrue("Number of expr evaluation successes" in stats_json)
         self.assertTrue("Number of frame var failures" in stats_json)
         self.assertTrue("Number of frame var successes" in stats_json)
+        self.assertTrue("Number of decls imported into expressions" in stats_json)
+        self.assertTrue("Number of decls completed for expressions" in stats_json)
+        self.assertTrue("Time spent decompressing sections (ms)" in stats_json)
+        self.assertTrue("Number of modules whose sections were never parsed" in stats_json)
+        self.assertTrue("Time spent resolving breakpoints in loaded modules (ms)" in stats_json)
@@ -0,0 +1,40 @@
+"""
+Test that SBValue.GetDescription stops printing once its budget is exhausted.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ValueDescriptionBudgetTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @add_test_categories(['pyapi'])
+    def test(self):
+        self.build()
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "// Break at this line", lldb.SBFileSpec("main.c"))
+
+        polygon = thread.GetFrameAtIndex(0).FindVariable("polygon")
+        self.assertTrue(polygon.IsValid(), VALID_VARIABLE)
+
+        marker = "<output truncated: printing budget exhausted>"
+
+        # Without a budget the whole value is printed.
+        stream = lldb.SBStream()
+        self.assertTrue(polygon.GetDescription(stream, 0, 0))
+        self.assertFalse(marker in stream.GetData())
+        self.assertTrue("[15] = (x = 15, y = -15)" in stream.GetData())
+
+        # With a budget of a few children, printing stops early. The members
+        # of the points count as children too, so the budget runs out in the
+        # middle of the fourth point.
+        stream = lldb.SBStream()
+        self.assertTrue(polygon.GetDescription(stream, 10, 0))
+        self.assertTrue(marker in stream.GetData())
+        self.assertTrue("[2] = (x = 2, y = -2)" in stream.GetData())
+        self.assertTrue("[3] = (x = 3, ...)" in stream.GetData())
+        self.assertFalse("[4] = " in stream.GetData())
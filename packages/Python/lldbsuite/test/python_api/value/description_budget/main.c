@@ -0,0 +1,17 @@
+struct Point {
+  int x;
+  int y;
+};
+
+struct Polygon {
+  struct Point points[16];
+};
+
+int main(int argc, char const *argv[]) {
+  struct Polygon polygon;
+  for (int i = 0; i < 16; ++i) {
+    polygon.points[i].x = i;
+    polygon.points[i].y = -i;
+  }
+  return 0; // Break at this line
+}
@@ -39,6 +39,9 @@ class TestGdbRemote_vCont(gdbremote_testcase.GdbRemoteTestCaseBase):
     def vCont_supports_S(self):
         self.vCont_supports_mode("S")
 
+    def vCont_supports_r(self):
+        self.vCont_supports_mode("r")
+
     @expectedFailureAll(oslist=["ios", "tvos", "watchos", "bridgeos"], bugnumber="rdar://27005337")
     @debugserver_test
     def test_vCont_supports_c_debugserver(self):
@@ -95,6 +98,13 @@ class TestGdbRemote_vCont(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.build()
         self.vCont_supports_S()
 
+    @expectedFailureAll(oslist=["ios", "tvos", "watchos", "bridgeos"], bugnumber="rdar://27005337")
+    @llgs_test
+    def test_vCont_supports_r_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.vCont_supports_r()
+
     @expectedFailureAll(oslist=["ios", "tvos", "watchos", "bridgeos"], bugnumber="rdar://27005337")
     @debugserver_test
     def test_single_step_only_steps_one_instruction_with_Hc_vCont_s_debugserver(
@@ -0,0 +1,68 @@
+from __future__ import print_function
+
+
+import gdbremote_testcase
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestGdbRemoteRangeStep(gdbremote_testcase.GdbRemoteTestCaseBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def range_step_leaves_loop(self):
+        procs = self.prep_debug_monitor_and_inferior()
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"type": "output_match",
+              "regex": r"^range: 0x([0-9a-fA-F]+) 0x([0-9a-fA-F]+)\r\n$",
+              "capture": {1: "range_start", 2: "range_end"}},
+             {"direction": "send",
+              "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(int(context.get("stop_signo"), 16),
+                         lldbutil.get_signal_number('SIGTRAP'))
+        thread_id = int(context.get("stop_thread_id"), 16)
+        range_start = int(context.get("range_start"), 16)
+        range_end = int(context.get("range_end"), 16)
+
+        reg_infos = self.gather_register_infos()
+        (pc_lldb_reg_index, pc_reg_info) = self.find_pc_reg_info(reg_infos)
+        self.assertIsNotNone(pc_lldb_reg_index)
+        endian = self.get_target_byte_order()
+
+        # The int3 leaves the pc at the start of the range.
+        values = self.read_register_values([pc_reg_info], endian)
+        self.assertEqual(values[pc_lldb_reg_index], range_start)
+
+        # Range step over the whole loop. Every iteration branches back into
+        # the range, so the only stop reported is the one after the loop.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $vCont;r{:x},{:x}:{:x}#00".format(
+                range_start, range_end, thread_id),
+             {"direction": "send",
+              "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(int(context.get("stop_signo"), 16),
+                         lldbutil.get_signal_number('SIGTRAP'))
+        self.assertEqual(int(context.get("stop_thread_id"), 16), thread_id)
+
+        values = self.read_register_values([pc_reg_info], endian)
+        self.assertEqual(values[pc_lldb_reg_index], range_end)
+
+    @skipIf(archs=no_match(["x86_64"]))
+    @skipUnlessPlatform(["linux"])
+    @llgs_test
+    def test_range_step_leaves_loop_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.range_step_leaves_loop()
@@ -0,0 +1,29 @@
+#include <cstdio>
+
+#if defined(__x86_64__)
+extern "C" char range_start[], range_end[];
+#endif
+
+int main() {
+#if defined(__x86_64__)
+  std::printf("range: %p %p\n", static_cast<void *>(range_start),
+              static_cast<void *>(range_end));
+  std::fflush(stdout);
+
+  // Stop right before a loop that takes a thousand iterations to leave.
+  asm volatile("int3\n\t"
+               ".globl  range_start\n"
+               "range_start:\n\t"
+               "movl    $1000, %%ecx\n"
+               "1:\n\t"
+               "decl    %%ecx\n\t"
+               "jnz     1b\n\t"
+               ".globl  range_end\n"
+               "range_end:\n\t"
+               "nop"
+               :
+               :
+               : "%ecx");
+#endif
+  return 0;
+}
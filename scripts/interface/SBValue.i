@@ -375,6 +375,15 @@ public:
     bool
     GetDescription (lldb::SBStream &description);
 
+    %feature("docstring", "
+    Print a description of this value, stopping once max_children children
+    have been printed or timeout_ms milliseconds have elapsed. A value of zero
+    disables the respective limit. If the output is truncated, a marker is
+    printed in place of the remaining children.") GetDescription;
+    bool
+    GetDescription (lldb::SBStream &description, uint32_t max_children,
+                    uint32_t timeout_ms);
+
     bool
     GetExpressionPath (lldb::SBStream &description);
 
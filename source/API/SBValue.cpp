@@ -24,6 +24,7 @@
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/DataFormatters/DataVisualization.h"
+#include "lldb/DataFormatters/DumpValueObjectOptions.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Declaration.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -1285,6 +1286,27 @@ bool SBValue::GetDescription(SBStream &description) {
   return true;
 }
 
+bool SBValue::GetDescription(SBStream &description, uint32_t max_children,
+                             uint32_t timeout_ms) {
+  LLDB_RECORD_METHOD(bool, SBValue, GetDescription,
+                     (lldb::SBStream &, uint32_t, uint32_t), description,
+                     max_children, timeout_ms);
+
+  Stream &strm = description.ref();
+
+  ValueLocker locker;
+  lldb::ValueObjectSP value_sp(GetSP(locker));
+  if (value_sp) {
+    DumpValueObjectOptions options(*value_sp);
+    options.SetChildrenBudget(max_children)
+        .SetTimeBudget(std::chrono::milliseconds(timeout_ms));
+    value_sp->Dump(strm, options);
+  } else
+    strm.PutCString("No value");
+
+  return true;
+}
+
 lldb::Format SBValue::GetFormat() {
   LLDB_RECORD_METHOD_NO_ARGS(lldb::Format, SBValue, GetFormat);
 
@@ -1666,6 +1688,8 @@ void RegisterMethods<SBValue>(Registry &R) {
       lldb::SBValue, SBValue, EvaluateExpression,
       (const char *, const lldb::SBExpressionOptions &, const char *));
   LLDB_REGISTER_METHOD(bool, SBValue, GetDescription, (lldb::SBStream &));
+  LLDB_REGISTER_METHOD(bool, SBValue, GetDescription,
+                       (lldb::SBStream &, uint32_t, uint32_t));
   LLDB_REGISTER_METHOD(lldb::Format, SBValue, GetFormat, ());
   LLDB_REGISTER_METHOD(void, SBValue, SetFormat, (lldb::Format));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBValue, AddressOf, ());
@@ -8,7 +8,13 @@
 
 #include "lldb/Breakpoint/BreakpointList.h"
 
+#include "lldb/Breakpoint/BreakpointResolver.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/Timer.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -168,10 +174,84 @@ BreakpointSP BreakpointList::GetBreakpointAtIndex(size_t i) const {
 void BreakpointList::UpdateBreakpoints(ModuleList &module_list, bool added,
                                        bool delete_locations) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (added)
+    PreloadBreakpointLookups(module_list);
   for (const auto &bp_sp : m_breakpoints)
     bp_sp->ModulesChanged(module_list, added, delete_locations);
 }
 
+void BreakpointList::PreloadBreakpointLookups(ModuleList &module_list) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (m_breakpoints.empty())
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat,
+                     "BreakpointList::PreloadBreakpointLookups (%zu modules)",
+                     module_list.GetSize());
+
+  std::vector<ModuleSP> modules;
+  for (ModuleSP module_sp : module_list.Modules())
+    modules.push_back(module_sp);
+
+  // Gather the names and files each module will be searched for. Breakpoints
+  // whose filter rejects a module won't look anything up in it.
+  std::vector<std::vector<ConstString>> module_names(modules.size());
+  std::vector<std::vector<ConstString>> module_files(modules.size());
+  for (const auto &bp_sp : m_breakpoints) {
+    BreakpointResolverSP resolver_sp = bp_sp->GetResolver();
+    SearchFilterSP filter_sp = bp_sp->GetSearchFilter();
+    if (!resolver_sp || !filter_sp)
+      continue;
+    std::vector<ConstString> names;
+    std::vector<ConstString> files;
+    resolver_sp->GetLookupNames(names, files);
+    if (names.empty() && files.empty())
+      continue;
+    for (size_t i = 0; i < modules.size(); ++i) {
+      if (!filter_sp->ModulePasses(modules[i]))
+        continue;
+      module_names[i].insert(module_names[i].end(), names.begin(),
+                             names.end());
+      module_files[i].insert(module_files[i].end(), files.begin(),
+                             files.end());
+    }
+  }
+
+  // Each module is only touched by one task, so the modules can be searched
+  // in parallel. The breakpoints are still resolved on this thread
+  // afterwards, as adding their locations isn't thread safe.
+  TaskMapOverInt(0, modules.size(), [&](size_t i) {
+    SymbolFile *symfile = modules[i]->GetSymbolFile();
+    if (!symfile)
+      return;
+
+    if (!module_names[i].empty())
+      symfile->PreloadNames(module_names[i]);
+
+    std::vector<ConstString> &files = module_files[i];
+    llvm::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    std::vector<uint32_t> cu_indexes;
+    for (ConstString file : files) {
+      std::vector<uint32_t> file_cu_indexes;
+      if (!symfile->FindCompileUnitsForFile(file, file_cu_indexes))
+        return;
+      cu_indexes.insert(cu_indexes.end(), file_cu_indexes.begin(),
+                        file_cu_indexes.end());
+    }
+
+    // Parse the line tables of the compile units that refer to any of the
+    // files, once each.
+    llvm::sort(cu_indexes.begin(), cu_indexes.end());
+    cu_indexes.erase(std::unique(cu_indexes.begin(), cu_indexes.end()),
+                     cu_indexes.end());
+    for (uint32_t cu_idx : cu_indexes)
+      if (CompUnitSP cu_sp = symfile->GetCompileUnitAtIndex(cu_idx))
+        cu_sp->GetLineTable();
+  });
+}
+
 void BreakpointList::UpdateBreakpointsWhenModuleIsReplaced(
     ModuleSP old_module_sp, ModuleSP new_module_sp) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
@@ -12,9 +12,12 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
 
+#include <numeric>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -225,8 +228,16 @@ Searcher::CallbackReturn BreakpointResolverFileLine::SearchCallback(
   if (is_relative)
     search_file_spec.GetDirectory().Clear();
 
-  const size_t num_comp_units = context.module_sp->GetNumCompileUnits();
-  for (size_t i = 0; i < num_comp_units; i++) {
+  // Only search the compile units that refer to the file, if the symbol file
+  // can tell which ones those are without parsing all their line tables.
+  std::vector<uint32_t> cu_indexes;
+  SymbolFile *symbol_file = context.module_sp->GetSymbolFile();
+  if (!symbol_file || !symbol_file->FindCompileUnitsForFile(
+                          search_file_spec.GetFilename(), cu_indexes)) {
+    cu_indexes.resize(context.module_sp->GetNumCompileUnits());
+    std::iota(cu_indexes.begin(), cu_indexes.end(), 0);
+  }
+  for (uint32_t i : cu_indexes) {
     CompUnitSP cu_sp(context.module_sp->GetCompileUnitAtIndex(i));
     if (cu_sp) {
       if (filter.CompUnitPasses(*cu_sp))
@@ -262,6 +273,11 @@ void BreakpointResolverFileLine::GetDescription(Stream *s) {
 
 void BreakpointResolverFileLine::Dump(Stream *s) const {}
 
+void BreakpointResolverFileLine::GetLookupNames(
+    std::vector<ConstString> &names, std::vector<ConstString> &files) {
+  files.push_back(m_file_spec.GetFilename());
+}
+
 lldb::BreakpointResolverSP
 BreakpointResolverFileLine::CopyForBreakpoint(Breakpoint &breakpoint) {
   lldb::BreakpointResolverSP ret_sp(new BreakpointResolverFileLine(
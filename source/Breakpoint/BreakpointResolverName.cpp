@@ -426,6 +426,12 @@ void BreakpointResolverName::GetDescription(Stream *s) {
 
 void BreakpointResolverName::Dump(Stream *s) const {}
 
+void BreakpointResolverName::GetLookupNames(std::vector<ConstString> &names,
+                                            std::vector<ConstString> &files) {
+  for (const Module::LookupInfo &lookup : m_lookups)
+    names.push_back(lookup.GetLookupName());
+}
+
 lldb::BreakpointResolverSP
 BreakpointResolverName::CopyForBreakpoint(Breakpoint &breakpoint) {
   lldb::BreakpointResolverSP ret_sp(new BreakpointResolverName(*this));
@@ -86,7 +86,8 @@ public:
 
   class CommandOptions : public Options {
   public:
-    CommandOptions() : Options(), log_file(), log_options(0) {}
+    CommandOptions()
+        : Options(), log_file(), log_options(0), buffer_size(0) {}
 
     ~CommandOptions() override = default;
 
@@ -127,6 +128,14 @@ public:
       case 'F':
         log_options |= LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION;
         break;
+      case 'A':
+        log_options |= LLDB_LOG_OPTION_ASYNC;
+        break;
+      case 'b':
+        if (option_arg.getAsInteger(0, buffer_size) || buffer_size == 0)
+          error.SetErrorStringWithFormat("invalid buffer size '%s'",
+                                         option_arg.str().c_str());
+        break;
       default:
         llvm_unreachable("Unimplemented option");
       }
@@ -137,6 +146,7 @@ public:
     void OptionParsingStarting(ExecutionContext *execution_context) override {
       log_file.Clear();
       log_options = 0;
+      buffer_size = 0;
     }
 
     llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
@@ -147,6 +157,7 @@ public:
 
     FileSpec log_file;
     uint32_t log_options;
+    size_t buffer_size;
   };
 
   void
@@ -178,7 +189,8 @@ protected:
     llvm::raw_string_ostream error_stream(error);
     bool success =
         GetDebugger().EnableLog(channel, args.GetArgumentArrayRef(), log_file,
-                                m_options.log_options, error_stream);
+                                m_options.log_options, error_stream,
+                                m_options.buffer_size);
     result.GetErrorStream() << error_stream.str();
 
     if (success)
@@ -256,6 +268,60 @@ protected:
   }
 };
 
+class CommandObjectLogDump : public CommandObjectParsed {
+public:
+  // Constructors and Destructors
+  CommandObjectLogDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "log dump",
+                            "Write out the log lines buffered by a log "
+                            "channel that was enabled with --buffer.",
+                            nullptr) {
+    CommandArgumentEntry arg;
+    CommandArgumentData channel_arg;
+
+    // Define the first (and only) variant of this arg.
+    channel_arg.arg_type = eArgTypeLogChannel;
+    channel_arg.arg_repetition = eArgRepeatPlain;
+
+    // There is only one variant this argument could be; put it into the
+    // argument entry.
+    arg.push_back(channel_arg);
+
+    // Push the data for the first argument into the m_arguments vector.
+    m_arguments.push_back(arg);
+  }
+
+  ~CommandObjectLogDump() override = default;
+
+  void
+  HandleArgumentCompletion(CompletionRequest &request,
+                           OptionElementVector &opt_element_vector) override {
+    if (request.GetCursorIndex() == 0)
+      for (llvm::StringRef channel : Log::ListChannels())
+        request.TryCompleteCurrentArg(channel);
+  }
+
+protected:
+  bool DoExecute(Args &args, CommandReturnObject &result) override {
+    if (args.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("%s takes a log channel.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    std::string output;
+    llvm::raw_string_ostream output_stream(output);
+    std::string error;
+    llvm::raw_string_ostream error_stream(error);
+    if (Log::DumpLogChannel(args[0].ref(), output_stream, error_stream))
+      result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    result.GetOutputStream() << output_stream.str();
+    result.GetErrorStream() << error_stream.str();
+    return result.Succeeded();
+  }
+};
+
 class CommandObjectLogList : public CommandObjectParsed {
 public:
   // Constructors and Destructors
@@ -381,6 +447,8 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter)
                  CommandObjectSP(new CommandObjectLogEnable(interpreter)));
   LoadSubCommand("disable",
                  CommandObjectSP(new CommandObjectLogDisable(interpreter)));
+  LoadSubCommand("dump",
+                 CommandObjectSP(new CommandObjectLogDump(interpreter)));
   LoadSubCommand("list",
                  CommandObjectSP(new CommandObjectLogList(interpreter)));
   LoadSubCommand("timers",
@@ -80,7 +80,7 @@ protected:
     uint32_t i = 0;
     for (auto &stat : target.GetStatistics()) {
       result.AppendMessageWithFormat(
-          "%s : %u\n",
+          "%s : %" PRIu64 "\n",
           lldb_private::GetStatDescription(static_cast<lldb_private::StatisticKind>(i))
               .c_str(),
           stat);
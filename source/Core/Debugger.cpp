@@ -529,6 +529,9 @@ void Debugger::Terminate() {
       g_debugger_list_ptr->clear();
     }
   }
+
+  // Write out the messages still queued for asynchronous logs.
+  Log::FlushAsyncMessages();
 }
 
 void Debugger::SettingsInitialize() { Target::SettingsInitialize(); }
@@ -1159,7 +1162,7 @@ void Debugger::SetLoggingCallback(lldb::LogOutputCallback log_callback,
 bool Debugger::EnableLog(llvm::StringRef channel,
                          llvm::ArrayRef<const char *> categories,
                          llvm::StringRef log_file, uint32_t log_options,
-                         llvm::raw_ostream &error_stream) {
+                         llvm::raw_ostream &error_stream, size_t buffer_size) {
   const bool should_close = true;
   const bool unbuffered = true;
 
@@ -1198,7 +1201,7 @@ bool Debugger::EnableLog(llvm::StringRef channel,
         LLDB_LOG_OPTION_PREPEND_THREAD_NAME | LLDB_LOG_OPTION_THREADSAFE;
 
   return Log::EnableLogChannel(log_stream_sp, log_options, channel, categories,
-                               error_stream);
+                               error_stream, buffer_size);
 }
 
 ScriptInterpreter *Debugger::GetScriptInterpreter(bool can_create) {
@@ -200,8 +200,27 @@ lldb::DisassemblerSP Disassembler::DisassembleRange(
   if (!range.GetBaseAddress().IsValid())
     return {};
 
-  lldb::DisassemblerSP disasm_sp = Disassembler::FindPluginForTarget(
-      exe_ctx.GetTargetSP(), arch, flavor, plugin_name);
+  // When the bytes can come from the module's file, the decoded range can be
+  // shared by everyone who disassembles it.
+  lldb::TargetSP target_sp = exe_ctx.GetTargetSP();
+  lldb::ModuleSP module_sp;
+  if (prefer_file_cache)
+    module_sp = range.GetBaseAddress().GetModule();
+  std::string cache_flavor;
+  if (flavor)
+    cache_flavor = flavor;
+  else if (target_sp && target_sp->GetDisassemblyFlavor())
+    cache_flavor = target_sp->GetDisassemblyFlavor();
+  const llvm::StringRef cache_plugin_name(plugin_name ? plugin_name : "");
+  if (module_sp) {
+    if (lldb::DisassemblerSP disasm_sp =
+            module_sp->GetDisassemblerCache().Find(range, arch, cache_flavor,
+                                                   cache_plugin_name))
+      return disasm_sp;
+  }
+
+  lldb::DisassemblerSP disasm_sp =
+      Disassembler::FindPluginForTarget(target_sp, arch, flavor, plugin_name);
 
   if (!disasm_sp)
     return {};
@@ -211,6 +230,9 @@ lldb::DisassemblerSP Disassembler::DisassembleRange(
   if (bytes_disassembled == 0)
     return {};
 
+  if (module_sp)
+    module_sp->GetDisassemblerCache().Insert(range, arch, cache_flavor,
+                                             cache_plugin_name, disasm_sp);
   return disasm_sp;
 }
 
@@ -1278,6 +1300,67 @@ Disassembler::Disassembler(const ArchSpec &arch, const char *flavor)
 
 Disassembler::~Disassembler() = default;
 
+lldb::DisassemblerSP
+DisassemblerCache::Find(const AddressRange &range, const ArchSpec &arch,
+                        llvm::StringRef flavor,
+                        llvm::StringRef plugin_name) const {
+  const lldb::addr_t file_addr = range.GetBaseAddress().GetFileAddress();
+  const lldb::addr_t end = file_addr + range.GetByteSize();
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto matches = m_entries.equal_range(file_addr);
+  for (auto pos = matches.first; pos != matches.second; ++pos) {
+    const Entry &entry = pos->second;
+    if (entry.end == end && entry.arch.IsExactMatch(arch) &&
+        entry.flavor == flavor && entry.plugin_name == plugin_name)
+      return entry.disasm_sp;
+  }
+  return {};
+}
+
+void DisassemblerCache::Insert(const AddressRange &range, const ArchSpec &arch,
+                               llvm::StringRef flavor,
+                               llvm::StringRef plugin_name,
+                               const lldb::DisassemblerSP &disasm_sp) {
+  const lldb::addr_t file_addr = range.GetBaseAddress().GetFileAddress();
+  if (file_addr == LLDB_INVALID_ADDRESS)
+    return;
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_entries.size() >= g_max_entries) {
+    m_entries.clear();
+    m_max_range_size = 0;
+  }
+  m_entries.emplace(file_addr,
+                    Entry{file_addr + range.GetByteSize(), arch, flavor.str(),
+                          plugin_name.str(), disasm_sp});
+  m_max_range_size = std::max(m_max_range_size, range.GetByteSize());
+}
+
+void DisassemblerCache::Invalidate(lldb::addr_t file_addr, lldb::addr_t size) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_entries.empty() || size == 0)
+    return;
+  const lldb::addr_t end = file_addr + size;
+  auto pos = m_entries.lower_bound(
+      file_addr > m_max_range_size ? file_addr - m_max_range_size : 0);
+  while (pos != m_entries.end() && pos->first < end) {
+    if (pos->second.end > file_addr)
+      pos = m_entries.erase(pos);
+    else
+      ++pos;
+  }
+}
+
+void DisassemblerCache::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries.clear();
+  m_max_range_size = 0;
+}
+
+size_t DisassemblerCache::GetSize() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_entries.size();
+}
+
 InstructionList &Disassembler::GetInstructionList() {
   return m_instruction_list;
 }
@@ -13,11 +13,14 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/Timer.h"
 #include "lldb/lldb-private-interfaces.h"
 
 #include "llvm/ADT/StringRef.h"
@@ -149,6 +152,49 @@ DynamicLoader::GetSectionListFromModule(const ModuleSP module) const {
   return sections;
 }
 
+std::vector<ModuleSP>
+DynamicLoader::PrefetchModules(llvm::ArrayRef<FileSpec> files) {
+  std::vector<ModuleSP> prefetched(files.size());
+  Target &target = m_process->GetTarget();
+  PlatformSP platform_sp = target.GetPlatform();
+  if (!platform_sp || !target.GetParallelModuleLoad() || files.size() < 2)
+    return prefetched;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s (%zu files)", LLVM_PRETTY_FUNCTION,
+                     files.size());
+
+  ModuleList &modules = target.GetImages();
+  const ArchSpec &arch = target.GetArchitecture();
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const bool lazy_parsing = target.GetLazyModuleParsing();
+  const bool preload_symbols = target.GetPreloadSymbols() && !lazy_parsing;
+
+  // Use the same lookup as Target::GetOrCreateModule, so that the modules we
+  // create here are the ones the target finds when they get loaded. Unless
+  // module parsing is lazy, their section lists and, if requested, symbols
+  // are then parsed here as well, which only takes each module's own lock.
+  TaskMapOverInt(0, files.size(), [&](size_t i) {
+    ModuleSpec module_spec(files[i], arch);
+    if (modules.FindFirstModule(module_spec))
+      return;
+
+    ModuleSP module_sp;
+    platform_sp->GetSharedModule(module_spec, m_process, module_sp,
+                                 &search_paths, nullptr, nullptr);
+    if (!module_sp || !module_sp->GetObjectFile())
+      return;
+
+    if (!lazy_parsing)
+      module_sp->GetSectionList();
+    if (preload_symbols)
+      module_sp->PreloadSymbols();
+    prefetched[i] = module_sp;
+  });
+
+  return prefetched;
+}
+
 ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
                                             addr_t link_map_addr,
                                             addr_t base_addr,
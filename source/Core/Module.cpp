@@ -11,6 +11,7 @@
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Core/AddressResolverFileLine.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Mangled.h"
 #include "lldb/Core/ModuleSpec.h"
@@ -125,7 +126,9 @@ Module *Module::GetAllocatedModuleAtIndex(size_t idx) {
 }
 
 Module::Module(const ModuleSpec &module_spec)
-    : m_object_offset(0), m_file_has_changed(false),
+    : m_object_offset(0),
+      m_disassembler_cache_up(std::make_unique<DisassemblerCache>()),
+      m_file_has_changed(false),
       m_first_file_changed_log(false) {
   // Scope for locker below...
   {
@@ -221,7 +224,9 @@ Module::Module(const FileSpec &file_spec, const ArchSpec &arch,
                const llvm::sys::TimePoint<> &object_mod_time)
     : m_mod_time(FileSystem::Instance().GetModificationTime(file_spec)), m_arch(arch),
       m_file(file_spec), m_object_offset(object_offset),
-      m_object_mod_time(object_mod_time), m_file_has_changed(false),
+      m_object_mod_time(object_mod_time),
+      m_disassembler_cache_up(std::make_unique<DisassemblerCache>()),
+      m_file_has_changed(false),
       m_first_file_changed_log(false) {
   // Scope for locker below...
   {
@@ -244,7 +249,9 @@ Module::Module(const FileSpec &file_spec, const ArchSpec &arch,
 }
 
 Module::Module()
-    : m_object_offset(0), m_file_has_changed(false),
+    : m_object_offset(0),
+      m_disassembler_cache_up(std::make_unique<DisassemblerCache>()),
+      m_file_has_changed(false),
       m_first_file_changed_log(false) {
   std::lock_guard<std::recursive_mutex> guard(
       GetAllocationModuleCollectionMutex());
@@ -1277,12 +1284,18 @@ SectionList *Module::GetSectionList() {
   return m_sections_up.get();
 }
 
+bool Module::HasParsedSections() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_sections_up != nullptr;
+}
+
 void Module::SectionFileAddressesChanged() {
   ObjectFile *obj_file = GetObjectFile();
   if (obj_file)
     obj_file->SectionFileAddressesChanged();
   if (SymbolFile *symbols = GetSymbolFile())
     symbols->SectionFileAddressesChanged();
+  GetDisassemblerCache().Clear();
 }
 
 UnwindTable &Module::GetUnwindTable() {
@@ -1291,6 +1304,10 @@ UnwindTable &Module::GetUnwindTable() {
   return *m_unwind_table;
 }
 
+DisassemblerCache &Module::GetDisassemblerCache() {
+  return *m_disassembler_cache_up;
+}
+
 SectionList *Module::GetUnifiedSectionList() {
   if (!m_sections_up)
     m_sections_up = std::make_unique<SectionList>();
@@ -1380,12 +1397,13 @@ size_t Module::FindSymbolsMatchingRegExAndType(const RegularExpression &regex,
 }
 
 void Module::PreloadSymbols() {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
   SymbolFile *sym_file = GetSymbolFile();
   if (!sym_file)
     return;
 
   // Prime the symbol file first, since it adds symbols to the symbol table.
+  // It takes the module lock itself, so that it can read its sections
+  // without holding up the other users of the module.
   sym_file->PreloadSymbols();
 
   // Now we can prime the symbol table.
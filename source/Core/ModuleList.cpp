@@ -11,6 +11,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/OptionValueFileSpec.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Interpreter/Property.h"
@@ -94,6 +95,35 @@ bool ModuleListProperties::SetEnableExternalLookup(bool new_value) {
       nullptr, ePropertyEnableExternalLookup, new_value);
 }
 
+bool ModuleListProperties::GetParallelModuleSearch() const {
+  const uint32_t idx = ePropertyParallelModuleSearch;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_modulelist_properties[idx].default_uint_value != 0);
+}
+
+bool ModuleListProperties::SetParallelModuleSearch(bool new_value) {
+  return m_collection_sp->SetPropertyAtIndexAsBoolean(
+      nullptr, ePropertyParallelModuleSearch, new_value);
+}
+
+FileSpec ModuleListProperties::GetSymbolCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertySymbolCachePath)
+      ->GetCurrentValue();
+}
+
+bool ModuleListProperties::SetSymbolCachePath(llvm::StringRef path) {
+  return m_collection_sp->SetPropertyAtIndexAsString(
+      nullptr, ePropertySymbolCachePath, path);
+}
+
+uint64_t ModuleListProperties::GetSymbolCacheMaxSize() const {
+  const uint32_t idx = ePropertySymbolCacheMaxSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_modulelist_properties[idx].default_uint_value);
+}
+
 FileSpec ModuleListProperties::GetClangModulesCachePath() const {
   return m_collection_sp
       ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
@@ -326,6 +356,42 @@ ModuleSP ModuleList::GetModuleAtIndexUnlocked(size_t idx) const {
   return module_sp;
 }
 
+template <typename ResultList, typename SearchFn, typename MergeFn>
+void ModuleList::SearchModules(ResultList &results, SearchFn search,
+                               MergeFn merge) const {
+  // Search a snapshot of the list so that the lock isn't held while the
+  // modules are being searched.
+  collection modules;
+  {
+    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+    modules = m_modules;
+  }
+
+  if (modules.size() < 2 ||
+      !GetGlobalModuleListProperties().GetParallelModuleSearch()) {
+    for (const ModuleSP &module_sp : modules)
+      search(*module_sp, results);
+    return;
+  }
+
+  std::vector<ResultList> module_results(modules.size());
+  TaskMapOverInt(0, modules.size(), [&](size_t i) {
+    search(*modules[i], module_results[i]);
+  });
+  for (ResultList &module_result : module_results)
+    merge(results, module_result);
+}
+
+static void AppendSymbolContexts(SymbolContextList &sc_list,
+                                 SymbolContextList &module_sc_list) {
+  sc_list.Append(module_sc_list);
+}
+
+static void AppendVariables(VariableList &variable_list,
+                            VariableList &module_variable_list) {
+  variable_list.AddVariables(&module_variable_list);
+}
+
 size_t ModuleList::FindFunctions(ConstString name,
                                  FunctionNameType name_type_mask,
                                  bool include_symbols, bool include_inlines,
@@ -339,25 +405,27 @@ size_t ModuleList::FindFunctions(ConstString name,
   if (name_type_mask & eFunctionNameTypeAuto) {
     Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
 
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctions(lookup_info.GetLookupName(), nullptr,
-                            lookup_info.GetNameTypeMask(), include_symbols,
-                            include_inlines, true, sc_list);
-    }
+    SearchModules(
+        sc_list,
+        [&](Module &module, SymbolContextList &module_sc_list) {
+          module.FindFunctions(lookup_info.GetLookupName(), nullptr,
+                               lookup_info.GetNameTypeMask(), include_symbols,
+                               include_inlines, true, module_sc_list);
+        },
+        AppendSymbolContexts);
 
     const size_t new_size = sc_list.GetSize();
 
     if (old_size < new_size)
       lookup_info.Prune(sc_list, old_size);
   } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctions(name, nullptr, name_type_mask, include_symbols,
-                            include_inlines, true, sc_list);
-    }
+    SearchModules(
+        sc_list,
+        [&](Module &module, SymbolContextList &module_sc_list) {
+          module.FindFunctions(name, nullptr, name_type_mask, include_symbols,
+                               include_inlines, true, module_sc_list);
+        },
+        AppendSymbolContexts);
   }
   return sc_list.GetSize() - old_size;
 }
@@ -370,23 +438,26 @@ size_t ModuleList::FindFunctionSymbols(ConstString name,
   if (name_type_mask & eFunctionNameTypeAuto) {
     Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
 
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctionSymbols(lookup_info.GetLookupName(),
-                                  lookup_info.GetNameTypeMask(), sc_list);
-    }
+    SearchModules(
+        sc_list,
+        [&](Module &module, SymbolContextList &module_sc_list) {
+          module.FindFunctionSymbols(lookup_info.GetLookupName(),
+                                     lookup_info.GetNameTypeMask(),
+                                     module_sc_list);
+        },
+        AppendSymbolContexts);
 
     const size_t new_size = sc_list.GetSize();
 
     if (old_size < new_size)
       lookup_info.Prune(sc_list, old_size);
   } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctionSymbols(name, name_type_mask, sc_list);
-    }
+    SearchModules(
+        sc_list,
+        [&](Module &module, SymbolContextList &module_sc_list) {
+          module.FindFunctionSymbols(name, name_type_mask, module_sc_list);
+        },
+        AppendSymbolContexts);
   }
 
   return sc_list.GetSize() - old_size;
@@ -395,14 +466,18 @@ size_t ModuleList::FindFunctionSymbols(ConstString name,
 size_t ModuleList::FindFunctions(const RegularExpression &name,
                                  bool include_symbols, bool include_inlines,
                                  bool append, SymbolContextList &sc_list) {
+  if (!append)
+    sc_list.Clear();
+
   const size_t old_size = sc_list.GetSize();
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    (*pos)->FindFunctions(name, include_symbols, include_inlines, append,
-                          sc_list);
-  }
+  SearchModules(
+      sc_list,
+      [&](Module &module, SymbolContextList &module_sc_list) {
+        module.FindFunctions(name, include_symbols, include_inlines, true,
+                             module_sc_list);
+      },
+      AppendSymbolContexts);
 
   return sc_list.GetSize() - old_size;
 }
@@ -425,11 +500,13 @@ size_t ModuleList::FindGlobalVariables(ConstString name,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    (*pos)->FindGlobalVariables(name, nullptr, max_matches, variable_list);
-  }
+  SearchModules(
+      variable_list,
+      [&](Module &module, VariableList &module_variable_list) {
+        module.FindGlobalVariables(name, nullptr, max_matches,
+                                   module_variable_list);
+      },
+      AppendVariables);
   return variable_list.GetSize() - initial_size;
 }
 
@@ -437,11 +514,12 @@ size_t ModuleList::FindGlobalVariables(const RegularExpression &regex,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    (*pos)->FindGlobalVariables(regex, max_matches, variable_list);
-  }
+  SearchModules(
+      variable_list,
+      [&](Module &module, VariableList &module_variable_list) {
+        module.FindGlobalVariables(regex, max_matches, module_variable_list);
+      },
+      AppendVariables);
   return variable_list.GetSize() - initial_size;
 }
 
@@ -449,28 +527,33 @@ size_t ModuleList::FindSymbolsWithNameAndType(ConstString name,
                                               SymbolType symbol_type,
                                               SymbolContextList &sc_list,
                                               bool append) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
   if (!append)
     sc_list.Clear();
   size_t initial_size = sc_list.GetSize();
 
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos)
-    (*pos)->FindSymbolsWithNameAndType(name, symbol_type, sc_list);
+  SearchModules(
+      sc_list,
+      [&](Module &module, SymbolContextList &module_sc_list) {
+        module.FindSymbolsWithNameAndType(name, symbol_type, module_sc_list);
+      },
+      AppendSymbolContexts);
   return sc_list.GetSize() - initial_size;
 }
 
 size_t ModuleList::FindSymbolsMatchingRegExAndType(
     const RegularExpression &regex, lldb::SymbolType symbol_type,
     SymbolContextList &sc_list, bool append) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
   if (!append)
     sc_list.Clear();
   size_t initial_size = sc_list.GetSize();
 
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos)
-    (*pos)->FindSymbolsMatchingRegExAndType(regex, symbol_type, sc_list);
+  SearchModules(
+      sc_list,
+      [&](Module &module, SymbolContextList &module_sc_list) {
+        module.FindSymbolsMatchingRegExAndType(regex, symbol_type,
+                                               module_sc_list);
+      },
+      AppendSymbolContexts);
   return sc_list.GetSize() - initial_size;
 }
 
@@ -527,6 +610,61 @@ void ModuleList::FindTypes(Module *search_first, ConstString name,
                            bool name_is_fully_qualified, size_t max_matches,
                            llvm::DenseSet<SymbolFile *> &searched_symbol_files,
                            TypeList &types) const {
+  // Without a limit on the number of matches every module gets searched, so
+  // do that in parallel if we may. Only search_first is still searched ahead
+  // of the other modules, to keep its types first in the list.
+  if (max_matches >= UINT32_MAX &&
+      GetGlobalModuleListProperties().GetParallelModuleSearch()) {
+    collection modules;
+    {
+      std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+      modules = m_modules;
+    }
+
+    if (modules.size() > 1) {
+      auto pos = std::find_if(modules.begin(), modules.end(),
+                              [search_first](const ModuleSP &module_sp) {
+                                return module_sp.get() == search_first;
+                              });
+      if (search_first && pos != modules.end()) {
+        search_first->FindTypes(name, name_is_fully_qualified, max_matches,
+                                searched_symbol_files, types);
+        modules.erase(pos);
+      }
+
+      // Each module starts out from the symbol files searched so far, and
+      // the symbol files searched by all of them are merged back afterwards.
+      // A symbol file shared by several modules is only searched by the
+      // first task that gets to it, so its types are only collected once.
+      struct ModuleTypes {
+        TypeList types;
+        llvm::DenseSet<SymbolFile *> searched_symbol_files;
+      };
+      std::vector<ModuleTypes> module_types(modules.size());
+      std::mutex claimed_mutex;
+      llvm::DenseSet<SymbolFile *> claimed_symbol_files = searched_symbol_files;
+      TaskMapOverInt(0, modules.size(), [&](size_t i) {
+        if (SymbolFile *symbol_file = modules[i]->GetSymbolFile()) {
+          std::lock_guard<std::mutex> guard(claimed_mutex);
+          if (!claimed_symbol_files.insert(symbol_file).second)
+            return;
+        }
+        ModuleTypes &result = module_types[i];
+        result.searched_symbol_files = searched_symbol_files;
+        modules[i]->FindTypes(name, name_is_fully_qualified, max_matches,
+                              result.searched_symbol_files, result.types);
+      });
+
+      for (ModuleTypes &result : module_types) {
+        for (const TypeSP &type_sp : result.types.Types())
+          types.Insert(type_sp);
+        searched_symbol_files.insert(result.searched_symbol_files.begin(),
+                                     result.searched_symbol_files.end());
+      }
+      return;
+    }
+  }
+
   std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
 
   collection::const_iterator pos, end = m_modules.end();
@@ -0,0 +1,142 @@
+//===-- NameCorpus.cpp ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/NameCorpus.h"
+
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/Timer.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+// The number of names each parallel task searches.
+static const size_t g_names_per_chunk = 16 * 1024;
+
+void NameCorpus::Finalize() {
+  std::vector<std::pair<ConstString, uint32_t>> pending;
+  pending.swap(m_pending);
+  Clear();
+  if (pending.empty())
+    return;
+
+  // Group the values of each name. Names compare by address here, as only
+  // equality matters.
+  llvm::sort(pending.begin(), pending.end(),
+             [](const std::pair<ConstString, uint32_t> &lhs,
+                const std::pair<ConstString, uint32_t> &rhs) {
+               const uintptr_t lhs_name = uintptr_t(lhs.first.GetCString());
+               const uintptr_t rhs_name = uintptr_t(rhs.first.GetCString());
+               if (lhs_name != rhs_name)
+                 return lhs_name < rhs_name;
+               return lhs.second < rhs.second;
+             });
+
+  m_values.reserve(pending.size());
+  for (size_t i = 0; i < pending.size(); ++i) {
+    ConstString name = pending[i].first;
+    if (i == 0 || name != pending[i - 1].first) {
+      m_name_offsets.push_back(m_data.size());
+      m_value_offsets.push_back(m_values.size());
+      m_data.append(name.GetCString(), name.GetLength());
+      m_data.push_back('\0');
+    }
+    m_values.push_back(pending[i].second);
+  }
+  m_name_offsets.push_back(m_data.size());
+  m_value_offsets.push_back(m_values.size());
+
+  m_data.shrink_to_fit();
+  m_name_offsets.shrink_to_fit();
+  m_value_offsets.shrink_to_fit();
+}
+
+void NameCorpus::Clear() {
+  m_pending.clear();
+  m_data.clear();
+  m_name_offsets.clear();
+  m_value_offsets.clear();
+  m_values.clear();
+}
+
+void NameCorpus::FindValues(const RegularExpression &regex,
+                            std::vector<uint32_t> &values) const {
+  const size_t num_names = GetSize();
+  if (num_names == 0 || !regex.IsValid())
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "NameCorpus::FindValues (%zu names)",
+                     num_names);
+
+  const size_t num_chunks =
+      (num_names + g_names_per_chunk - 1) / g_names_per_chunk;
+  std::vector<std::vector<uint32_t>> chunk_values(num_chunks);
+  TaskMapOverInt(0, num_chunks, [&](size_t chunk) {
+    const size_t begin = chunk * g_names_per_chunk;
+    const size_t end = std::min(begin + g_names_per_chunk, num_names);
+    FindValues(regex, begin, end, chunk_values[chunk]);
+  });
+
+  const size_t start_size = values.size();
+  for (const std::vector<uint32_t> &chunk : chunk_values)
+    values.insert(values.end(), chunk.begin(), chunk.end());
+  llvm::sort(values.begin() + start_size, values.end());
+}
+
+void NameCorpus::FindValues(const RegularExpression &regex, size_t begin,
+                            size_t end, std::vector<uint32_t> &values) const {
+  auto get_name = [this](size_t name_idx) {
+    return llvm::StringRef(m_data.data() + m_name_offsets[name_idx],
+                           m_name_offsets[name_idx + 1] -
+                               m_name_offsets[name_idx] - 1);
+  };
+
+  // Without a required substring, or with one that could span names, every
+  // name has to be matched.
+  const llvm::StringRef literal = regex.GetRequiredSubstring();
+  if (literal.empty() || literal.find('\0') != llvm::StringRef::npos) {
+    for (size_t name_idx = begin; name_idx < end; ++name_idx)
+      if (regex.Execute(get_name(name_idx)))
+        AppendValues(name_idx, values);
+    return;
+  }
+
+  // Find the names containing the substring. If the regular expression is
+  // just that substring, those are the matches.
+  const uint64_t chunk_offset = m_name_offsets[begin];
+  const llvm::StringRef chunk(m_data.data() + chunk_offset,
+                              m_name_offsets[end] - chunk_offset);
+  const bool literal_matches = regex.IsSubstringMatch();
+  size_t pos = 0;
+  while ((pos = chunk.find(literal, pos)) != llvm::StringRef::npos) {
+    const size_t name_idx =
+        std::upper_bound(m_name_offsets.begin() + begin,
+                         m_name_offsets.begin() + end, chunk_offset + pos) -
+        m_name_offsets.begin() - 1;
+    if (literal_matches || regex.Execute(get_name(name_idx)))
+      AppendValues(name_idx, values);
+    pos = m_name_offsets[name_idx + 1] - chunk_offset;
+  }
+}
+
+void NameCorpus::AppendValues(size_t name_idx,
+                              std::vector<uint32_t> &values) const {
+  values.insert(values.end(), m_values.begin() + m_value_offsets[name_idx],
+                m_values.begin() + m_value_offsets[name_idx + 1]);
+}
+
+size_t NameCorpus::MemorySize() const {
+  return sizeof(NameCorpus) + m_data.capacity() +
+         m_name_offsets.capacity() * sizeof(uint64_t) +
+         (m_value_offsets.capacity() + m_values.capacity()) *
+             sizeof(uint32_t) +
+         m_pending.capacity() * sizeof(std::pair<ConstString, uint32_t>);
+}
@@ -199,3 +199,15 @@ DumpValueObjectOptions &DumpValueObjectOptions::SetPointerAsArray(
   m_pointer_as_array = ptr_array;
   return *this;
 }
+
+DumpValueObjectOptions &
+DumpValueObjectOptions::SetChildrenBudget(uint32_t max_children) {
+  m_children_budget = max_children;
+  return *this;
+}
+
+DumpValueObjectOptions &
+DumpValueObjectOptions::SetTimeBudget(std::chrono::milliseconds timeout) {
+  m_time_budget = timeout;
+  return *this;
+}
@@ -18,9 +18,11 @@
 
 #include "llvm/Support/ConvertUTF.h"
 
+#include <algorithm>
 #include <ctype.h>
 #include <locale>
 #include <memory>
+#include <string.h>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -262,6 +264,88 @@ StringPrinter::GetDefaultEscapingHelper(GetPrintableElementType elem_type) {
   llvm_unreachable("bad element type");
 }
 
+// Printable ASCII characters other than the quote and the backslash are
+// printed verbatim by every escaping helper.
+static bool IsPlainPrintable(uint8_t c) {
+  return c >= 0x20 && c < 0x7F && c != '"' && c != '\\';
+}
+
+// Checks eight bytes at a time whether any of them needs escaping. The
+// zero-byte tests below are exact as to whether some byte matches, which is
+// all we need to decide whether the word can be copied out as-is.
+static bool HasNonPlainByte(uint64_t word) {
+  const uint64_t ones = ~0ULL / 255;
+  const uint64_t highs = ones * 0x80;
+  auto has_less = [&](uint64_t v, uint8_t n) {
+    return ((v - ones * n) & ~v & highs) != 0;
+  };
+  auto has_byte = [&](uint64_t v, uint8_t n) {
+    return has_less(v ^ (ones * n), 1);
+  };
+  return (word & highs) || has_less(word, 0x20) || has_byte(word, 0x7F) ||
+         has_byte(word, '"') || has_byte(word, '\\');
+}
+
+// Returns the end of the run of plain printable bytes starting at begin.
+static uint8_t *FindEndOfPlainRun(uint8_t *begin, uint8_t *end) {
+  uint8_t *pos = begin;
+  while (end - pos >= 8) {
+    uint64_t word;
+    memcpy(&word, pos, sizeof(word));
+    if (HasNonPlainByte(word))
+      break;
+    pos += 8;
+  }
+  while (pos < end && IsPlainPrintable(*pos))
+    ++pos;
+  return pos;
+}
+
+// Prints the bytes in [data, data_end) to the stream, stopping at the first
+// NUL if zero_is_terminator is set. Runs of plain printable characters are
+// written out in one go, and the escaping callback, if any, is only consulted
+// for the bytes in between.
+static void DumpEscapedBytesToStream(
+    Stream &stream, uint8_t *data, uint8_t *data_end, bool zero_is_terminator,
+    const StringPrinter::EscapingHelper &escaping_callback) {
+  uint8_t *stop = data_end;
+  if (zero_is_terminator && data < data_end)
+    if (void *nul = memchr(data, 0, data_end - data))
+      stop = static_cast<uint8_t *>(nul);
+
+  if (!escaping_callback) {
+    if (data < stop)
+      stream.Write(data, stop - data);
+    return;
+  }
+
+  // since we tend to accept partial data (and even partially malformed data)
+  // we might end up with no NULL terminator before the end_ptr hence we need
+  // to take a slower route and ensure we stay within boundaries
+  while (data < stop) {
+    uint8_t *run_end = FindEndOfPlainRun(data, stop);
+    if (run_end != data) {
+      stream.Write(data, run_end - data);
+      data = run_end;
+      continue;
+    }
+
+    uint8_t *next_data = nullptr;
+    auto printable = escaping_callback(data, data_end, next_data);
+    auto printable_bytes = printable.GetBytes();
+    auto printable_size = printable.GetSize();
+    if (!printable_bytes || !next_data) {
+      // GetPrintable() failed on us - print one byte in a desperate resync
+      // attempt
+      printable_bytes = data;
+      printable_size = 1;
+      next_data = data + 1;
+    }
+    stream.Write(printable_bytes, printable_size);
+    data = next_data;
+  }
+}
+
 // use this call if you already have an LLDB-side buffer for the data
 template <typename SourceDataType>
 static bool DumpUTFBufferToStream(
@@ -290,17 +374,8 @@ static bool DumpUTFBufferToStream(
 
     const bool zero_is_terminator = dump_options.GetBinaryZeroIsTerminator();
 
-    if (zero_is_terminator) {
-      while (data_ptr < data_end_ptr) {
-        if (!*data_ptr) {
-          data_end_ptr = data_ptr;
-          break;
-        }
-        data_ptr++;
-      }
-
-      data_ptr = (const SourceDataType *)data.GetDataStart();
-    }
+    if (zero_is_terminator)
+      data_end_ptr = std::find(data_ptr, data_end_ptr, 0);
 
     lldb::DataBufferSP utf8_data_buffer_sp;
     llvm::UTF8 *utf8_data_ptr = nullptr;
@@ -342,34 +417,8 @@ static bool DumpUTFBufferToStream(
                     GetPrintableElementType::UTF8);
     }
 
-    // since we tend to accept partial data (and even partially malformed data)
-    // we might end up with no NULL terminator before the end_ptr hence we need
-    // to take a slower route and ensure we stay within boundaries
-    for (; utf8_data_ptr < utf8_data_end_ptr;) {
-      if (zero_is_terminator && !*utf8_data_ptr)
-        break;
-
-      if (escape_non_printables) {
-        uint8_t *next_data = nullptr;
-        auto printable =
-            escaping_callback(utf8_data_ptr, utf8_data_end_ptr, next_data);
-        auto printable_bytes = printable.GetBytes();
-        auto printable_size = printable.GetSize();
-        if (!printable_bytes || !next_data) {
-          // GetPrintable() failed on us - print one byte in a desperate resync
-          // attempt
-          printable_bytes = utf8_data_ptr;
-          printable_size = 1;
-          next_data = utf8_data_ptr + 1;
-        }
-        for (unsigned c = 0; c < printable_size; c++)
-          stream.Printf("%c", *(printable_bytes + c));
-        utf8_data_ptr = (uint8_t *)next_data;
-      } else {
-        stream.Printf("%c", *utf8_data_ptr);
-        utf8_data_ptr++;
-      }
-    }
+    DumpEscapedBytesToStream(stream, utf8_data_ptr, utf8_data_end_ptr,
+                             zero_is_terminator, escaping_callback);
   }
   if (dump_options.GetQuote() != 0)
     stream.Printf("%c", dump_options.GetQuote());
@@ -440,8 +489,18 @@ bool StringPrinter::ReadStringAndDumpToStream<
 
   lldb::DataBufferSP buffer_sp(new DataBufferHeap(size, 0));
 
-  process_sp->ReadCStringFromMemory(
-      options.GetLocation(), (char *)buffer_sp->GetBytes(), size, my_error);
+  // When the length of the string is known, read all of it in a single
+  // request rather than cache line by cache line, and only fall back to the
+  // piecewise read if that fails, e.g. because the string runs into unmapped
+  // memory. The last byte is left alone to keep the string NUL terminated,
+  // just like ReadCStringFromMemory does.
+  if (options.GetSourceSize() == 0 || size <= 1 ||
+      process_sp->ReadMemory(options.GetLocation(), buffer_sp->GetBytes(),
+                             size - 1, my_error) != size - 1) {
+    my_error.Clear();
+    process_sp->ReadCStringFromMemory(
+        options.GetLocation(), (char *)buffer_sp->GetBytes(), size, my_error);
+  }
 
   if (my_error.Fail())
     return false;
@@ -470,30 +529,8 @@ bool StringPrinter::ReadStringAndDumpToStream<
                   ASCII);
   }
 
-  // since we tend to accept partial data (and even partially malformed data)
-  // we might end up with no NULL terminator before the end_ptr hence we need
-  // to take a slower route and ensure we stay within boundaries
-  for (uint8_t *data = buffer_sp->GetBytes(); *data && (data < data_end);) {
-    if (escape_non_printables) {
-      uint8_t *next_data = nullptr;
-      auto printable = escaping_callback(data, data_end, next_data);
-      auto printable_bytes = printable.GetBytes();
-      auto printable_size = printable.GetSize();
-      if (!printable_bytes || !next_data) {
-        // GetPrintable() failed on us - print one byte in a desperate resync
-        // attempt
-        printable_bytes = data;
-        printable_size = 1;
-        next_data = data + 1;
-      }
-      for (unsigned c = 0; c < printable_size; c++)
-        options.GetStream()->Printf("%c", *(printable_bytes + c));
-      data = (uint8_t *)next_data;
-    } else {
-      options.GetStream()->Printf("%c", *data);
-      data++;
-    }
-  }
+  DumpEscapedBytesToStream(*options.GetStream(), buffer_sp->GetBytes(),
+                           data_end, true, escaping_callback);
 
   const char *suffix_token = options.GetSuffixToken();
 
@@ -563,10 +600,18 @@ static bool ReadUTFBufferAndDumpToStream(
   Status error;
   char *buffer = reinterpret_cast<char *>(buffer_sp->GetBytes());
 
-  if (needs_zero_terminator)
-    process_sp->ReadStringFromMemory(options.GetLocation(), buffer,
-                                     bufferSPSize, error, type_width);
-  else
+  // As above, read strings of known length in a single request and let
+  // ReadStringFromMemory sort out where a partially mapped string ends.
+  if (needs_zero_terminator) {
+    if (!options.GetSourceSize() || bufferSPSize <= type_width ||
+        process_sp->ReadMemory(options.GetLocation(), buffer,
+                               bufferSPSize - type_width,
+                               error) != size_t(bufferSPSize - type_width)) {
+      error.Clear();
+      process_sp->ReadStringFromMemory(options.GetLocation(), buffer,
+                                       bufferSPSize, error, type_width);
+    }
+  } else
     process_sp->ReadMemoryFromInferior(options.GetLocation(),
                                        (char *)buffer_sp->GetBytes(),
                                        bufferSPSize, error);
@@ -36,14 +36,15 @@ ValueObjectPrinter::ValueObjectPrinter(ValueObject *valobj, Stream *s,
 ValueObjectPrinter::ValueObjectPrinter(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
-  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers);
+    InstancePointersSetSP printed_instance_pointers, PrintingBudgetSP budget) {
+  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers,
+       budget);
 }
 
 void ValueObjectPrinter::Init(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
+    InstancePointersSetSP printed_instance_pointers, PrintingBudgetSP budget) {
   m_orig_valobj = valobj;
   m_valobj = nullptr;
   m_stream = s;
@@ -68,6 +69,7 @@ void ValueObjectPrinter::Init(
       printed_instance_pointers
           ? printed_instance_pointers
           : InstancePointersSetSP(new InstancePointersSet());
+  m_budget = budget ? budget : std::make_shared<PrintingBudget>();
 }
 
 bool ValueObjectPrinter::PrintValueObject() {
@@ -579,8 +581,9 @@ void ValueObjectPrinter::PrintChild(
     ValueObjectPrinter child_printer(
         child_sp.get(), m_stream, child_options,
         does_consume_ptr_depth ? --curr_ptr_depth : curr_ptr_depth,
-        m_curr_depth + consumed_depth, m_printed_instance_pointers);
+        m_curr_depth + consumed_depth, m_printed_instance_pointers, m_budget);
     child_printer.PrintValueObject();
+    ++m_budget->num_children_printed;
   }
 }
 
@@ -604,6 +607,33 @@ uint32_t ValueObjectPrinter::GetMaxNumChildrenToPrint(bool &print_dotdotdot) {
   return num_children;
 }
 
+bool ValueObjectPrinter::IsBudgetExhausted() {
+  if (m_budget->exhausted)
+    return true;
+
+  if (m_options.m_children_budget &&
+      m_budget->num_children_printed >= m_options.m_children_budget)
+    m_budget->exhausted = true;
+  else if (m_options.m_time_budget.count() &&
+           std::chrono::steady_clock::now() - m_budget->start_time >=
+               m_options.m_time_budget)
+    m_budget->exhausted = true;
+  else if (TargetSP target_sp = m_valobj->GetTargetSP())
+    m_budget->exhausted =
+        target_sp->GetDebugger().GetCommandInterpreter().WasInterrupted();
+
+  return m_budget->exhausted;
+}
+
+void ValueObjectPrinter::PrintBudgetExhaustedMarker() {
+  // Only the innermost printer that ran out of budget prints the marker, the
+  // enclosing ones just close their brackets.
+  if (m_budget->marker_printed)
+    return;
+  m_budget->marker_printed = true;
+  m_stream->Indent("<output truncated: printing budget exhausted>\n");
+}
+
 void ValueObjectPrinter::PrintChildrenPostamble(bool print_dotdotdot) {
   if (!m_options.m_flat_output) {
     if (print_dotdotdot) {
@@ -668,15 +698,32 @@ void ValueObjectPrinter::PrintChildren(
   size_t num_children = GetMaxNumChildrenToPrint(print_dotdotdot);
   if (num_children) {
     bool any_children_printed = false;
+    bool budget_exhausted = false;
 
     for (size_t idx = 0; idx < num_children; ++idx) {
+      if (IsBudgetExhausted()) {
+        budget_exhausted = true;
+        break;
+      }
       if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
         if (!any_children_printed) {
           PrintChildrenPreamble();
           any_children_printed = true;
         }
         PrintChild(child_sp, curr_ptr_depth);
+        // Make the output of large value trees visible as it is produced
+        // instead of once the whole tree has been printed.
+        m_stream->Flush();
+      }
+    }
+
+    if (budget_exhausted) {
+      if (!any_children_printed) {
+        PrintChildrenPreamble();
+        any_children_printed = true;
       }
+      PrintBudgetExhaustedMarker();
+      print_dotdotdot = false;
     }
 
     if (any_children_printed)
@@ -719,7 +766,12 @@ bool ValueObjectPrinter::PrintChildrenOneLiner(bool hide_names) {
   if (num_children) {
     m_stream->PutChar('(');
 
-    for (uint32_t idx = 0; idx < num_children; ++idx) {
+    uint32_t idx = 0;
+    for (; idx < num_children; ++idx) {
+      if (IsBudgetExhausted()) {
+        print_dotdotdot = true;
+        break;
+      }
       lldb::ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
       if (child_sp)
         child_sp = child_sp->GetQualifiedRepresentationIfAvailable(
@@ -738,11 +790,12 @@ bool ValueObjectPrinter::PrintChildrenOneLiner(bool hide_names) {
             *m_stream, ValueObject::eValueObjectRepresentationStyleSummary,
             m_options.m_format,
             ValueObject::PrintableRepresentationSpecialCases::eDisable);
+        ++m_budget->num_children_printed;
       }
     }
 
     if (print_dotdotdot)
-      m_stream->PutCString(", ...)");
+      m_stream->PutCString(idx ? ", ...)" : "...)");
     else
       m_stream->PutChar(')');
   }
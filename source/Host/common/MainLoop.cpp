@@ -19,12 +19,16 @@
 #include <vector>
 
 // Multiplexing is implemented using kqueue on systems that support it (BSD
-// variants including OSX). On linux we use ppoll, while android uses pselect
-// (ppoll is present but not implemented properly). On windows we use WSApoll
-// (which does not support signals).
+// variants including OSX). On linux we use epoll, which unlike ppoll doesn't
+// need to be handed the whole set of file descriptors on every iteration,
+// while android uses pselect (ppoll is present but not implemented properly).
+// Other systems use ppoll, and on windows we use WSApoll (which does not
+// support signals).
 
 #if HAVE_SYS_EVENT_H
 #include <sys/event.h>
+#elif defined(MAINLOOP_USE_EPOLL)
+#include <sys/epoll.h>
 #elif defined(_WIN32)
 #include <winsock2.h>
 #elif defined(__ANDROID__)
@@ -87,6 +91,9 @@ private:
 #else
 #ifdef __ANDROID__
   fd_set read_fd_set;
+#elif defined(MAINLOOP_USE_EPOLL)
+  struct epoll_event out_events[16];
+  int num_events = -1;
 #else
   std::vector<struct pollfd> read_fds;
 #endif
@@ -139,7 +146,7 @@ void MainLoop::RunImpl::ProcessEvents() {
 }
 #else
 MainLoop::RunImpl::RunImpl(MainLoop &loop) : loop(loop) {
-#ifndef __ANDROID__
+#if !defined(__ANDROID__) && !defined(MAINLOOP_USE_EPOLL)
   read_fds.reserve(loop.m_read_fds.size());
 #endif
 }
@@ -194,6 +201,25 @@ Status MainLoop::RunImpl::Poll() {
 
   return Status();
 }
+#elif defined(MAINLOOP_USE_EPOLL)
+Status MainLoop::RunImpl::Poll() {
+  // The file descriptors are registered with the epoll instance as they are
+  // added, so all that is left is to wait, with our signals unblocked.
+  sigset_t sigmask = get_sigmask();
+
+  // Don't block if there are descriptors that are always readable.
+  const int timeout = loop.m_always_readable_fds.empty() ? -1 : 0;
+  num_events = epoll_pwait(loop.m_epoll, out_events,
+                           llvm::array_lengthof(out_events), timeout, &sigmask);
+  if (num_events < 0) {
+    if (errno != EINTR)
+      return Status(errno, eErrorTypePOSIX);
+    // in case of EINTR, let the main loop run one iteration to process the
+    // signals
+    num_events = 0;
+  }
+  return Status();
+}
 #else
 Status MainLoop::RunImpl::Poll() {
   read_fds.clear();
@@ -227,6 +253,16 @@ void MainLoop::RunImpl::ProcessEvents() {
     if (FD_ISSET(fd.first, &read_fd_set))
       fds.push_back(fd.first);
 
+  for (const auto &handle : fds) {
+#elif defined(MAINLOOP_USE_EPOLL)
+  // Errors and hangups are reported to the callback as readability, so it
+  // can find out about them when it reads. The descriptors are collected
+  // first, as the callbacks can unregister the always readable ones.
+  assert(num_events >= 0);
+  std::vector<IOObject::WaitableHandle> fds(loop.m_always_readable_fds);
+  for (int i = 0; i < num_events; ++i)
+    fds.push_back(out_events[i].data.fd);
+
   for (const auto &handle : fds) {
 #else
   for (const auto &fd : read_fds) {
@@ -258,11 +294,16 @@ MainLoop::MainLoop() {
 #if HAVE_SYS_EVENT_H
   m_kqueue = kqueue();
   assert(m_kqueue >= 0);
+#elif defined(MAINLOOP_USE_EPOLL)
+  m_epoll = epoll_create1(EPOLL_CLOEXEC);
+  assert(m_epoll >= 0);
 #endif
 }
 MainLoop::~MainLoop() {
 #if HAVE_SYS_EVENT_H
   close(m_kqueue);
+#elif defined(MAINLOOP_USE_EPOLL)
+  close(m_epoll);
 #endif
   assert(m_read_fds.size() == 0);
   assert(m_signals.size() == 0);
@@ -290,6 +331,28 @@ MainLoop::ReadHandleUP MainLoop::RegisterReadObject(const IOObjectSP &object_sp,
     return nullptr;
   }
 
+#ifdef MAINLOOP_USE_EPOLL
+  // Level-triggered, as the callbacks don't necessarily read everything that
+  // is available.
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.fd = object_sp->GetWaitableHandle();
+  // A descriptor that was closed while another copy of it stayed open is
+  // still part of the set, so just update its registration in that case.
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+    if (errno == EPERM) {
+      // epoll doesn't support regular files and directories. Reading them
+      // never blocks, so treat them as always readable, like poll does.
+      m_always_readable_fds.push_back(ev.data.fd);
+    } else if (errno != EEXIST ||
+               epoll_ctl(m_epoll, EPOLL_CTL_MOD, ev.data.fd, &ev) == -1) {
+      error.SetErrorToErrno();
+      m_read_fds.erase(ev.data.fd);
+      return nullptr;
+    }
+  }
+#endif
+
   return CreateReadHandle(object_sp);
 }
 
@@ -347,6 +410,14 @@ void MainLoop::UnregisterReadObject(IOObject::WaitableHandle handle) {
   bool erased = m_read_fds.erase(handle);
   UNUSED_IF_ASSERT_DISABLED(erased);
   assert(erased);
+#ifdef MAINLOOP_USE_EPOLL
+  // This fails harmlessly if the descriptor has already been closed, which
+  // removes it from the epoll set as well, or was never part of it.
+  epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, nullptr);
+  m_always_readable_fds.erase(std::remove(m_always_readable_fds.begin(),
+                                          m_always_readable_fds.end(), handle),
+                              m_always_readable_fds.end());
+#endif
 }
 
 void MainLoop::UnregisterSignal(int signo) {
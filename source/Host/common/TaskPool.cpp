@@ -10,6 +10,8 @@
 #include "lldb/Host/ThreadLauncher.h"
 #include "lldb/Utility/Log.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <queue>
 #include <thread>
@@ -102,24 +104,51 @@ void TaskPoolImpl::Worker(TaskPoolImpl *pool) {
 
 void TaskMapOverInt(size_t begin, size_t end,
                     const llvm::function_ref<void(size_t)> &func) {
-  const size_t num_workers = std::min<size_t>(end, GetHardwareConcurrencyHint());
-  std::atomic<size_t> idx{begin};
-  
-  auto wrapper = [&idx, end, &func]() {
-    while (true) {
-      size_t i = idx.fetch_add(1);
-      if (i >= end)
-        break;
+  if (begin >= end)
+    return;
+
+  // The calling thread works through the range as well and then only waits
+  // for the values other threads have already picked up, rather than for the
+  // helper tasks themselves. Helpers that only get to run once the range is
+  // exhausted return right away. This way TaskMapOverInt never waits for a
+  // task that hasn't started yet, which makes it safe to call from a task
+  // running on the pool, e.g. to build a module's index while searching
+  // modules in parallel.
+  struct State {
+    std::atomic<size_t> next;
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    size_t num_done = 0;
+  };
+  auto state = std::make_shared<State>();
+  state->next = begin;
+  const size_t count = end - begin;
+
+  // Helpers may outlive this call, but only ever touch "func" while there
+  // are values left, i.e. before we return.
+  auto worker = [state, end, count, &func]() {
+    size_t num_done = 0;
+    for (size_t i = state->next++; i < end; i = state->next++) {
       func(i);
+      ++num_done;
     }
+    if (num_done == 0)
+      return;
+    std::lock_guard<std::mutex> guard(state->mutex);
+    state->num_done += num_done;
+    if (state->num_done == count)
+      state->done_cv.notify_all();
   };
 
-  std::vector<std::future<void>> futures;
-  futures.reserve(num_workers);
-  for (size_t i = 0; i < num_workers; i++)
-    futures.push_back(TaskPool::AddTask(wrapper));
-  for (size_t i = 0; i < num_workers; i++)
-    futures[i].wait();
+  const size_t num_helpers =
+      std::min<size_t>(count, GetHardwareConcurrencyHint()) - 1;
+  for (size_t i = 0; i < num_helpers; i++)
+    TaskPool::AddTask(worker);
+  worker();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done_cv.wait(lock,
+                      [&state, count] { return state->num_done == count; });
 }
 
 } // namespace lldb_private
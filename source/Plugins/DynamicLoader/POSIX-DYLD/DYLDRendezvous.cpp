@@ -19,6 +19,9 @@
 
 #include "llvm/Support/Path.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "DYLDRendezvous.h"
 
 using namespace lldb;
@@ -90,6 +93,43 @@ static addr_t ResolveRendezvousAddress(Process *process) {
   return info_addr;
 }
 
+/// Returns the link map address of \p info, or LLDB_INVALID_ADDRESS if the
+/// remote did not provide one.
+static addr_t
+GetLinkMapOrInvalid(const LoadedModuleInfoList::LoadedModuleInfo &info) {
+  addr_t link_map;
+  if (!info.get_link_map(link_map))
+    return LLDB_INVALID_ADDRESS;
+  return link_map;
+}
+
+/// Returns the entries of \p list that are not present in \p other. The
+/// lists are compared on every stop at the rendezvous breakpoint and can hold
+/// hundreds of libraries, so index \p other by link map address rather than
+/// comparing every pair of entries.
+static std::vector<const LoadedModuleInfoList::LoadedModuleInfo *>
+GetModulesNotIn(const LoadedModuleInfoList &list,
+                const LoadedModuleInfoList &other) {
+  typedef LoadedModuleInfoList::LoadedModuleInfo LoadedModuleInfo;
+  typedef std::unordered_multimap<addr_t, const LoadedModuleInfo *> IndexMap;
+  IndexMap other_by_link_map;
+  other_by_link_map.reserve(other.m_list.size());
+  for (auto const &info : other.m_list)
+    other_by_link_map.emplace(GetLinkMapOrInvalid(info), &info);
+
+  std::vector<const LoadedModuleInfo *> result;
+  for (auto const &info : list.m_list) {
+    auto range = other_by_link_map.equal_range(GetLinkMapOrInvalid(info));
+    bool found = std::any_of(range.first, range.second,
+                             [&info](const IndexMap::value_type &entry) {
+                               return *entry.second == info;
+                             });
+    if (!found)
+      result.push_back(&info);
+  }
+  return result;
+}
+
 DYLDRendezvous::DYLDRendezvous(Process *process)
     : m_process(process), m_rendezvous_addr(LLDB_INVALID_ADDRESS), m_current(),
       m_previous(), m_loaded_modules(), m_soentries(), m_added_soentries(),
@@ -305,20 +345,9 @@ bool DYLDRendezvous::SaveSOEntriesFromRemote(
 
 bool DYLDRendezvous::AddSOEntriesFromRemote(
     const LoadedModuleInfoList &module_list) {
-  for (auto const &modInfo : module_list.m_list) {
-    bool found = false;
-    for (auto const &existing : m_loaded_modules.m_list) {
-      if (modInfo == existing) {
-        found = true;
-        break;
-      }
-    }
-
-    if (found)
-      continue;
-
+  for (auto const *modInfo : GetModulesNotIn(module_list, m_loaded_modules)) {
     SOEntry entry;
-    if (!FillSOEntryFromModuleInfo(modInfo, entry))
+    if (!FillSOEntryFromModuleInfo(*modInfo, entry))
       return false;
 
     // Only add shared libraries and not the executable.
@@ -334,20 +363,9 @@ bool DYLDRendezvous::AddSOEntriesFromRemote(
 
 bool DYLDRendezvous::RemoveSOEntriesFromRemote(
     const LoadedModuleInfoList &module_list) {
-  for (auto const &existing : m_loaded_modules.m_list) {
-    bool found = false;
-    for (auto const &modInfo : module_list.m_list) {
-      if (modInfo == existing) {
-        found = true;
-        break;
-      }
-    }
-
-    if (found)
-      continue;
-
+  for (auto const *existing : GetModulesNotIn(m_loaded_modules, module_list)) {
     SOEntry entry;
-    if (!FillSOEntryFromModuleInfo(existing, entry))
+    if (!FillSOEntryFromModuleInfo(*existing, entry))
       return false;
 
     // Only add shared libraries and not the executable.
@@ -419,7 +419,12 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
+    std::vector<FileSpec> module_names;
     E = m_rendezvous.loaded_end();
+    for (I = m_rendezvous.loaded_begin(); I != E; ++I)
+      module_names.push_back(I->file_spec);
+    std::vector<ModuleSP> prefetched_modules = PrefetchModules(module_names);
+
     for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
       ModuleSP module_sp =
           LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -574,6 +579,10 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
+  // Create and parse the modules in parallel first. They are then added to
+  // the target and have their sections loaded below, in rendezvous order.
+  std::vector<ModuleSP> prefetched_modules = PrefetchModules(module_names);
+
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
         LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
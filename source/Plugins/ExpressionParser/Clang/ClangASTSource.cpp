@@ -894,9 +894,15 @@ void ClangASTSource::FindExternalVisibleDecls(
                     (name_string ? name_string : "<anonymous>"));
         }
 
-        CompilerType full_type = type_sp->GetFullCompilerType();
-
-        CompilerType copied_clang_type(GuardedCopyType(full_type));
+        // The copy is a minimal import, which completes the type in the
+        // expression only when it needs the definition, and completes the
+        // original then. Completing the original up front pulls in the
+        // types of all its members, so leave that to the import if asked to.
+        CompilerType found_type = m_target->GetEnableLazyTypeImport()
+                                      ? type_sp->GetForwardCompilerType()
+                                      : type_sp->GetFullCompilerType();
+
+        CompilerType copied_clang_type(GuardedCopyType(found_type));
 
         if (!copied_clang_type) {
           LLDB_LOGF(log, "  CAS::FEVD[%u] - Couldn't export a type",
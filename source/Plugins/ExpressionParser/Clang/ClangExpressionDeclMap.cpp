@@ -49,6 +49,8 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclarationName.h"
 #include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/Basic/IdentifierTable.h"
+#include "clang/Lex/Lexer.h"
 
 #include "Plugins/Language/CPlusPlus/CPlusPlusLanguage.h"
 #include "Plugins/LanguageRuntime/CPlusPlus/CPPLanguageRuntime.h"
@@ -120,6 +122,72 @@ bool ClangExpressionDeclMap::WillParse(ExecutionContext &exe_ctx,
   return true;
 }
 
+void ClangExpressionDeclMap::PreloadNames(llvm::StringRef expr) {
+  assert(m_parser_vars);
+
+  Target *target = m_parser_vars->m_exe_ctx.GetTargetPtr();
+  if (!target || expr.empty())
+    return;
+
+  clang::LangOptions lang_opts;
+  lang_opts.ObjC = true;
+  lang_opts.CPlusPlus17 = true;
+  lang_opts.DollarIdents = true;
+  lang_opts.LineComment = true;
+  clang::IdentifierTable keywords(lang_opts);
+
+  std::vector<clang::Token> tokens;
+  clang::Lexer lexer(clang::SourceLocation(), lang_opts, expr.begin(),
+                     expr.begin(), expr.end());
+  bool done = false;
+  while (!done) {
+    clang::Token token;
+    // Returns true once the token is the last one.
+    done = lexer.LexFromRawLexer(token);
+    tokens.push_back(token);
+  }
+
+  // Only Clang's unqualified lookups come through the symbol files by name.
+  // Members and qualified names are looked up in the context they belong to,
+  // and qualifiers like "std" would match far more debug info than the
+  // expression needs.
+  auto is_qualifier = [](const clang::Token &token) {
+    return token.isOneOf(clang::tok::period, clang::tok::arrow,
+                         clang::tok::coloncolon, clang::tok::periodstar,
+                         clang::tok::arrowstar);
+  };
+  std::vector<ConstString> names;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const clang::Token &token = tokens[i];
+    if (!token.is(clang::tok::raw_identifier))
+      continue;
+    if (i > 0 && is_qualifier(tokens[i - 1]))
+      continue;
+    if (i + 1 < tokens.size() && tokens[i + 1].is(clang::tok::coloncolon))
+      continue;
+    llvm::StringRef identifier = token.getRawIdentifier();
+    if (keywords.get(identifier).getTokenID() != clang::tok::identifier)
+      continue;
+    names.push_back(ConstString(identifier));
+  }
+  if (names.empty())
+    return;
+  llvm::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+  if (log) {
+    for (ConstString name : names)
+      LLDB_LOGF(log, "  CEDM::PreloadNames preloading '%s'", name.AsCString());
+  }
+
+  target->GetImages().ForEach([&names](const lldb::ModuleSP &module_sp) {
+    if (SymbolFile *symbol_file = module_sp->GetSymbolFile())
+      symbol_file->PreloadNames(names);
+    return true;
+  });
+}
+
 void ClangExpressionDeclMap::InstallCodeGenerator(
     clang::ASTConsumer *code_gen) {
   assert(m_parser_vars);
@@ -133,6 +201,15 @@ void ClangExpressionDeclMap::DidParse() {
     ClangASTMetrics::DumpCounters(log);
 
   if (m_parser_vars) {
+    // Record how much of the debug info AST we had to pull into the
+    // expression so that the cost of a lookup shows up in the statistics.
+    if (Target *target = m_parser_vars->m_exe_ctx.GetTargetPtr()) {
+      target->IncrementStats(StatisticKind::ExpressionDeclImports,
+                             ClangASTMetrics::GetLocalClangImportCount());
+      target->IncrementStats(StatisticKind::ExpressionDeclCompletions,
+                             ClangASTMetrics::GetLocalDeclCompletionCount());
+    }
+
     for (size_t entity_index = 0, num_entities = m_found_entities.GetSize();
          entity_index < num_entities; ++entity_index) {
       ExpressionVariableSP var_sp(
@@ -96,6 +96,16 @@ public:
   ///     True if parsing is possible; false if it is unsafe to continue.
   bool WillParse(ExecutionContext &exe_ctx, Materializer *materializer);
 
+  /// Look up the identifiers an expression uses unqualified in the target's
+  /// symbol files in one go, so that the one-at-a-time lookups Clang makes
+  /// while parsing find their debug info already parsed. Member names and
+  /// names that qualify or are qualified by another name are skipped. Must
+  /// be called after WillParse.
+  ///
+  /// \param[in] expr
+  ///     The text of the expression.
+  void PreloadNames(llvm::StringRef expr);
+
   void InstallCodeGenerator(clang::ASTConsumer *code_gen);
 
   /// [Used by ClangExpressionParser] For each variable that had an unknown
@@ -11,6 +11,7 @@
 #include "clang/AST/ExternalASTSource.h"
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/Basic/DiagnosticIDs.h"
+#include "clang/Basic/DiagnosticOptions.h"
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/Version.h"
@@ -24,6 +25,7 @@
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Frontend/FrontendPluginRegistry.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Frontend/TextDiagnosticBuffer.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Lex/Preprocessor.h"
@@ -262,6 +264,101 @@ static void SetupModuleHeaderPaths(CompilerInstance *compiler,
   search_opts.ImplicitModuleMaps = true;
 }
 
+/// Prologues shorter than this (e.g. just the fixed expression prefix) are
+/// parsed faster than a precompiled preamble is loaded.
+static const unsigned g_min_preamble_size = 4096;
+
+/// Returns a string describing the options a precompiled preamble depends
+/// on besides its source text. These are the options ASTWriter records in
+/// the PCH, which isn't validated when it is loaded as a preamble.
+static std::string GetPreambleOptionsKey(const CompilerInvocation &invocation) {
+  std::string key;
+  llvm::raw_string_ostream stream(key);
+  const TargetOptions &target_opts = invocation.getTargetOpts();
+  stream << target_opts.Triple << ' ' << target_opts.CPU << ' '
+         << target_opts.ABI;
+  for (const std::string &feature : target_opts.Features)
+    stream << ' ' << feature;
+
+  const LangOptions &lang_opts = *invocation.getLangOpts();
+  stream << ' ' << lang_opts.ObjCRuntime.getAsString();
+#define LANGOPT(Name, Bits, Default, Description)                              \
+  stream << ' ' << lang_opts.Name;
+#define ENUM_LANGOPT(Name, Type, Bits, Default, Description)                   \
+  stream << ' ' << static_cast<unsigned>(lang_opts.get##Name());
+#include "clang/Basic/LangOptions.def"
+  return stream.str();
+}
+
+/// Sets up \a invocation and \a vfs to load the prologue of \a expr (the
+/// macro definitions before its first line of code) from a precompiled
+/// preamble instead of parsing it. The preamble is built on first use and
+/// cached in the persistent variables of \a target.
+///
+/// \return
+///     The preamble, which must outlive the compiler using it, or nullptr if
+///     the whole expression has to be parsed.
+static std::shared_ptr<PrecompiledPreamble> SetUpPreamble(
+    CompilerInvocation &invocation, Expression &expr, llvm::StringRef filename,
+    lldb_private::Target &target,
+    std::shared_ptr<PCHContainerOperations> pch_container_ops,
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> &vfs) {
+  Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS);
+
+  auto *persistent_vars = llvm::cast_or_null<ClangPersistentVariables>(
+      target.GetPersistentExpressionStateForLanguage(lldb::eLanguageTypeC));
+  if (!persistent_vars)
+    return nullptr;
+
+  std::unique_ptr<llvm::MemoryBuffer> buffer = llvm::MemoryBuffer::getMemBuffer(
+      expr.Text(), filename, /*RequiresNullTerminator=*/false);
+  PreambleBounds bounds =
+      ComputePreambleBounds(*invocation.getLangOpts(), buffer.get(), 0);
+  if (bounds.Size < g_min_preamble_size)
+    return nullptr;
+
+  std::string options_key = GetPreambleOptionsKey(invocation);
+  std::shared_ptr<PrecompiledPreamble> preamble =
+      persistent_vars->GetCachedPreamble(
+          options_key, [&](const PrecompiledPreamble &cached) {
+            return cached.CanReuse(invocation, buffer.get(), bounds,
+                                   vfs.get());
+          });
+  if (preamble) {
+    LLDB_LOG(log, "Reusing the precompiled {0} byte expression prologue",
+             bounds.Size);
+  } else {
+    CompilerInvocation preamble_invocation(invocation);
+    InputKind input_kind(invocation.getLangOpts()->ObjC
+                             ? clang::Language::ObjCXX
+                             : clang::Language::CXX);
+    preamble_invocation.getFrontendOpts().Inputs.assign(
+        1, FrontendInputFile(filename, input_kind));
+
+    // Errors in the prologue are reported when the expression is parsed
+    // without the preamble.
+    IntrusiveRefCntPtr<DiagnosticsEngine> diags =
+        CompilerInstance::createDiagnostics(new DiagnosticOptions,
+                                            new IgnoringDiagConsumer);
+    PreambleCallbacks callbacks;
+    llvm::ErrorOr<PrecompiledPreamble> built = PrecompiledPreamble::Build(
+        preamble_invocation, buffer.get(), bounds, *diags, vfs,
+        std::move(pch_container_ops), /*StoreInMemory=*/true, callbacks);
+    if (!built) {
+      LLDB_LOG(log, "Couldn't precompile the expression prologue: {0}",
+               built.getError().message());
+      return nullptr;
+    }
+    LLDB_LOG(log, "Precompiled the {0} byte expression prologue",
+             bounds.Size);
+    preamble = std::make_shared<PrecompiledPreamble>(std::move(*built));
+    persistent_vars->SetCachedPreamble(std::move(options_key), preamble);
+  }
+
+  preamble->AddImplicitPreamble(invocation, vfs, buffer.get());
+  return preamble;
+}
+
 //===----------------------------------------------------------------------===//
 // Implementation of ClangExpressionParser
 //===----------------------------------------------------------------------===//
@@ -571,8 +668,17 @@ ClangExpressionParser::ClangExpressionParser(
       m_compiler->getDiagnostics().getDiagnosticOptions());
   m_compiler->getDiagnostics().setClient(diag_mgr);
 
-  // 7. Set up the source management objects inside the compiler
-  m_compiler->createFileManager();
+  // 7. Set up the source management objects inside the compiler. Unless the
+  // expression imports C++ modules, its macro prologue is loaded from a
+  // precompiled preamble shared with the other expressions evaluated at the
+  // same location, so that only the expression itself is parsed.
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs =
+      &m_compiler->getFileManager().getVirtualFileSystem();
+  if (!m_compiler->getLangOpts().Modules)
+    m_preamble = SetUpPreamble(m_compiler->getInvocation(), m_expr,
+                               m_filename, *target_sp,
+                               m_compiler->getPCHContainerOperations(), vfs);
+  m_compiler->createFileManager(vfs);
   if (!m_compiler->hasSourceManager())
     m_compiler->createSourceManager(m_compiler->getFileManager());
   m_compiler->createPreprocessor(TU_Complete);
@@ -968,6 +1074,16 @@ ClangExpressionParser::ParseInternal(DiagnosticManager &diagnostic_manager,
 
   clang::ASTContext &ast_context = m_compiler->getASTContext();
 
+  // The preprocessor skips the precompiled prologue in the main file and
+  // reads its macros from the preamble instead. The reader becomes the
+  // external source that is combined with the ClangASTSource below.
+  if (m_preamble)
+    m_compiler->createPCHExternalASTSource(
+        m_compiler->getPreprocessorOpts().ImplicitPCHInclude,
+        /*DisablePCHValidation=*/true, /*AllowPCHWithCompilerErrors=*/false,
+        /*DeserializationListener=*/nullptr,
+        /*OwnDeserializationListener=*/false);
+
   m_compiler->setSema(new Sema(m_compiler->getPreprocessor(), ast_context,
                                *Consumer, TU_Complete, completion_consumer));
   m_compiler->setASTConsumer(std::move(Consumer));
@@ -21,6 +21,7 @@
 
 namespace clang {
 class CodeCompleteConsumer;
+class PrecompiledPreamble;
 }
 
 namespace lldb_private {
@@ -170,6 +171,10 @@ private:
                          unsigned completion_line = 0,
                          unsigned completion_column = 0);
 
+  /// The precompiled prologue of the expression, or nullptr if the whole
+  /// expression is parsed. The compiler reads the PCH from its memory, so
+  /// this has to outlive m_compiler.
+  std::shared_ptr<clang::PrecompiledPreamble> m_preamble;
   std::unique_ptr<llvm::LLVMContext>
       m_llvm_context; ///< The LLVM context to generate IR into
   std::unique_ptr<clang::CompilerInstance>
@@ -345,27 +345,51 @@ bool ClangExpressionSourceCode::GetText(
         }
       }
 
-      decl_vendor->ForEachMacro(
-          modules_for_macros,
-          [&module_macros](const std::string &expansion) -> bool {
-            module_macros.append(expansion);
-            module_macros.append("\n");
-            return false;
-          });
+      if (const std::string *cached_macros =
+              persistent_vars->GetCachedModuleMacros(modules_for_macros)) {
+        module_macros = *cached_macros;
+      } else {
+        decl_vendor->ForEachMacro(
+            modules_for_macros,
+            [&module_macros](const std::string &expansion) -> bool {
+              module_macros.append(expansion);
+              module_macros.append("\n");
+              return false;
+            });
+        persistent_vars->SetCachedModuleMacros(modules_for_macros,
+                                               module_macros);
+      }
     }
   }
 
-  StreamString debug_macros_stream;
+  std::string debug_macros;
   StreamString lldb_local_var_decls;
   if (StackFrame *frame = exe_ctx.GetFramePtr()) {
     const SymbolContext &sc = frame->GetSymbolContext(
         lldb::eSymbolContextCompUnit | lldb::eSymbolContextLineEntry);
 
     if (sc.comp_unit && sc.line_entry.IsValid()) {
-      DebugMacros *dm = sc.comp_unit->GetDebugMacros();
-      if (dm) {
+      ClangPersistentVariables *persistent_vars =
+          target ? llvm::cast_or_null<ClangPersistentVariables>(
+                       target->GetPersistentExpressionStateForLanguage(
+                           lldb::eLanguageTypeC))
+                 : nullptr;
+      const std::string *cached_macros =
+          persistent_vars ? persistent_vars->GetCachedDebugMacros(
+                                *sc.comp_unit, sc.line_entry.file,
+                                sc.line_entry.line)
+                          : nullptr;
+      if (cached_macros) {
+        debug_macros = *cached_macros;
+      } else if (DebugMacros *dm = sc.comp_unit->GetDebugMacros()) {
+        StreamString debug_macros_stream;
         AddMacroState state(sc.line_entry.file, sc.line_entry.line);
         AddMacros(dm, sc.comp_unit, state, debug_macros_stream);
+        debug_macros = debug_macros_stream.GetString().str();
+        if (persistent_vars)
+          persistent_vars->SetCachedDebugMacros(
+              *sc.comp_unit, sc.line_entry.file, sc.line_entry.line,
+              debug_macros);
       }
     }
 
@@ -400,8 +424,11 @@ bool ClangExpressionSourceCode::GetText(
 
     StreamString wrap_stream;
 
+    // The macros have to come first: everything up to the first line of
+    // code is the preamble that ClangExpressionParser precompiles and
+    // reuses for the following expressions.
     wrap_stream.Printf("%s\n%s\n%s\n%s\n%s\n", module_macros.c_str(),
-                       debug_macros_stream.GetData(), g_expression_prefix,
+                       debug_macros.c_str(), g_expression_prefix,
                        target_specific_defines, m_prefix.c_str());
 
     // First construct a tagged form of the user expression so we can find it
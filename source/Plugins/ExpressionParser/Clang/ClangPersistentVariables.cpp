@@ -10,12 +10,14 @@
 
 #include "lldb/Core/Value.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
 
 #include "clang/AST/Decl.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 
 #include "llvm/ADT/StringMap.h"
 
@@ -103,3 +105,77 @@ ClangPersistentVariables::GetPersistentDecl(ConstString name) {
   else
     return i->second;
 }
+
+/// The maximum number of stop locations for which we keep the debug macro
+/// prologue around. Each entry can be large for code built with -g3.
+static const size_t g_max_debug_macros_cache_size = 32;
+
+const std::string *
+ClangPersistentVariables::GetCachedDebugMacros(CompileUnit &comp_unit,
+                                               const FileSpec &file,
+                                               uint32_t line) {
+  auto pos = m_debug_macros_cache.find(
+      DebugMacrosCacheKey(&comp_unit, file, line));
+  if (pos == m_debug_macros_cache.end())
+    return nullptr;
+
+  // The compile unit might have been freed and another one allocated at the
+  // same address since the entry was created.
+  lldb::CompUnitSP cached_cu_sp = pos->second.comp_unit_wp.lock();
+  if (cached_cu_sp.get() != &comp_unit) {
+    m_debug_macros_cache.erase(pos);
+    return nullptr;
+  }
+  return &pos->second.macros;
+}
+
+void ClangPersistentVariables::SetCachedDebugMacros(CompileUnit &comp_unit,
+                                                    const FileSpec &file,
+                                                    uint32_t line,
+                                                    std::string macros) {
+  if (m_debug_macros_cache.size() >= g_max_debug_macros_cache_size)
+    m_debug_macros_cache.clear();
+
+  DebugMacrosCacheEntry &entry =
+      m_debug_macros_cache[DebugMacrosCacheKey(&comp_unit, file, line)];
+  entry.comp_unit_wp = comp_unit.shared_from_this();
+  entry.macros = std::move(macros);
+}
+
+const std::string *ClangPersistentVariables::GetCachedModuleMacros(
+    const ClangModulesDeclVendor::ModuleVector &modules) {
+  if (!m_module_macros_valid || m_module_macros_key != modules)
+    return nullptr;
+  return &m_module_macros;
+}
+
+void ClangPersistentVariables::SetCachedModuleMacros(
+    const ClangModulesDeclVendor::ModuleVector &modules, std::string macros) {
+  m_module_macros_key = modules;
+  m_module_macros = std::move(macros);
+  m_module_macros_valid = true;
+}
+
+/// Each preamble keeps its PCH in memory, so only a few are retained.
+static const size_t g_max_preamble_cache_size = 4;
+
+std::shared_ptr<clang::PrecompiledPreamble>
+ClangPersistentVariables::GetCachedPreamble(
+    llvm::StringRef options_key,
+    llvm::function_ref<bool(const clang::PrecompiledPreamble &)> can_reuse) {
+  for (auto pos = m_preambles.begin(); pos != m_preambles.end(); ++pos) {
+    if (pos->first != options_key || !can_reuse(*pos->second))
+      continue;
+    m_preambles.splice(m_preambles.begin(), m_preambles, pos);
+    return m_preambles.front().second;
+  }
+  return nullptr;
+}
+
+void ClangPersistentVariables::SetCachedPreamble(
+    std::string options_key,
+    std::shared_ptr<clang::PrecompiledPreamble> preamble) {
+  if (m_preambles.size() >= g_max_preamble_cache_size)
+    m_preambles.pop_back();
+  m_preambles.emplace_front(std::move(options_key), std::move(preamble));
+}
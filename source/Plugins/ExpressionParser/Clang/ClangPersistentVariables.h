@@ -10,11 +10,21 @@
 #define liblldb_ClangPersistentVariables_h_
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <list>
+#include <map>
+#include <tuple>
 
 #include "ClangExpressionVariable.h"
 #include "ClangModulesDeclVendor.h"
 
 #include "lldb/Expression/ExpressionVariable.h"
+#include "lldb/Utility/FileSpec.h"
+
+namespace clang {
+class PrecompiledPreamble;
+}
 
 namespace lldb_private {
 
@@ -74,6 +84,33 @@ public:
     return m_hand_loaded_clang_modules;
   }
 
+  /// Returns the #define/#undef prologue that was previously generated from
+  /// the debug macros of \a comp_unit for an expression evaluated at
+  /// \a file:\a line, or nullptr if there is no cached prologue.
+  const std::string *GetCachedDebugMacros(CompileUnit &comp_unit,
+                                          const FileSpec &file, uint32_t line);
+
+  void SetCachedDebugMacros(CompileUnit &comp_unit, const FileSpec &file,
+                            uint32_t line, std::string macros);
+
+  /// Returns the macro prologue that was previously generated for the given
+  /// set of Clang modules, or nullptr if there is no cached prologue.
+  const std::string *
+  GetCachedModuleMacros(const ClangModulesDeclVendor::ModuleVector &modules);
+
+  void SetCachedModuleMacros(const ClangModulesDeclVendor::ModuleVector &modules,
+                             std::string macros);
+
+  /// Returns a precompiled expression prologue that was built with the
+  /// compiler options described by \a options_key and that \a can_reuse
+  /// accepts for the current expression, or nullptr if there is none.
+  std::shared_ptr<clang::PrecompiledPreamble> GetCachedPreamble(
+      llvm::StringRef options_key,
+      llvm::function_ref<bool(const clang::PrecompiledPreamble &)> can_reuse);
+
+  void SetCachedPreamble(std::string options_key,
+                         std::shared_ptr<clang::PrecompiledPreamble> preamble);
+
 private:
   /// The counter used by GetNextExprFileName.
   uint32_t m_next_user_file_id = 0;
@@ -88,6 +125,30 @@ private:
       m_hand_loaded_clang_modules; ///< These are Clang modules we hand-loaded;
                                    ///these are the highest-
                                    ///< priority source for macros.
+
+  /// Generating the macro prologue of an expression means walking every
+  /// debug macro entry of the compile unit (or every macro exported by the
+  /// imported modules). The result only depends on the stop location, so it
+  /// is cached here and reused by all expressions evaluated at that location.
+  /// \{
+  struct DebugMacrosCacheEntry {
+    std::weak_ptr<CompileUnit> comp_unit_wp;
+    std::string macros;
+  };
+  typedef std::tuple<const CompileUnit *, FileSpec, uint32_t>
+      DebugMacrosCacheKey;
+  std::map<DebugMacrosCacheKey, DebugMacrosCacheEntry> m_debug_macros_cache;
+
+  ClangModulesDeclVendor::ModuleVector m_module_macros_key;
+  std::string m_module_macros;
+  bool m_module_macros_valid = false;
+
+  /// Precompiled prologues, most recently used first. Expressions evaluated
+  /// at the same location share the prologue, so after the first one only
+  /// the expression itself has to be parsed.
+  std::list<std::pair<std::string, std::shared_ptr<clang::PrecompiledPreamble>>>
+      m_preambles;
+  /// \}
 };
 
 } // namespace lldb_private
@@ -583,6 +583,9 @@ bool ClangUserExpression::Parse(DiagnosticManager &diagnostic_manager,
     return false;
   }
 
+  if (target->GetPreloadExpressionNames())
+    DeclMap()->PreloadNames(m_expr_text);
+
   if (m_options.GetExecutionPolicy() == eExecutionPolicyTopLevel) {
     DeclMap()->SetLookupsEnabled(true);
   }
@@ -13,33 +13,44 @@
 #include <unordered_map>
 
 #include "lldb/Core/FileSpecList.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/LZMA.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Target/ModuleCache.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/CRC32.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
 #include "llvm/ADT/IntervalMap.h"
 #include "llvm/ADT/PointerUnion.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Support/ARMBuildAttributes.h"
-#include "llvm/Support/CRC.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MipsABIFlags.h"
+#include "llvm/Support/Process.h"
+
+#include <chrono>
+#include <mutex>
 
 #define CASE_AND_STREAM(s, def, width)                                         \
   case def:                                                                    \
@@ -398,8 +409,65 @@ bool ObjectFileELF::MagicBytesMatch(DataBufferSP &data_sp,
 }
 
 static uint32_t calc_crc32(uint32_t init, const DataExtractor &data) {
-  return llvm::crc32(
-      init, llvm::makeArrayRef(data.GetDataStart(), data.GetByteSize()));
+  llvm::ArrayRef<uint8_t> bytes(data.GetDataStart(), data.GetByteSize());
+
+  // Files without a build ID get checksummed in full, and some of them are
+  // huge, so checksum big ones in chunks in parallel and then combine the
+  // chunks' CRCs.
+  const size_t chunk_size = 16 * 1024 * 1024;
+  if (bytes.size() < 2 * chunk_size)
+    return CalculateCRC32(init, bytes);
+
+  const size_t num_chunks = (bytes.size() + chunk_size - 1) / chunk_size;
+  std::vector<uint32_t> chunk_crcs(num_chunks);
+  TaskMapOverInt(0, num_chunks, [&](size_t i) {
+    chunk_crcs[i] = CalculateCRC32(0, bytes.slice(i * chunk_size).take_front(
+                                          chunk_size));
+  });
+
+  uint32_t crc = init;
+  for (size_t i = 0; i < num_chunks; ++i)
+    crc = CombineCRC32(
+        crc, chunk_crcs[i],
+        std::min<uint64_t>(chunk_size, bytes.size() - i * chunk_size));
+  return crc;
+}
+
+// Computes the CRC of a whole object file. The result is remembered for as
+// long as the file keeps the same modification time and size, so that
+// opening the same build-id-less file again does not checksum it again.
+static uint32_t calc_file_crc32(const FileSpec &file, lldb::offset_t offset,
+                                const DataExtractor &data) {
+  if (!file)
+    return calc_crc32(0, data);
+
+  struct CachedCRC {
+    llvm::sys::TimePoint<> mtime;
+    uint64_t size;
+    uint32_t crc;
+  };
+  static std::mutex g_mutex;
+  static llvm::StringMap<CachedCRC> g_crcs;
+
+  FileSystem &fs = FileSystem::Instance();
+  const llvm::sys::TimePoint<> mtime = fs.GetModificationTime(file);
+  const uint64_t size = fs.GetByteSize(file);
+  const std::string key =
+      llvm::formatv("{0}@{1:x}+{2:x}", file.GetPath(), offset,
+                    data.GetByteSize())
+          .str();
+  {
+    std::lock_guard<std::mutex> guard(g_mutex);
+    auto pos = g_crcs.find(key);
+    if (pos != g_crcs.end() && pos->second.mtime == mtime &&
+        pos->second.size == size)
+      return pos->second.crc;
+  }
+
+  const uint32_t crc = calc_crc32(0, data);
+  std::lock_guard<std::mutex> guard(g_mutex);
+  g_crcs[key] = CachedCRC{mtime, size, crc};
+  return crc;
 }
 
 uint32_t ObjectFileELF::CalculateELFNotesSegmentsCRC32(
@@ -590,7 +658,7 @@ size_t ObjectFileELF::GetModuleSpecifications(
                 core_notes_crc =
                     CalculateELFNotesSegmentsCRC32(program_headers, data);
               } else {
-                gnu_debuglink_crc = calc_crc32(0, data);
+                gnu_debuglink_crc = calc_file_crc32(file, file_offset, data);
               }
             }
             using u32le = llvm::support::ulittle32_t;
@@ -648,8 +716,18 @@ bool ObjectFileELF::SetLoadAddress(Target &target, lldb::addr_t value,
   ModuleSP module_sp = GetModule();
   if (module_sp) {
     size_t num_loaded_sections = 0;
-    SectionList *section_list = GetSectionList();
-    if (section_list) {
+    // With lazy module parsing only the segments get loaded until something
+    // needs the sections. Sections that are created later are loaded through
+    // the segment that contains them.
+    std::vector<SectionSP> sections;
+    if (target.GetLazyModuleParsing() && !module_sp->HasParsedSections()) {
+      sections = ParseSegments();
+    } else if (SectionList *section_list = GetSectionList()) {
+      const size_t num_sections = section_list->GetSize();
+      for (size_t sect_idx = 0; sect_idx < num_sections; ++sect_idx)
+        sections.push_back(section_list->GetSectionAtIndex(sect_idx));
+    }
+    if (!sections.empty()) {
       if (!value_is_offset) {
         addr_t base = GetBaseAddress().GetFileAddress();
         if (base == LLDB_INVALID_ADDRESS)
@@ -657,13 +735,9 @@ bool ObjectFileELF::SetLoadAddress(Target &target, lldb::addr_t value,
         value -= base;
       }
 
-      const size_t num_sections = section_list->GetSize();
-      size_t sect_idx = 0;
-
-      for (sect_idx = 0; sect_idx < num_sections; ++sect_idx) {
+      for (const SectionSP &section_sp : sections) {
         // Iterate through the object file sections to find all of the sections
         // that have SHF_ALLOC in their flag bits.
-        SectionSP section_sp(section_list->GetSectionAtIndex(sect_idx));
         if (section_sp->Test(SHF_ALLOC) ||
             section_sp->GetType() == eSectionTypeContainer) {
           lldb::addr_t load_addr = section_sp->GetFileAddress();
@@ -768,7 +842,7 @@ UUID ObjectFileELF::GetUUID() {
       }
     } else {
       if (!m_gnu_debuglink_crc)
-        m_gnu_debuglink_crc = calc_crc32(0, m_data);
+        m_gnu_debuglink_crc = calc_file_crc32(m_file, m_file_offset, m_data);
       if (m_gnu_debuglink_crc) {
         // Use 4 bytes of crc from the .gnu_debuglink section.
         u32le data(m_gnu_debuglink_crc);
@@ -888,8 +962,11 @@ Address ObjectFileELF::GetBaseAddress() {
     if (H.p_type != PT_LOAD)
       continue;
 
-    return Address(
-        GetSectionList()->FindSectionByID(SegmentID(EnumPHdr.index())), 0);
+    const user_id_t id = SegmentID(EnumPHdr.index());
+    for (const SectionSP &segment_sp : ParseSegments())
+      if (segment_sp->GetID() == id)
+        return Address(segment_sp, 0);
+    return Address(SectionSP(), 0);
   }
   return LLDB_INVALID_ADDRESS;
 }
@@ -1746,6 +1823,11 @@ public:
     ++SegmentCount;
   }
 
+  void AddSegment(SectionSP Seg) {
+    VMRange Range(Seg->GetFileAddress(), Seg->GetByteSize());
+    AddSegment(Range, std::move(Seg));
+  }
+
   void AddSection(SectionAddressInfo Info, SectionSP Sect) {
     if (Info.Range.GetByteSize() == 0)
       return;
@@ -1757,11 +1839,15 @@ public:
 };
 }
 
-void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
-  if (m_sections_up)
-    return;
+llvm::ArrayRef<SectionSP> ObjectFileELF::ParseSegments() {
+  ModuleSP module_sp(GetModule());
+  std::unique_lock<std::recursive_mutex> guard;
+  if (module_sp)
+    guard = std::unique_lock<std::recursive_mutex>(module_sp->GetMutex());
+  if (m_segments_parsed)
+    return m_segments;
+  m_segments_parsed = true;
 
-  m_sections_up = std::make_unique<SectionList>();
   VMAddressProvider regular_provider(GetType(), "PT_LOAD");
   VMAddressProvider tls_provider(GetType(), "PT_TLS");
 
@@ -1778,16 +1864,36 @@ void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
 
     uint32_t Log2Align = llvm::Log2_64(std::max<elf_xword>(PHdr.p_align, 1));
     SectionSP Segment = std::make_shared<Section>(
-        GetModule(), this, SegmentID(EnumPHdr.index()),
+        module_sp, this, SegmentID(EnumPHdr.index()),
         ConstString(provider.GetNextSegmentName()), eSectionTypeContainer,
         InfoOr->GetRangeBase(), InfoOr->GetByteSize(), PHdr.p_offset,
         PHdr.p_filesz, Log2Align, /*flags*/ 0);
     Segment->SetPermissions(GetPermissions(PHdr));
     Segment->SetIsThreadSpecific(PHdr.p_type == PT_TLS);
-    m_sections_up->AddSection(Segment);
+    m_segments.push_back(Segment);
 
     provider.AddSegment(*InfoOr, std::move(Segment));
   }
+  return m_segments;
+}
+
+void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
+  if (m_sections_up)
+    return;
+
+  m_sections_up = std::make_unique<SectionList>();
+  VMAddressProvider regular_provider(GetType(), "PT_LOAD");
+  VMAddressProvider tls_provider(GetType(), "PT_TLS");
+
+  // The segments may already have been created, and even loaded, before the
+  // section headers were needed. Reuse them so that the sections within them
+  // pick up their load addresses.
+  for (const SectionSP &Segment : ParseSegments()) {
+    VMAddressProvider &provider =
+        Segment->IsThreadSpecific() ? tls_provider : regular_provider;
+    m_sections_up->AddSection(Segment);
+    provider.AddSegment(Segment);
+  }
 
   ParseSectionHeaders();
   if (m_section_headers.empty())
@@ -1881,7 +1987,12 @@ std::shared_ptr<ObjectFileELF> ObjectFileELF::GetGnuDebugDataObjectFile() {
   DataExtractor data;
   section->GetSectionData(data);
   llvm::SmallVector<uint8_t, 0> uncompressedData;
+  const auto start_time = std::chrono::steady_clock::now();
   auto err = lldb_private::lzma::uncompress(data.GetData(), uncompressedData);
+  m_decompression_time_ns +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_time)
+          .count();
   if (err) {
     GetModule()->ReportWarning(
         "An error occurred while decompression the section %s: %s",
@@ -2700,6 +2811,9 @@ Symtab *ObjectFileELF::GetSymtab() {
     uint64_t symbol_id = 0;
     std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
 
+    if (ReadSymtabCache(m_symtab_up, m_address_class_map))
+      return m_symtab_up.get();
+
     // Sharable objects and dynamic executables usually have 2 distinct symbol
     // tables, one named ".symtab", and the other ".dynsym". The dynsym is a
     // smaller version of the symtab that only contains global symbols. The
@@ -2816,11 +2930,162 @@ Symtab *ObjectFileELF::GetSymtab() {
     }
 
     m_symtab_up->CalculateSymbolSizes();
+    WriteSymtabCache();
   }
 
   return m_symtab_up.get();
 }
 
+namespace {
+/// Where the symbol table of an object file is kept in the symbol cache, and
+/// the contents of the files it was built from, which a cache entry must
+/// match.
+struct SymtabCacheKey {
+  FileSpec cache_dir_spec;
+  UUID uuid;
+  std::string entry_name;
+  ObjectFile *symtab_objfile;
+  UUID symtab_uuid;
+  uint64_t file_sizes[2];
+};
+} // namespace
+
+// Identifies symbol cache entries written by ObjectFileELF::WriteSymtabCache.
+static const uint32_t g_symtab_cache_magic = 0x32595345; // "ESY2"
+
+static bool GetSymtabCacheKey(ObjectFile &objfile, SymtabCacheKey &key) {
+  ModuleSP module_sp = objfile.GetModule();
+  if (!module_sp || objfile.IsInMemory() || objfile.GetFileOffset() != 0)
+    return false;
+
+  key.cache_dir_spec =
+      ModuleList::GetGlobalModuleListProperties().GetSymbolCachePath();
+  key.uuid = module_sp->GetUUID();
+  const FileSpec &file_spec = objfile.GetFileSpec();
+  if (!key.cache_dir_spec || !key.uuid.IsValid() || !file_spec)
+    return false;
+  key.entry_name = (file_spec.GetFilename().GetStringRef() + ".symtab").str();
+
+  // The symbols may come from a separate debug file, so its identity is part
+  // of the key as well. The files are identified by content, i.e. by their
+  // build IDs or checksums and their sizes, and not by their timestamps,
+  // which copying them around changes.
+  key.symtab_objfile = &objfile;
+  if (SectionList *section_list = module_sp->GetSectionList()) {
+    SectionSP symtab_sp =
+        section_list->FindSectionByType(eSectionTypeELFSymbolTable, true);
+    if (symtab_sp && symtab_sp->GetObjectFile())
+      key.symtab_objfile = symtab_sp->GetObjectFile();
+  }
+  const FileSpec &symtab_file_spec = key.symtab_objfile->GetFileSpec();
+
+  key.symtab_uuid = key.symtab_objfile->GetUUID();
+
+  FileSystem &fs = FileSystem::Instance();
+  key.file_sizes[0] = fs.GetByteSize(file_spec);
+  key.file_sizes[1] = fs.GetByteSize(symtab_file_spec);
+  return true;
+}
+
+bool ObjectFileELF::ReadSymtabCache(
+    std::unique_ptr<Symtab> &symtab_up,
+    FileAddressToAddressClassMap &address_class_map) {
+  SymtabCacheKey key;
+  if (!GetSymtabCacheKey(*this, key))
+    return false;
+
+  const FileSpec entry_spec =
+      ModuleCache::GetEntry(key.cache_dir_spec, key.uuid, key.entry_name);
+  if (!entry_spec)
+    return false;
+
+  // Large entries are memory mapped rather than read.
+  DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(entry_spec);
+  if (!data_sp)
+    return false;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+  DataExtractor data(data_sp, endian::InlHostByteOrder(), GetAddressByteSize());
+  lldb::offset_t offset = 0;
+  if (data.GetU32(&offset) != g_symtab_cache_magic)
+    return false;
+  for (uint64_t file_size : key.file_sizes) {
+    if (data.GetU64(&offset) != file_size)
+      return false;
+  }
+  llvm::ArrayRef<uint8_t> symtab_uuid = key.symtab_uuid.GetBytes();
+  const uint8_t symtab_uuid_size = data.GetU8(&offset);
+  const void *symtab_uuid_bytes = data.GetData(&offset, symtab_uuid_size);
+  if (symtab_uuid_size != symtab_uuid.size() ||
+      (symtab_uuid_size &&
+       (!symtab_uuid_bytes || memcmp(symtab_uuid_bytes, symtab_uuid.data(),
+                                     symtab_uuid_size) != 0)))
+    return false;
+
+  FileAddressToAddressClassMap cached_address_class_map;
+  const uint32_t num_address_classes = data.GetU32(&offset);
+  if (!data.ValidOffsetForDataOfSize(offset, num_address_classes * 9ull))
+    return false;
+  for (uint32_t i = 0; i < num_address_classes; ++i) {
+    const addr_t file_addr = data.GetU64(&offset);
+    cached_address_class_map[file_addr] =
+        static_cast<AddressClass>(data.GetU8(&offset));
+  }
+
+  auto cached_symtab_up = std::make_unique<Symtab>(key.symtab_objfile);
+  if (!cached_symtab_up->Decode(data, &offset, GetModule()->GetSectionList()))
+    return false;
+
+  symtab_up = std::move(cached_symtab_up);
+  address_class_map = std::move(cached_address_class_map);
+  return true;
+}
+
+std::unique_ptr<Symtab> ObjectFileELF::ReadCachedSymtab() {
+  std::unique_ptr<Symtab> symtab_up;
+  FileAddressToAddressClassMap address_class_map;
+  ReadSymtabCache(symtab_up, address_class_map);
+  return symtab_up;
+}
+
+void ObjectFileELF::WriteSymtabCache() {
+  SymtabCacheKey key;
+  if (!GetSymtabCacheKey(*this, key))
+    return;
+
+  StreamString strm(Stream::eBinary, GetAddressByteSize(),
+                    endian::InlHostByteOrder());
+  strm.PutHex32(g_symtab_cache_magic);
+  for (uint64_t file_size : key.file_sizes)
+    strm.PutHex64(file_size);
+  llvm::ArrayRef<uint8_t> symtab_uuid = key.symtab_uuid.GetBytes();
+  strm.PutHex8(symtab_uuid.size());
+  strm.Write(symtab_uuid.data(), symtab_uuid.size());
+  strm.PutHex32(m_address_class_map.size());
+  for (const auto &address_class : m_address_class_map) {
+    strm.PutHex64(address_class.first);
+    strm.PutHex8(static_cast<uint8_t>(address_class.second));
+  }
+  m_symtab_up->Encode(strm);
+
+  Status error = ModuleCache::PutEntry(
+      key.cache_dir_spec, key.uuid, key.entry_name,
+      llvm::ArrayRef<uint8_t>(
+          reinterpret_cast<const uint8_t *>(strm.GetData()), strm.GetSize()));
+  if (error.Fail()) {
+    Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+    LLDB_LOGF(log, "Failed to cache the symbol table of %s: %s",
+              GetFileSpec().GetPath().c_str(), error.AsCString());
+    return;
+  }
+
+  if (uint64_t max_size =
+          ModuleList::GetGlobalModuleListProperties().GetSymbolCacheMaxSize())
+    ModuleCache::PruneIfNeeded(key.cache_dir_spec, max_size * 1024 * 1024,
+                               strm.GetSize());
+}
+
 void ObjectFileELF::RelocateSection(lldb_private::Section *section)
 {
   static const char *debug_prefix = ".debug";
@@ -3308,17 +3573,83 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
   return data.CopyData(section_offset, dst_len, dst);
 }
 
+namespace {
+/// A buffer in a shared mapping of an unlinked temporary file. Large
+/// decompressed sections are kept in one of these, so that their pages can
+/// be written back to the file under memory pressure rather than having to
+/// stay resident or go to swap.
+class DataBufferTempFile : public DataBuffer {
+public:
+  static std::shared_ptr<DataBufferTempFile> Create(size_t size);
+
+  uint8_t *GetBytes() override {
+    return reinterpret_cast<uint8_t *>(m_region_up->data());
+  }
+
+  const uint8_t *GetBytes() const override {
+    return reinterpret_cast<const uint8_t *>(m_region_up->const_data());
+  }
+
+  lldb::offset_t GetByteSize() const override { return m_region_up->size(); }
+
+private:
+  DataBufferTempFile(std::unique_ptr<llvm::sys::fs::mapped_file_region> region)
+      : m_region_up(std::move(region)) {}
+
+  std::unique_ptr<llvm::sys::fs::mapped_file_region> m_region_up;
+};
+} // namespace
+
+std::shared_ptr<DataBufferTempFile> DataBufferTempFile::Create(size_t size) {
+  int fd;
+  llvm::SmallString<128> path;
+  if (llvm::sys::fs::createTemporaryFile("lldb-section", "", fd, path))
+    return nullptr;
+
+  std::shared_ptr<DataBufferTempFile> buffer_sp;
+  std::error_code ec = llvm::sys::fs::resize_file(fd, size);
+  if (!ec) {
+    auto region_up = std::make_unique<llvm::sys::fs::mapped_file_region>(
+        llvm::sys::fs::convertFDToNativeFile(fd),
+        llvm::sys::fs::mapped_file_region::readwrite, size, 0, ec);
+    if (!ec)
+      buffer_sp.reset(new DataBufferTempFile(std::move(region_up)));
+  }
+
+  // The mapping keeps the contents alive after the file is removed. Where a
+  // mapped file can't be removed, it is left behind in the temp directory.
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+  llvm::sys::fs::remove(path);
+  return buffer_sp;
+}
+
 size_t ObjectFileELF::ReadSectionData(Section *section,
                                       DataExtractor &section_data) {
   // If some other objectfile owns this data, pass this to them.
   if (section->GetObjectFile() != this)
     return section->GetObjectFile()->ReadSectionData(section, section_data);
 
+  {
+    std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+    auto pos = m_decompressed_sections.find(section->GetID());
+    if (pos != m_decompressed_sections.end()) {
+      section_data.SetByteOrder(GetByteOrder());
+      section_data.SetAddressByteSize(GetAddressByteSize());
+      section_data.SetData(pos->second);
+      return pos->second->GetByteSize();
+    }
+  }
+
   size_t result = ObjectFile::ReadSectionData(section, section_data);
   if (result == 0 || !llvm::object::Decompressor::isCompressedELFSection(
                          section->Get(), section->GetName().GetStringRef()))
     return result;
 
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s (%s)", LLVM_PRETTY_FUNCTION,
+                     section->GetName().GetCString());
+  const auto start_time = std::chrono::steady_clock::now();
+
   auto Decompressor = llvm::object::Decompressor::create(
       section->GetName().GetStringRef(),
       {reinterpret_cast<const char *>(section_data.GetDataStart()),
@@ -3333,8 +3664,17 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
     return 0;
   }
 
-  auto buffer_sp =
-      std::make_shared<DataBufferHeap>(Decompressor->getDecompressedSize(), 0);
+  // Sections this large are typically .debug_info and friends of big
+  // binaries, which we'd rather not keep on the heap twice over while
+  // another copy is being decompressed.
+  const uint64_t temp_file_threshold = 64 * 1024 * 1024;
+  const uint64_t decompressed_size = Decompressor->getDecompressedSize();
+  DataBufferSP buffer_sp;
+  if (decompressed_size >= temp_file_threshold)
+    buffer_sp = DataBufferTempFile::Create(decompressed_size);
+  if (!buffer_sp)
+    buffer_sp = std::make_shared<DataBufferHeap>(decompressed_size, 0);
+
   if (auto error = Decompressor->decompress(
           {reinterpret_cast<char *>(buffer_sp->GetBytes()),
            size_t(buffer_sp->GetByteSize())})) {
@@ -3346,6 +3686,20 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
     return 0;
   }
 
+  m_decompression_time_ns +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_time)
+          .count();
+
+  {
+    // Another thread may have decompressed the same section in the meantime,
+    // in which case we hand out its copy and let ours go.
+    std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+    buffer_sp =
+        m_decompressed_sections.try_emplace(section->GetID(), buffer_sp)
+            .first->second;
+  }
+
   section_data.SetData(buffer_sp);
   return buffer_sp->GetByteSize();
 }
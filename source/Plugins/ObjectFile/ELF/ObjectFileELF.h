@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "lldb/Symbol/ObjectFile.h"
@@ -18,6 +20,7 @@
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/UUID.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/DenseMap.h"
 
 #include "ELFHeader.h"
 
@@ -112,6 +115,8 @@ public:
 
   lldb_private::Symtab *GetSymtab() override;
 
+  std::unique_ptr<lldb_private::Symtab> ReadCachedSymtab() override;
+
   bool IsStripped() override;
 
   void CreateSections(lldb_private::SectionList &unified_section_list) override;
@@ -146,6 +151,10 @@ public:
   size_t ReadSectionData(lldb_private::Section *section,
                          lldb_private::DataExtractor &section_data) override;
 
+  std::chrono::nanoseconds GetSectionDecompressionTime() const override {
+    return std::chrono::nanoseconds(m_decompression_time_ns.load());
+  }
+
   llvm::ArrayRef<elf::ELFProgramHeader> ProgramHeaders();
   lldb_private::DataExtractor GetSegmentData(const elf::ELFProgramHeader &H);
 
@@ -219,12 +228,26 @@ private:
   /// Cached value of the entry point for this module.
   lldb_private::Address m_entry_point_address;
 
+  /// Container sections for the PT_LOAD and PT_TLS segments. These become the
+  /// top-level sections of the section list, but can be created and loaded
+  /// without parsing the section headers.
+  std::vector<lldb::SectionSP> m_segments;
+  bool m_segments_parsed = false;
+
   /// The architecture detected from parsing elf file contents.
   lldb_private::ArchSpec m_arch_spec;
 
   /// The address class for each symbol in the elf file
   FileAddressToAddressClassMap m_address_class_map;
 
+  /// Decompressed contents of SHF_COMPRESSED sections, by section ID, so
+  /// that partial reads of these sections don't decompress them every time.
+  llvm::DenseMap<lldb::user_id_t, lldb::DataBufferSP> m_decompressed_sections;
+  std::mutex m_decompressed_sections_mutex;
+
+  /// Total time spent decompressing sections, in nanoseconds.
+  std::atomic<uint64_t> m_decompression_time_ns{0};
+
   /// Returns the index of the given section header.
   size_t SectionIndex(const SectionHeaderCollIter &I);
 
@@ -246,6 +269,10 @@ private:
   /// Returns true iff the headers have been successfully parsed.
   bool ParseProgramHeaders();
 
+  /// Creates the container sections for the loadable segments and populates
+  /// m_segments.  This method will compute the segment list only once.
+  llvm::ArrayRef<lldb::SectionSP> ParseSegments();
+
   /// Parses all section headers present in this object file and populates
   /// m_section_headers.  This method will compute the header list only once.
   /// Returns the number of headers parsed.
@@ -303,6 +330,15 @@ private:
   void ParseUnwindSymbols(lldb_private::Symtab *symbol_table,
                           lldb_private::DWARFCallFrameInfo *eh_frame);
 
+  /// Restore a symbol table and the address classes of its symbols from the
+  /// symbol cache. Returns false if there is no up to date cache entry.
+  bool ReadSymtabCache(std::unique_ptr<lldb_private::Symtab> &symtab_up,
+                       FileAddressToAddressClassMap &address_class_map);
+
+  /// Store m_symtab_up and m_address_class_map in the symbol cache, if it is
+  /// enabled.
+  void WriteSymtabCache();
+
   /// Relocates debug sections
   unsigned RelocateDebugSections(const elf::ELFSectionHeader *rel_hdr,
                                  lldb::user_id_t rel_id,
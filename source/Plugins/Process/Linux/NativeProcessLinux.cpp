@@ -735,6 +735,18 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   LLDB_LOG(log, "received trace event, pid = {0}", thread.GetID());
 
+  // If the thread is stepping through a range, keep stepping it without
+  // bothering the client until it leaves the range, reaches a breakpoint or
+  // another thread stops.
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+  if (thread.IsInStepRange(pc) &&
+      m_pending_notification_tid == LLDB_INVALID_THREAD_ID &&
+      m_software_breakpoints.count(pc) == 0) {
+    if (ResumeThread(thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER)
+            .Success())
+      return;
+  }
+
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
@@ -1073,8 +1085,16 @@ Status NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
     case eStateStepping: {
       // Run the thread, possibly feeding it the signal.
       const int signo = action->signal;
-      ResumeThread(static_cast<NativeThreadLinux &>(*thread), action->state,
-                   signo);
+      NativeThreadLinux &linux_thread =
+          static_cast<NativeThreadLinux &>(*thread);
+      // Range steps are only done here with hardware single stepping;
+      // otherwise they stop after the first step.
+      if (action->state == eStateStepping && !software_single_step)
+        linux_thread.SetStepRange(action->step_range_start,
+                                  action->step_range_end);
+      else
+        linux_thread.SetStepRange(LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+      ResumeThread(linux_thread, action->state, signo);
       break;
     }
 
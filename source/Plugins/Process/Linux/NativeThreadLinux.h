@@ -87,6 +87,18 @@ private:
 
   Status RequestStop();
 
+  /// Set the range of addresses that a single step of this thread should keep
+  /// stepping through without reporting a stop. An empty range makes every
+  /// step stop.
+  void SetStepRange(lldb::addr_t start, lldb::addr_t end) {
+    m_step_range_start = start;
+    m_step_range_end = end;
+  }
+
+  bool IsInStepRange(lldb::addr_t pc) const {
+    return m_step_range_start <= pc && pc < m_step_range_end;
+  }
+
   // Private interface
   void MaybeLogStateChange(lldb::StateType new_state);
 
@@ -103,6 +115,8 @@ private:
   WatchpointIndexMap m_watchpoint_index_map;
   WatchpointIndexMap m_hw_break_index_map;
   std::unique_ptr<SingleStepWorkaround> m_step_workaround;
+  lldb::addr_t m_step_range_start = LLDB_INVALID_ADDRESS;
+  lldb::addr_t m_step_range_end = LLDB_INVALID_ADDRESS;
 };
 } // namespace process_linux
 } // namespace lldb_private
@@ -10,6 +10,7 @@
 
 #include "llvm/ADT/StringExtras.h"
 
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Target/UnixSignals.h"
 #include "lldb/Utility/LLDBAssert.h"
 
@@ -22,6 +23,9 @@ using namespace std::chrono;
 
 static const seconds kInterruptTimeout(5);
 
+// Maximum number of pipelined packets whose responses haven't been read yet.
+static const size_t kMaxPacketsInFlight = 16;
+
 /////////////////////////
 // GDBRemoteClientBase //
 /////////////////////////
@@ -169,6 +173,116 @@ GDBRemoteClientBase::SendPacketAndWaitForResponse(
   return SendPacketAndWaitForResponseNoLock(payload, response);
 }
 
+// Whether the packet only queries the stub, so that it can be sent before the
+// responses to earlier packets are known.
+static bool IsPipelinablePacket(llvm::StringRef payload) {
+  if (payload.empty())
+    return false;
+  switch (payload[0]) {
+  case 'm':
+  case 'p':
+  case 'x':
+    return true;
+  default:
+    return payload.startswith("qMemoryRegionInfo");
+  }
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPipelinedPacketsAndWaitForResponses(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses, bool send_async) {
+  responses.clear();
+  responses.reserve(payloads.size());
+
+  Lock lock(*this, send_async);
+  if (!lock) {
+    if (Log *log =
+            ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS))
+      LLDB_LOGF(log,
+                "GDBRemoteClientBase::%s failed to get mutex, not sending "
+                "%zu packets (send_async=%d)",
+                __FUNCTION__, payloads.size(), send_async);
+    return PacketResult::ErrorSendFailed;
+  }
+
+  // With acknowledgments enabled, sending a packet reads its ack, which could
+  // be preceded by the response to an earlier packet.
+  const size_t max_in_flight =
+      !GetSendAcks() && llvm::all_of(payloads, IsPipelinablePacket)
+          ? kMaxPacketsInFlight
+          : 1;
+
+  PacketResult result = PacketResult::Success;
+  size_t num_sent = 0;
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    // Keep the pipeline full. Once a send fails, only the responses to the
+    // packets that already went out are read.
+    while (result == PacketResult::Success && num_sent < payloads.size() &&
+           num_sent < i + max_in_flight) {
+      result = SendPacketNoLock(payloads[num_sent]);
+      if (result == PacketResult::Success)
+        ++num_sent;
+    }
+    if (i == num_sent)
+      break;
+
+    // Don't sync on a timeout here: the sync reads only a few packets, and
+    // the responses to the other packets in flight could come first.
+    responses.emplace_back();
+    PacketResult read_result =
+        ReadPacket(responses.back(), GetPacketTimeout(), false);
+    if (read_result != PacketResult::Success) {
+      // The responses can't be matched up with their packets anymore.
+      responses.pop_back();
+      if (read_result == PacketResult::ErrorReplyTimeout &&
+          !SyncAfterPipelineTimeout(num_sent - i))
+        return PacketResult::ErrorDisconnected;
+      return read_result;
+    }
+  }
+  return result;
+}
+
+std::future<std::vector<StringExtractorGDBRemote>>
+GDBRemoteClientBase::SendPipelinedPacketsAsync(
+    std::vector<std::string> payloads) {
+  return TaskPool::AddTask(
+      [this](const std::vector<std::string> &payloads) {
+        std::vector<StringExtractorGDBRemote> responses;
+        SendPipelinedPacketsAndWaitForResponses(payloads, responses, true);
+        return responses;
+      },
+      std::move(payloads));
+}
+
+bool GDBRemoteClientBase::SyncAfterPipelineTimeout(size_t num_in_flight) {
+  Log *log = ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PACKETS);
+  LLDB_LOGF(log,
+            "GDBRemoteClientBase::%s timed out with %zu packets in flight, "
+            "syncing with the remote",
+            __FUNCTION__, num_in_flight);
+
+  // Drain the responses that are still on their way. Each of them gets a full
+  // timeout, and we stop at the first one that doesn't come.
+  StringExtractorGDBRemote stale_response;
+  size_t num_drained = 0;
+  while (num_drained < num_in_flight &&
+         ReadPacket(stale_response, GetPacketTimeout(), false) ==
+             PacketResult::Success)
+    ++num_drained;
+
+  // Then sync once, skipping any responses that were slower still.
+  if (SyncWithRemoteNoLock(GetPacketTimeout(),
+                           num_in_flight - num_drained + 3))
+    return true;
+
+  LLDB_LOGF(log, "GDBRemoteClientBase::%s failed to sync, disconnecting",
+            __FUNCTION__);
+  Disconnect();
+  return false;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::SendPacketAndReceiveResponseWithOutputSupport(
     llvm::StringRef payload, StringExtractorGDBRemote &response,
@@ -12,6 +12,7 @@
 #include "GDBRemoteCommunication.h"
 
 #include <condition_variable>
+#include <future>
 
 namespace lldb_private {
 namespace process_gdb_remote {
@@ -45,6 +46,41 @@ public:
                                             StringExtractorGDBRemote &response,
                                             bool send_async);
 
+  /// Send several packets and receive their responses, without waiting for
+  /// each response before sending the next packet.
+  ///
+  /// Only queries that don't change any state ("m", "x", "p" and
+  /// "qMemoryRegionInfo") are pipelined, and only when acknowledgments are
+  /// disabled. Any other batch is sent one packet at a time.
+  ///
+  /// \param[in] payloads
+  ///     The packets to send.
+  ///
+  /// \param[out] responses
+  ///     The responses, in the order of \a payloads. If the communication
+  ///     fails, this only holds the responses received before the failure.
+  ///     After a timeout, the responses to the packets still in flight are
+  ///     read and discarded, so that later packets get their own responses.
+  ///
+  /// \return
+  ///     PacketResult::Success if all packets got a response, otherwise the
+  ///     first error.
+  PacketResult SendPipelinedPacketsAndWaitForResponses(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses, bool send_async);
+
+  /// Send a batch of packets pipelined on the task pool, as
+  /// SendPipelinedPacketsAndWaitForResponses does with \a send_async set.
+  ///
+  /// The client has to outlive the returned future. If the communication
+  /// fails, the future only holds the responses received before the failure.
+  ///
+  /// The task takes the connection lock itself, so a thread holding a Lock
+  /// on this client must not wait for the future: that deadlocks. Such a
+  /// thread has to call SendPipelinedPacketsAndWaitForResponses instead.
+  std::future<std::vector<StringExtractorGDBRemote>>
+  SendPipelinedPacketsAsync(std::vector<std::string> payloads);
+
   PacketResult SendPacketAndReceiveResponseWithOutputSupport(
       llvm::StringRef payload, StringExtractorGDBRemote &response,
       bool send_async,
@@ -128,6 +164,12 @@ private:
   bool ShouldStop(const UnixSignals &signals,
                   StringExtractorGDBRemote &response);
 
+  /// Get back in step with the remote after a pipelined response timed out,
+  /// with num_in_flight packets still waiting for their responses. Reads the
+  /// responses that are still coming and then syncs once. Disconnects if the
+  /// sync fails.
+  bool SyncAfterPipelineTimeout(size_t num_in_flight);
+
   class ContinueLock {
   public:
     enum class LockResult { Success, Cancelled, Failed };
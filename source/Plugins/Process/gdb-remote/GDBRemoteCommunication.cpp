@@ -294,90 +294,19 @@ GDBRemoteCommunication::WaitForPacketNoLock(StringExtractorGDBRemote &packet,
       case eConnectionStatusTimedOut:
       case eConnectionStatusInterrupted:
         if (sync_on_timeout) {
-          /// Sync the remote GDB server and make sure we get a response that
-          /// corresponds to what we send.
-          ///
-          /// Sends a "qEcho" packet and makes sure it gets the exact packet
-          /// echoed back. If the qEcho packet isn't supported, we send a qC
-          /// packet and make sure we get a valid thread ID back. We use the
-          /// "qC" packet since its response if very unique: is responds with
-          /// "QC%x" where %x is the thread ID of the current thread. This
-          /// makes the response unique enough from other packet responses to
-          /// ensure we are back on track.
-          ///
-          /// This packet is needed after we time out sending a packet so we
-          /// can ensure that we are getting the response for the packet we
-          /// are sending. There are no sequence IDs in the GDB remote
-          /// protocol (there used to be, but they are not supported anymore)
-          /// so if you timeout sending packet "abc", you might then send
-          /// packet "cde" and get the response for the previous "abc" packet.
-          /// Many responses are "OK" or "" (unsupported) or "EXX" (error) so
-          /// many responses for packets can look like responses for other
-          /// packets. So if we timeout, we need to ensure that we can get
-          /// back on track. If we can't get back on track, we must
-          /// disconnect.
-          bool sync_success = false;
+          // We timed out, we need to sync back up with the server. A response
+          // that arrives before the sync reply is probably the one we were
+          // waiting for.
           bool got_actual_response = false;
-          // We timed out, we need to sync back up with the
-          char echo_packet[32];
-          int echo_packet_len = 0;
-          RegularExpression response_regex;
-
-          if (m_supports_qEcho == eLazyBoolYes) {
-            echo_packet_len = ::snprintf(echo_packet, sizeof(echo_packet),
-                                         "qEcho:%u", ++m_echo_number);
-            std::string regex_str = "^";
-            regex_str += echo_packet;
-            regex_str += "$";
-            response_regex = RegularExpression(regex_str);
-          } else {
-            echo_packet_len =
-                ::snprintf(echo_packet, sizeof(echo_packet), "qC");
-            response_regex =
-                RegularExpression(llvm::StringRef("^QC[0-9A-Fa-f]+$"));
-          }
-
-          PacketResult echo_packet_result =
-              SendPacketNoLock(llvm::StringRef(echo_packet, echo_packet_len));
-          if (echo_packet_result == PacketResult::Success) {
-            const uint32_t max_retries = 3;
-            uint32_t successful_responses = 0;
-            for (uint32_t i = 0; i < max_retries; ++i) {
-              StringExtractorGDBRemote echo_response;
-              echo_packet_result =
-                  WaitForPacketNoLock(echo_response, timeout, false);
-              if (echo_packet_result == PacketResult::Success) {
-                ++successful_responses;
-                if (response_regex.Execute(echo_response.GetStringRef())) {
-                  sync_success = true;
-                  break;
-                } else if (successful_responses == 1) {
-                  // We got something else back as the first successful
-                  // response, it probably is the  response to the packet we
-                  // actually wanted, so copy it over if this is the first
-                  // success and continue to try to get the qEcho response
-                  packet = echo_response;
-                  got_actual_response = true;
-                }
-              } else if (echo_packet_result == PacketResult::ErrorReplyTimeout)
-                continue; // Packet timed out, continue waiting for a response
-              else
-                break; // Something else went wrong getting the packet back, we
-                       // failed and are done trying
-            }
-          }
-
-          // We weren't able to sync back up with the server, we must abort
-          // otherwise all responses might not be from the right packets...
-          if (sync_success) {
-            // We timed out, but were able to recover
-            if (got_actual_response) {
-              // We initially timed out, but we did get a response that came in
-              // before the successful reply to our qEcho packet, so lets say
-              // everything is fine...
+          if (SyncWithRemoteNoLock(timeout, 3, &packet, &got_actual_response)) {
+            // We initially timed out, but we did get a response that came in
+            // before the successful reply to our qEcho packet, so lets say
+            // everything is fine...
+            if (got_actual_response)
               return PacketResult::Success;
-            }
           } else {
+            // We weren't able to sync back up with the server, we must abort
+            // otherwise all responses might not be from the right packets...
             disconnected = true;
             Disconnect();
           }
@@ -408,6 +337,59 @@ GDBRemoteCommunication::WaitForPacketNoLock(StringExtractorGDBRemote &packet,
     return PacketResult::ErrorReplyFailed;
 }
 
+bool GDBRemoteCommunication::SyncWithRemoteNoLock(
+    Timeout<std::micro> timeout, uint32_t max_responses,
+    StringExtractorGDBRemote *first_response, bool *got_first_response) {
+  if (got_first_response)
+    *got_first_response = false;
+
+  char echo_packet[32];
+  int echo_packet_len = 0;
+  RegularExpression response_regex;
+
+  if (m_supports_qEcho == eLazyBoolYes) {
+    echo_packet_len = ::snprintf(echo_packet, sizeof(echo_packet), "qEcho:%u",
+                                 ++m_echo_number);
+    std::string regex_str = "^";
+    regex_str += echo_packet;
+    regex_str += "$";
+    response_regex = RegularExpression(regex_str);
+  } else {
+    echo_packet_len = ::snprintf(echo_packet, sizeof(echo_packet), "qC");
+    response_regex = RegularExpression(llvm::StringRef("^QC[0-9A-Fa-f]+$"));
+  }
+
+  PacketResult echo_packet_result =
+      SendPacketNoLock(llvm::StringRef(echo_packet, echo_packet_len));
+  if (echo_packet_result != PacketResult::Success)
+    return false;
+
+  uint32_t successful_responses = 0;
+  for (uint32_t i = 0; i < max_responses; ++i) {
+    StringExtractorGDBRemote echo_response;
+    echo_packet_result = ReadPacket(echo_response, timeout, false);
+    if (echo_packet_result == PacketResult::Success) {
+      ++successful_responses;
+      if (response_regex.Execute(echo_response.GetStringRef()))
+        return true;
+      if (successful_responses == 1 && first_response) {
+        // We got something else back as the first successful response, it
+        // probably is the response to the packet we actually wanted, so copy
+        // it over if this is the first success and continue to try to get the
+        // qEcho response
+        *first_response = echo_response;
+        if (got_first_response)
+          *got_first_response = true;
+      }
+    } else if (echo_packet_result == PacketResult::ErrorReplyTimeout)
+      continue; // Packet timed out, continue waiting for a response
+    else
+      break; // Something else went wrong getting the packet back, we failed
+             // and are done trying
+  }
+  return false;
+}
+
 bool GDBRemoteCommunication::DecompressPacket() {
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PACKETS));
 
@@ -808,33 +790,39 @@ GDBRemoteCommunication::CheckForPacket(const uint8_t *src, size_t src_len,
       m_history.AddPacket(m_bytes, total_length,
                           GDBRemotePacket::ePacketTypeRecv, total_length);
 
-      // Copy the packet from m_bytes to packet_str expanding the run-length
-      // encoding in the process. Reserve enough byte for the most common case
-      // (no RLE used)
-      std ::string packet_str;
-      packet_str.reserve(m_bytes.length());
-      for (std::string::const_iterator c = m_bytes.begin() + content_start;
-           c != m_bytes.begin() + content_end; ++c) {
-        if (*c == '*') {
-          // '*' indicates RLE. Next character will give us the repeat count
-          // and previous character is what is to be repeated.
-          char char_to_repeat = packet_str.back();
-          // Number of time the previous character is repeated
-          int repeat_count = *++c + 3 - ' ';
-          // We have the char_to_repeat and repeat_count. Now push it in the
-          // packet.
-          for (int i = 0; i < repeat_count; ++i)
-            packet_str.push_back(char_to_repeat);
-        } else if (*c == 0x7d) {
-          // 0x7d is the escape character.  The next character is to be XOR'd
-          // with 0x20.
-          char escapee = *++c ^ 0x20;
-          packet_str.push_back(escapee);
-        } else {
-          packet_str.push_back(*c);
+      // Hand the packet content over to the extractor, whose buffer is reused
+      // from packet to packet. Only packets that use run-length encoding or
+      // escapes need to be expanded into a separate string first.
+      llvm::StringRef content =
+          llvm::StringRef(m_bytes).slice(content_start, content_end);
+      if (content.find_first_of("*}") == llvm::StringRef::npos) {
+        packet.Reset(content);
+      } else {
+        // Reserve enough bytes for the most common case (no RLE used).
+        std::string packet_str;
+        packet_str.reserve(content.size());
+        for (const char *c = content.begin(); c != content.end(); ++c) {
+          if (*c == '*') {
+            // '*' indicates RLE. Next character will give us the repeat count
+            // and previous character is what is to be repeated.
+            char char_to_repeat = packet_str.back();
+            // Number of time the previous character is repeated
+            int repeat_count = *++c + 3 - ' ';
+            // We have the char_to_repeat and repeat_count. Now push it in the
+            // packet.
+            packet_str.append(repeat_count, char_to_repeat);
+          } else if (*c == 0x7d) {
+            // 0x7d is the escape character.  The next character is to be XOR'd
+            // with 0x20.
+            char escapee = *++c ^ 0x20;
+            packet_str.push_back(escapee);
+          } else {
+            packet_str.push_back(*c);
+          }
         }
+        packet.Reset(packet_str);
       }
-      packet = StringExtractorGDBRemote(packet_str);
+      packet.SetResponseValidator(nullptr, nullptr);
 
       if (m_bytes[0] == '$' || m_bytes[0] == '%') {
         assert(checksum_idx < m_bytes.size());
@@ -170,6 +170,37 @@ protected:
                                    Timeout<std::micro> timeout,
                                    bool sync_on_timeout);
 
+  /// Sync the remote GDB server and make sure we get a response that
+  /// corresponds to what we send.
+  ///
+  /// Sends a "qEcho" packet and makes sure it gets the exact packet echoed
+  /// back. If the qEcho packet isn't supported, we send a qC packet and make
+  /// sure we get a valid thread ID back. We use the "qC" packet since its
+  /// response if very unique: is responds with "QC%x" where %x is the thread ID
+  /// of the current thread. This makes the response unique enough from other
+  /// packet responses to ensure we are back on track.
+  ///
+  /// This packet is needed after we time out sending a packet so we can ensure
+  /// that we are getting the response for the packet we are sending. There are
+  /// no sequence IDs in the GDB remote protocol (there used to be, but they are
+  /// not supported anymore) so if you timeout sending packet "abc", you might
+  /// then send packet "cde" and get the response for the previous "abc" packet.
+  /// Many responses are "OK" or "" (unsupported) or "EXX" (error) so many
+  /// responses for packets can look like responses for other packets. So if we
+  /// timeout, we need to ensure that we can get back on track. If we can't get
+  /// back on track, we must disconnect.
+  ///
+  /// At most max_responses reads are attempted. If first_response is given, the
+  /// first response that isn't the sync reply is stored there and
+  /// *got_first_response is set, since it is probably the response to the
+  /// packet that timed out.
+  ///
+  /// Returns true if the sync reply arrived.
+  bool SyncWithRemoteNoLock(Timeout<std::micro> timeout,
+                            uint32_t max_responses,
+                            StringExtractorGDBRemote *first_response = nullptr,
+                            bool *got_first_response = nullptr);
+
   bool CompressionIsEnabled() {
     return m_compression_type != CompressionType::None;
   }
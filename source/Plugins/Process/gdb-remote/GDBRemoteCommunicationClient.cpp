@@ -57,6 +57,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_vCont_C(eLazyBoolCalculate),
       m_supports_vCont_s(eLazyBoolCalculate),
       m_supports_vCont_S(eLazyBoolCalculate),
+      m_supports_vCont_r(eLazyBoolCalculate),
       m_qHostInfo_is_valid(eLazyBoolCalculate),
       m_curr_pid_is_valid(eLazyBoolCalculate),
       m_qProcessInfo_is_valid(eLazyBoolCalculate),
@@ -274,6 +275,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supports_vCont_C = eLazyBoolCalculate;
     m_supports_vCont_s = eLazyBoolCalculate;
     m_supports_vCont_S = eLazyBoolCalculate;
+    m_supports_vCont_r = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
     m_supports_x = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
@@ -463,6 +465,7 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
     m_supports_vCont_C = eLazyBoolNo;
     m_supports_vCont_s = eLazyBoolNo;
     m_supports_vCont_S = eLazyBoolNo;
+    m_supports_vCont_r = eLazyBoolNo;
     if (SendPacketAndWaitForResponse("vCont?", response, false) ==
         PacketResult::Success) {
       const char *response_cstr = response.GetStringRef().data();
@@ -478,6 +481,9 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
       if (::strstr(response_cstr, ";S"))
         m_supports_vCont_S = eLazyBoolYes;
 
+      if (::strstr(response_cstr, ";r"))
+        m_supports_vCont_r = eLazyBoolYes;
+
       if (m_supports_vCont_c == eLazyBoolYes &&
           m_supports_vCont_C == eLazyBoolYes &&
           m_supports_vCont_s == eLazyBoolYes &&
@@ -507,6 +513,8 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
     return m_supports_vCont_s;
   case 'S':
     return m_supports_vCont_S;
+  case 'r':
+    return m_supports_vCont_r;
   default:
     break;
   }
@@ -503,6 +503,7 @@ protected:
   LazyBool m_supports_vCont_C;
   LazyBool m_supports_vCont_s;
   LazyBool m_supports_vCont_S;
+  LazyBool m_supports_vCont_r;
   LazyBool m_qHostInfo_is_valid;
   LazyBool m_curr_pid_is_valid;
   LazyBool m_qProcessInfo_is_valid;
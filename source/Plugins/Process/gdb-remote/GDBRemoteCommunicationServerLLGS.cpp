@@ -1476,7 +1476,7 @@ GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_vCont_actions(
     StringExtractorGDBRemote &packet) {
   StreamString response;
-  response.Printf("vCont;c;C;s;S");
+  response.Printf("vCont;c;C;s;S;r");
 
   return SendPacketNoLock(response.GetString());
 }
@@ -1553,6 +1553,24 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
       thread_action.state = eStateStepping;
       break;
 
+    case 'r':
+      // Step while the pc is within [start, end). The process may report a
+      // stop before the pc leaves the range, in which case this is an
+      // ordinary step.
+      thread_action.state = eStateStepping;
+      thread_action.step_range_start =
+          packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+      if (!packet.GetBytesLeft() || packet.GetChar() != ',')
+        return SendIllFormedResponse(
+            packet, "Could not parse range in vCont packet r action");
+      thread_action.step_range_end =
+          packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+      if (thread_action.step_range_start == LLDB_INVALID_ADDRESS ||
+          thread_action.step_range_end == LLDB_INVALID_ADDRESS)
+        return SendIllFormedResponse(
+            packet, "Could not parse range in vCont packet r action");
+      break;
+
     default:
       return SendIllFormedResponse(packet, "Unsupported vCont action");
       break;
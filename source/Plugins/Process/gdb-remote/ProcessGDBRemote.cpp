@@ -82,6 +82,7 @@
 
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -260,6 +261,7 @@ ProcessGDBRemote::ProcessGDBRemote(lldb::TargetSP target_sp,
       m_async_thread_state_mutex(), m_thread_ids(), m_thread_pcs(),
       m_jstopinfo_sp(), m_jthreadsinfo_sp(), m_continue_c_tids(),
       m_continue_C_tids(), m_continue_s_tids(), m_continue_S_tids(),
+      m_continue_r_tids(),
       m_max_memory_size(0), m_remote_stub_max_memory_size(0),
       m_addr_to_mmap_size(), m_thread_create_bp_sp(),
       m_waiting_for_attach(false), m_destroy_tried_resuming(false),
@@ -1280,6 +1282,7 @@ Status ProcessGDBRemote::WillResume() {
   m_continue_C_tids.clear();
   m_continue_s_tids.clear();
   m_continue_S_tids.clear();
+  m_continue_r_tids.clear();
   m_jstopinfo_sp.reset();
   m_jthreadsinfo_sp.reset();
   return Status();
@@ -1306,7 +1309,8 @@ Status ProcessGDBRemote::DoResume() {
       if (!GetTarget().GetNonStopModeEnabled() &&
           (m_continue_c_tids.size() == num_threads ||
            (m_continue_c_tids.empty() && m_continue_C_tids.empty() &&
-            m_continue_s_tids.empty() && m_continue_S_tids.empty()))) {
+            m_continue_s_tids.empty() && m_continue_S_tids.empty() &&
+            m_continue_r_tids.empty()))) {
         // All threads are continuing, just send a "c" packet
         continue_packet.PutCString("c");
       } else {
@@ -1358,6 +1362,15 @@ Status ProcessGDBRemote::DoResume() {
             continue_packet_error = true;
         }
 
+        if (!continue_packet_error && !m_continue_r_tids.empty()) {
+          if (m_gdb_comm.GetVContSupported('r')) {
+            for (const TIDRange &r : m_continue_r_tids)
+              continue_packet.Printf(";r%" PRIx64 ",%" PRIx64 ":%4.4" PRIx64,
+                                     r.start, r.end, r.tid);
+          } else
+            continue_packet_error = true;
+        }
+
         if (continue_packet_error)
           continue_packet.Clear();
       }
@@ -1365,6 +1378,12 @@ Status ProcessGDBRemote::DoResume() {
       continue_packet_error = true;
 
     if (continue_packet_error) {
+      // Without range stepping, step through the ranges one instruction at a
+      // time.
+      for (const TIDRange &r : m_continue_r_tids)
+        m_continue_s_tids.push_back(r.tid);
+      m_continue_r_tids.clear();
+
       // Either no vCont support, or we tried to use part of the vCont packet
       // that wasn't supported by the remote GDB server. We need to try and
       // make a simple packet that can do our continue
@@ -2718,6 +2737,43 @@ void ProcessGDBRemote::WillPublicStop() {
 }
 
 // Process Memory
+// Copy the memory in the response to an "m" or "x" packet to BUF.
+static size_t ExtractMemoryReadResponse(StringExtractorGDBRemote &response,
+                                        bool binary_memory_read, addr_t addr,
+                                        void *buf, size_t size,
+                                        llvm::StringRef packet,
+                                        Status &error) {
+  if (response.IsNormalResponse()) {
+    error.Clear();
+    if (binary_memory_read) {
+      // The lower level GDBRemoteCommunication packet receive layer has
+      // already de-quoted any 0x7d character escaping that was present in
+      // the packet
+
+      size_t data_received_size = response.GetBytesLeft();
+      if (data_received_size > size) {
+        // Don't write past the end of BUF if the remote debug server gave us
+        // too much data for some reason.
+        data_received_size = size;
+      }
+      memcpy(buf, response.GetStringRef().data(), data_received_size);
+      return data_received_size;
+    } else {
+      return response.GetHexBytes(
+          llvm::MutableArrayRef<uint8_t>((uint8_t *)buf, size), '\xdd');
+    }
+  } else if (response.IsErrorResponse())
+    error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, addr);
+  else if (response.IsUnsupportedResponse())
+    error.SetErrorStringWithFormat(
+        "GDB server does not support reading memory");
+  else
+    error.SetErrorStringWithFormat(
+        "unexpected response to GDB server memory read packet '%s': '%s'",
+        packet.str().c_str(), response.GetStringRef().data());
+  return 0;
+}
+
 size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
                                       Status &error) {
   GetMaxMemorySize();
@@ -2725,12 +2781,9 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   // M and m packets take 2 bytes for 1 byte of memory
   size_t max_memory_size =
       binary_memory_read ? m_max_memory_size : m_max_memory_size / 2;
-  if (size > max_memory_size) {
-    // Keep memory read sizes down to a sane limit. This function will be
-    // called multiple times in order to complete the task by
-    // lldb_private::Process so it is ok to do this.
-    size = max_memory_size;
-  }
+  if (size > max_memory_size)
+    return DoReadMemoryPipelined(addr, buf, size, max_memory_size,
+                                 binary_memory_read, error);
 
   char packet[64];
   int packet_len;
@@ -2741,41 +2794,55 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   UNUSED_IF_ASSERT_DISABLED(packet_len);
   StringExtractorGDBRemote response;
   if (m_gdb_comm.SendPacketAndWaitForResponse(packet, response, true) ==
-      GDBRemoteCommunication::PacketResult::Success) {
-    if (response.IsNormalResponse()) {
-      error.Clear();
-      if (binary_memory_read) {
-        // The lower level GDBRemoteCommunication packet receive layer has
-        // already de-quoted any 0x7d character escaping that was present in
-        // the packet
-
-        size_t data_received_size = response.GetBytesLeft();
-        if (data_received_size > size) {
-          // Don't write past the end of BUF if the remote debug server gave us
-          // too much data for some reason.
-          data_received_size = size;
-        }
-        memcpy(buf, response.GetStringRef().data(), data_received_size);
-        return data_received_size;
-      } else {
-        return response.GetHexBytes(
-            llvm::MutableArrayRef<uint8_t>((uint8_t *)buf, size), '\xdd');
-      }
-    } else if (response.IsErrorResponse())
-      error.SetErrorStringWithFormat("memory read failed for 0x%" PRIx64, addr);
-    else if (response.IsUnsupportedResponse())
-      error.SetErrorStringWithFormat(
-          "GDB server does not support reading memory");
-    else
-      error.SetErrorStringWithFormat(
-          "unexpected response to GDB server memory read packet '%s': '%s'",
-          packet, response.GetStringRef().data());
-  } else {
-    error.SetErrorStringWithFormat("failed to send packet: '%s'", packet);
-  }
+      GDBRemoteCommunication::PacketResult::Success)
+    return ExtractMemoryReadResponse(response, binary_memory_read, addr, buf,
+                                     size, packet, error);
+  error.SetErrorStringWithFormat("failed to send packet: '%s'", packet);
   return 0;
 }
 
+size_t ProcessGDBRemote::DoReadMemoryPipelined(addr_t addr, void *buf,
+                                               size_t size,
+                                               size_t max_memory_size,
+                                               bool binary_memory_read,
+                                               Status &error) {
+  // Split the read at the maximum packet size and send all of the packets
+  // before waiting for their responses, so that a large read doesn't take a
+  // full round-trip per packet.
+  std::vector<std::string> packets;
+  for (size_t offset = 0; offset < size; offset += max_memory_size)
+    packets.push_back(llvm::formatv("{0}{1:x-},{2:x-}",
+                                    binary_memory_read ? 'x' : 'm',
+                                    addr + offset,
+                                    std::min(max_memory_size, size - offset))
+                          .str());
+
+  std::vector<StringExtractorGDBRemote> responses;
+  m_gdb_comm.SendPipelinedPacketsAndWaitForResponses(packets, responses, true);
+
+  uint8_t *bytes = (uint8_t *)buf;
+  size_t bytes_read = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const size_t curr_size = std::min(max_memory_size, size - bytes_read);
+    if (i == responses.size()) {
+      error.SetErrorStringWithFormat("failed to send packet: '%s'",
+                                     packets[i].c_str());
+      break;
+    }
+    const size_t curr_bytes_read = ExtractMemoryReadResponse(
+        responses[i], binary_memory_read, addr + bytes_read,
+        bytes + bytes_read, curr_size, packets[i], error);
+    bytes_read += curr_bytes_read;
+    if (curr_bytes_read < curr_size)
+      break;
+  }
+
+  // Report the memory that could be read, like a single short read would.
+  if (bytes_read > 0)
+    error.Clear();
+  return bytes_read;
+}
+
 Status ProcessGDBRemote::WriteObjectFile(
     std::vector<ObjectFile::LoadableData> entries) {
   Status error;
@@ -3043,6 +3110,10 @@ Status ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num, bool &after) {
   return error;
 }
 
+bool ProcessGDBRemote::SupportsRangeStepping() {
+  return m_gdb_comm.GetVContSupported('r');
+}
+
 Status ProcessGDBRemote::DoDeallocateMemory(lldb::addr_t addr) {
   Status error;
   LazyBool supported = m_gdb_comm.SupportsAllocDeallocMemory();
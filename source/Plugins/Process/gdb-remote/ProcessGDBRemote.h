@@ -179,6 +179,8 @@ public:
 
   Status GetWatchpointSupportInfo(uint32_t &num, bool &after) override;
 
+  bool SupportsRangeStepping() override;
+
   bool StartNoticingNewThreads() override;
 
   bool StopNoticingNewThreads() override;
@@ -258,6 +260,12 @@ protected:
   std::recursive_mutex m_async_thread_state_mutex;
   typedef std::vector<lldb::tid_t> tid_collection;
   typedef std::vector<std::pair<lldb::tid_t, int>> tid_sig_collection;
+  struct TIDRange {
+    lldb::tid_t tid;
+    lldb::addr_t start;
+    lldb::addr_t end;
+  };
+  typedef std::vector<TIDRange> tid_range_collection;
   typedef std::map<lldb::addr_t, lldb::addr_t> MMapMap;
   typedef std::map<uint32_t, std::string> ExpeditedRegisterMap;
   tid_collection m_thread_ids; // Thread IDs for all threads. This list gets
@@ -273,6 +281,7 @@ protected:
   tid_sig_collection m_continue_C_tids;       // 'C' for continue with signal
   tid_collection m_continue_s_tids;           // 's' for step
   tid_sig_collection m_continue_S_tids;       // 'S' for step with signal
+  tid_range_collection m_continue_r_tids;     // 'r' for step through a range
   uint64_t m_max_memory_size; // The maximum number of bytes to read/write when
                               // reading and writing memory
   uint64_t m_remote_stub_max_memory_size; // The maximum memory size the remote
@@ -331,6 +340,10 @@ protected:
 
   void GetMaxMemorySize();
 
+  size_t DoReadMemoryPipelined(lldb::addr_t addr, void *buf, size_t size,
+                               size_t max_memory_size, bool binary_memory_read,
+                               Status &error);
+
   bool CalculateThreadStopInfo(ThreadGDBRemote *thread);
 
   size_t UpdateThreadPCsFromStopReplyThreadsValue(std::string &value);
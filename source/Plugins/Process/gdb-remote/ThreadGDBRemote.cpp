@@ -249,12 +249,16 @@ void ThreadGDBRemote::WillResume(StateType resume_state) {
         gdb_process->m_continue_c_tids.push_back(tid);
       break;
 
-    case eStateStepping:
+    case eStateStepping: {
+      lldb::addr_t start, end;
       if (gdb_process->GetUnixSignals()->SignalIsValid(signo))
         gdb_process->m_continue_S_tids.push_back(std::make_pair(tid, signo));
+      else if (GetResumeStepRange(start, end))
+        gdb_process->m_continue_r_tids.push_back({tid, start, end});
       else
         gdb_process->m_continue_s_tids.push_back(tid);
       break;
+    }
 
     default:
       break;
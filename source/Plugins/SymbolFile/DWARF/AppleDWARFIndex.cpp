@@ -154,6 +154,19 @@ void AppleDWARFIndex::GetFunctions(const RegularExpression &regex,
     DWARFMappedHash::ExtractDIEArray(hash_data, offsets);
 }
 
+void AppleDWARFIndex::GetDIEsForNames(llvm::ArrayRef<ConstString> names,
+                                      std::vector<DIEArray> &dies) {
+  dies.resize(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    llvm::StringRef name = names[i].GetStringRef();
+    for (DWARFMappedHash::MemoryTable *table :
+         {m_apple_names_up.get(), m_apple_types_up.get(),
+          m_apple_namespaces_up.get()})
+      if (table)
+        table->FindByName(name, dies[i]);
+  }
+}
+
 void AppleDWARFIndex::ReportInvalidDIERef(const DIERef &ref,
                                           llvm::StringRef name) {
   m_module.ReportErrorIfModifyDetected(
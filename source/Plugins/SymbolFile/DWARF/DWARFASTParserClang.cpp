@@ -39,6 +39,7 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
+#include "llvm/Support/SaveAndRestore.h"
 
 #include <map>
 #include <memory>
@@ -1943,6 +1944,19 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
 
     {
       if (die.HasChildren()) {
+        // Completing this type resolves the types of its members and base
+        // classes and completes those held by value, which pulls in the units
+        // they are defined in one after the other. Extract all of those units
+        // up front and in parallel. The outermost completion covers the types
+        // completed along the way.
+        std::vector<DWARFUnit::ScopedExtractDIEs> prefetched_units;
+        const bool outermost_completion = !m_prefetching_type_dies;
+        llvm::SaveAndRestore<bool> prefetching(m_prefetching_type_dies, true);
+        if (outermost_completion) {
+          if (DWARFDebugInfo *debug_info = dwarf->DebugInfo())
+            prefetched_units = debug_info->PrefetchTypeDIEs(die);
+        }
+
         LanguageType class_language = eLanguageTypeUnknown;
         if (ClangASTContext::IsObjCObjectOrInterfaceType(clang_type)) {
           class_language = eLanguageTypeObjC;
@@ -88,6 +88,9 @@ protected:
   DIEToDeclContextMap m_die_to_decl_ctx;
   DeclContextToDIEMap m_decl_ctx_to_die;
   std::unique_ptr<lldb_private::ClangASTImporter> m_clang_ast_importer_up;
+  /// Whether a type completion that prefetches the DIEs for the types it
+  /// completes along the way is running.
+  bool m_prefetching_type_dies = false;
   /// @}
 
   clang::DeclContext *GetDeclContextForBlock(const DWARFDIE &die);
@@ -9,6 +9,7 @@
 #include "DWARFContext.h"
 
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -101,6 +102,46 @@ const DWARFDataExtractor &DWARFContext::getOrLoadDebugTypesData() {
                           eSectionTypeDWARFDebugTypesDwo, m_data_debug_types);
 }
 
+void DWARFContext::PreloadSections() {
+  struct Preload {
+    SectionType main_section_type;
+    llvm::Optional<SectionType> dwo_section_type;
+    SectionData &data;
+  };
+  const Preload preloads[] = {
+      {eSectionTypeDWARFDebugInfo, eSectionTypeDWARFDebugInfoDwo,
+       m_data_debug_info},
+      {eSectionTypeDWARFDebugAbbrev, eSectionTypeDWARFDebugAbbrevDwo,
+       m_data_debug_abbrev},
+      {eSectionTypeDWARFDebugStr, eSectionTypeDWARFDebugStrDwo,
+       m_data_debug_str},
+      {eSectionTypeDWARFDebugStrOffsets, eSectionTypeDWARFDebugStrOffsetsDwo,
+       m_data_debug_str_offsets},
+      {eSectionTypeDWARFDebugLine, llvm::None, m_data_debug_line},
+      {eSectionTypeDWARFDebugAddr, llvm::None, m_data_debug_addr},
+      {eSectionTypeDWARFDebugRanges, llvm::None, m_data_debug_ranges},
+      {eSectionTypeDWARFDebugRngLists, llvm::None, m_data_debug_rnglists},
+      {eSectionTypeDWARFDebugTypes, eSectionTypeDWARFDebugTypesDwo,
+       m_data_debug_types},
+  };
+
+  // Load the sections without going through their once flags, so that no
+  // thread that needs one of them waits on a loading thread, which may in
+  // turn wait for a lock that thread holds. The sections are published
+  // afterwards, unless someone else was quicker.
+  DWARFDataExtractor loaded[llvm::array_lengthof(preloads)];
+  TaskMapOverInt(0, llvm::array_lengthof(preloads), [&](size_t i) {
+    const Preload &preload = preloads[i];
+    if (preload.dwo_section_type && isDwo())
+      loaded[i] = LoadSection(m_dwo_section_list, *preload.dwo_section_type);
+    else
+      loaded[i] = LoadSection(m_main_section_list, preload.main_section_type);
+  });
+  for (size_t i = 0; i < llvm::array_lengthof(preloads); ++i)
+    llvm::call_once(preloads[i].data.flag,
+                    [&] { preloads[i].data.data = std::move(loaded[i]); });
+}
+
 llvm::DWARFContext &DWARFContext::GetAsLLVM() {
   if (!m_llvm_context) {
     llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> section_map;
@@ -67,6 +67,14 @@ public:
   const DWARFDataExtractor &getOrLoadStrOffsetsData();
   const DWARFDataExtractor &getOrLoadDebugTypesData();
 
+  /// Load the sections needed for indexing concurrently, so that compressed
+  /// sections get decompressed in parallel rather than one after another on
+  /// first use.
+  ///
+  /// Call this without holding the module lock: it waits for the loading
+  /// threads, which may need the lock themselves.
+  void PreloadSections();
+
   llvm::DWARFContext &GetAsLLVM();
 };
 } // namespace lldb_private
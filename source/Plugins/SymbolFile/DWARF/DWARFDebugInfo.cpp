@@ -12,9 +12,15 @@
 #include <set>
 
 #include "lldb/Host/PosixApi.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/Log.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/Timer.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Casting.h"
 
 #include "DWARFCompileUnit.h"
@@ -24,6 +30,7 @@
 #include "DWARFDebugInfoEntry.h"
 #include "DWARFFormValue.h"
 #include "DWARFTypeUnit.h"
+#include "LogChannelDWARF.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -195,3 +202,124 @@ DWARFDebugInfo::GetDIE(const DIERef &die_ref) {
   return DWARFDIE(); // Not found
 }
 
+std::vector<DWARFUnit::ScopedExtractDIEs>
+DWARFDebugInfo::PrefetchTypeDIEs(const DWARFDIE &type_die) {
+  std::vector<DWARFUnit::ScopedExtractDIEs> extracted_units;
+  if (!type_die)
+    return extracted_units;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "DWARFDebugInfo::PrefetchTypeDIEs (%s)",
+                     type_die.GetName());
+
+  // A type DIE that completing the type needs. The members of types held by
+  // value are needed as well.
+  struct TypeRef {
+    DWARFUnit *unit;
+    dw_offset_t offset;
+    bool by_value;
+  };
+  std::vector<std::pair<DWARFDIE, bool>> worklist{{type_die, true}};
+  std::vector<TypeRef> pending_refs;
+  llvm::SetVector<DWARFUnit *> units;
+  llvm::DenseMap<const DWARFDebugInfoEntry *, bool> visited;
+
+  // The DIEs are only looked up in units that are extracted already, so that
+  // walking them doesn't keep the units extracted.
+  auto add_ref = [&](DWARFUnit *unit, dw_offset_t offset, bool by_value) {
+    if (!unit || offset == DW_INVALID_OFFSET)
+      return;
+    if (DWARFDIE die = unit->GetDIEIfExtracted(offset)) {
+      worklist.emplace_back(die, by_value);
+    } else if (!unit->GetDwoSymbolFile() && unit->ContainsDIEOffset(offset)) {
+      pending_refs.push_back({unit, offset, by_value});
+      units.insert(unit);
+    }
+  };
+  auto add_type_of = [&](const DWARFDIE &die, bool by_value) {
+    DWARFFormValue form_value;
+    if (!die.GetDIE()->GetAttributeValue(die.GetCU(), DW_AT_type, form_value))
+      return;
+    if (form_value.Form() == DW_FORM_ref_sig8) {
+      // The value is the 64-bit signature of the type unit, not an offset.
+      if (DWARFTypeUnit *tu = GetTypeUnitForHash(form_value.Unsigned()))
+        add_ref(tu, tu->GetTypeOffset(), by_value);
+      return;
+    }
+    const dw_offset_t offset = form_value.Reference(die.GetCU()->GetOffset());
+    if (form_value.Form() == DW_FORM_ref_addr)
+      add_ref(GetUnitContainingDIEOffset(DIERef::Section::DebugInfo, offset),
+              offset, by_value);
+    else
+      add_ref(die.GetCU(), offset, by_value);
+  };
+
+  while (true) {
+    while (!worklist.empty()) {
+      DWARFDIE die = worklist.back().first;
+      const bool by_value = worklist.back().second;
+      worklist.pop_back();
+      auto inserted = visited.try_emplace(die.GetDIE(), by_value);
+      if (!inserted.second) {
+        if (inserted.first->second || !by_value)
+          continue;
+        inserted.first->second = true;
+      }
+
+      switch (die.Tag()) {
+      case DW_TAG_typedef:
+      case DW_TAG_const_type:
+      case DW_TAG_volatile_type:
+      case DW_TAG_restrict_type:
+      case DW_TAG_atomic_type:
+      case DW_TAG_array_type:
+        add_type_of(die, by_value);
+        break;
+      case DW_TAG_pointer_type:
+      case DW_TAG_reference_type:
+      case DW_TAG_rvalue_reference_type:
+      case DW_TAG_ptr_to_member_type:
+        // The pointee is only parsed, not completed.
+        add_type_of(die, false);
+        break;
+      case DW_TAG_structure_type:
+      case DW_TAG_union_type:
+      case DW_TAG_class_type:
+        // Declarations are completed from a definition found through the
+        // index, which completing the type looks up anyway.
+        if (!by_value)
+          break;
+        for (DWARFDIE child = die.GetFirstChild(); child;
+             child = child.GetSibling()) {
+          const dw_tag_t tag = child.Tag();
+          if (tag == DW_TAG_member || tag == DW_TAG_inheritance)
+            add_type_of(child, true);
+        }
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (units.empty())
+      break;
+
+    std::vector<DWARFUnit *> units_to_extract = units.takeVector();
+    Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_TYPE_COMPLETION);
+    LLDB_LOG(log, "Prefetching {0} units to complete '{1}'",
+             units_to_extract.size(), type_die.GetName());
+    std::vector<llvm::Optional<DWARFUnit::ScopedExtractDIEs>> scopes(
+        units_to_extract.size());
+    TaskMapOverInt(0, units_to_extract.size(), [&](size_t idx) {
+      scopes[idx].emplace(units_to_extract[idx]->ExtractDIEsScoped());
+    });
+    for (llvm::Optional<DWARFUnit::ScopedExtractDIEs> &scope : scopes)
+      extracted_units.push_back(std::move(*scope));
+
+    std::vector<TypeRef> refs;
+    refs.swap(pending_refs);
+    for (const TypeRef &ref : refs)
+      add_ref(ref.unit, ref.offset, ref.by_value);
+  }
+  return extracted_units;
+}
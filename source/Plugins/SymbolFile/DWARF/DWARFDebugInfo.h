@@ -53,6 +53,21 @@ public:
                               dw_offset_t die_offset);
   DWARFDIE GetDIE(const DIERef &die_ref);
 
+  /// Extract the DIEs of all units that completing \a type_die needs. These
+  /// are the units of the types of its members and base classes, and as
+  /// types held by value get completed too, those of their members and so on.
+  ///
+  /// The units are extracted in parallel, in a batch for each level of
+  /// references between units, so that completing the type afterwards only
+  /// has to do the work that touches the type system, which must happen
+  /// serially under the module mutex.
+  ///
+  /// \return
+  ///     The extracted units. They stay extracted while the returned objects
+  ///     are alive, and after that only if completing the type used them.
+  std::vector<DWARFUnit::ScopedExtractDIEs>
+  PrefetchTypeDIEs(const DWARFDIE &type_die);
+
   enum {
     eDumpFlag_Verbose = (1 << 0),  // Verbose dumping
     eDumpFlag_ShowForm = (1 << 1), // Show the DW_form type
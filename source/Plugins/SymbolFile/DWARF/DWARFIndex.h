@@ -46,6 +46,14 @@ public:
   virtual void GetFunctions(const RegularExpression &regex,
                             DIEArray &offsets) = 0;
 
+  /// Finds the functions, global variables, types and namespaces with any of
+  /// the given names in a single pass over the index. \a names must be sorted
+  /// and unique. On return \a dies holds one array per name, in the same
+  /// order, listing the DIEs of every kind that carry that name. As with the
+  /// single name lookups, the consumer is expected to check the DIE tags.
+  virtual void GetDIEsForNames(llvm::ArrayRef<ConstString> names,
+                               std::vector<DIEArray> &dies) = 0;
+
   virtual void ReportInvalidDIERef(const DIERef &ref, llvm::StringRef name) = 0;
   virtual void Dump(Stream &s) = 0;
 
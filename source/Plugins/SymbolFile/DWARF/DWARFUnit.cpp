@@ -463,13 +463,7 @@ DWARFUnit::GetDIE(dw_offset_t die_offset) {
 
     if (ContainsDIEOffset(die_offset)) {
       ExtractDIEsIfNeeded();
-      DWARFDebugInfoEntry::const_iterator end = m_die_array.cend();
-      DWARFDebugInfoEntry::const_iterator pos =
-          lower_bound(m_die_array.cbegin(), end, die_offset, CompareDIEOffset);
-      if (pos != end) {
-        if (die_offset == (*pos).GetOffset())
-          return DWARFDIE(this, &(*pos));
-      }
+      return FindExtractedDIE(die_offset);
     } else
       GetSymbolFileDWARF().GetObjectFile()->GetModule()->ReportError(
           "GetDIE for DIE 0x%" PRIx32 " is outside of its CU 0x%" PRIx32,
@@ -478,6 +472,25 @@ DWARFUnit::GetDIE(dw_offset_t die_offset) {
   return DWARFDIE(); // Not found
 }
 
+DWARFDIE DWARFUnit::GetDIEIfExtracted(dw_offset_t die_offset) {
+  if (die_offset == DW_INVALID_OFFSET || GetDwoSymbolFile() ||
+      !ContainsDIEOffset(die_offset))
+    return DWARFDIE();
+  llvm::sys::ScopedReader lock(m_die_array_mutex);
+  return FindExtractedDIE(die_offset);
+}
+
+DWARFDIE DWARFUnit::FindExtractedDIE(dw_offset_t die_offset) {
+  DWARFDebugInfoEntry::const_iterator end = m_die_array.cend();
+  DWARFDebugInfoEntry::const_iterator pos =
+      lower_bound(m_die_array.cbegin(), end, die_offset, CompareDIEOffset);
+  if (pos != end) {
+    if (die_offset == (*pos).GetOffset())
+      return DWARFDIE(this, &(*pos));
+  }
+  return DWARFDIE(); // Not found
+}
+
 DWARFUnit &DWARFUnit::GetNonSkeletonUnit() {
   if (SymbolFileDWARFDwo *dwo = GetDwoSymbolFile())
     return *dwo->GetCompileUnit();
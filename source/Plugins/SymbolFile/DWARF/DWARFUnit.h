@@ -165,6 +165,11 @@ public:
 
   DWARFDIE GetDIE(dw_offset_t die_offset);
 
+  /// Like GetDIE(), but only finds the DIE if the DIEs of this unit are
+  /// already extracted. Unlike GetDIE(), this doesn't keep them extracted
+  /// for good, so it can be used while a ScopedExtractDIEs is alive.
+  DWARFDIE GetDIEIfExtracted(dw_offset_t die_offset);
+
   DWARFUnit &GetNonSkeletonUnit();
 
   static uint8_t GetAddressByteSize(const DWARFUnit *cu);
@@ -293,6 +298,7 @@ protected:
 private:
   void ParseProducerInfo();
   void ExtractDIEsRWLocked();
+  DWARFDIE FindExtractedDIE(dw_offset_t die_offset);
   void ClearDIEsRWLocked();
 
   void AddUnitDIE(const DWARFDebugInfoEntry &cu_die);
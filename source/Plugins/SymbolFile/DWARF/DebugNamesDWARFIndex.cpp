@@ -262,6 +262,17 @@ void DebugNamesDWARFIndex::GetFunctions(const RegularExpression &regex,
   }
 }
 
+void DebugNamesDWARFIndex::GetDIEsForNames(llvm::ArrayRef<ConstString> names,
+                                           std::vector<DIEArray> &dies) {
+  m_fallback.GetDIEsForNames(names, dies);
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (const DebugNames::Entry &entry :
+         m_debug_names_up->equal_range(names[i].GetStringRef()))
+      Append(entry, dies[i]);
+  }
+}
+
 void DebugNamesDWARFIndex::Dump(Stream &s) {
   m_fallback.Dump(s);
 
@@ -40,6 +40,8 @@ public:
                     std::vector<DWARFDIE> &dies) override;
   void GetFunctions(const RegularExpression &regex,
                     DIEArray &offsets) override;
+  void GetDIEsForNames(llvm::ArrayRef<ConstString> names,
+                       std::vector<DIEArray> &dies) override;
 
   void ReportInvalidDIERef(const DIERef &ref, llvm::StringRef name) override {}
   void Dump(Stream &s) override;
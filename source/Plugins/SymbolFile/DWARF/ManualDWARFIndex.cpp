@@ -453,6 +453,18 @@ void ManualDWARFIndex::GetFunctions(const RegularExpression &regex,
   m_set.function_fullnames.Find(regex, offsets);
 }
 
+void ManualDWARFIndex::GetDIEsForNames(llvm::ArrayRef<ConstString> names,
+                                       std::vector<DIEArray> &dies) {
+  Index();
+
+  dies.resize(names.size());
+  for (const NameToDIE *map :
+       {&m_set.function_basenames, &m_set.function_fullnames,
+        &m_set.function_methods, &m_set.globals, &m_set.types,
+        &m_set.namespaces})
+    map->Find(names, dies);
+}
+
 void ManualDWARFIndex::Dump(Stream &s) {
   s.Format("Manual DWARF index for ({0}) '{1:F}':",
            m_module.GetArchitecture().GetArchitectureName(),
@@ -20,19 +20,38 @@ using namespace lldb_private;
 void NameToDIE::Finalize() {
   m_map.Sort();
   m_map.SizeToFit();
+  m_corpus.reset();
 }
 
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
   m_map.Append(name, die_ref);
+  m_corpus.reset();
 }
 
 size_t NameToDIE::Find(ConstString name, DIEArray &info_array) const {
   return m_map.GetValues(name, info_array);
 }
 
+void NameToDIE::Find(llvm::ArrayRef<ConstString> names,
+                     std::vector<DIEArray> &info_arrays) const {
+  m_map.GetValues(names, info_arrays);
+}
+
 size_t NameToDIE::Find(const RegularExpression &regex,
                        DIEArray &info_array) const {
-  return m_map.GetValues(regex, info_array);
+  if (!m_corpus) {
+    m_corpus.reset(new NameCorpus());
+    const uint32_t size = m_map.GetSize();
+    for (uint32_t i = 0; i < size; ++i)
+      m_corpus->Append(m_map.GetCStringAtIndexUnchecked(i), i);
+    m_corpus->Finalize();
+  }
+
+  std::vector<uint32_t> indexes;
+  m_corpus->FindValues(regex, indexes);
+  for (uint32_t idx : indexes)
+    info_array.push_back(m_map.GetValueRefAtIndexUnchecked(idx));
+  return indexes.size();
 }
 
 size_t NameToDIE::FindAllEntriesForUnit(const DWARFUnit &unit,
@@ -70,6 +89,7 @@ void NameToDIE::ForEach(
 }
 
 void NameToDIE::Append(const NameToDIE &other) {
+  m_corpus.reset();
   const uint32_t size = other.m_map.GetSize();
   for (uint32_t i = 0; i < size; ++i) {
     m_map.Append(other.m_map.GetCStringAtIndexUnchecked(i),
@@ -10,8 +10,10 @@
 #define SymbolFileDWARF_NameToDIE_h_
 
 #include <functional>
+#include <memory>
 
 #include "DIERef.h"
+#include "lldb/Core/NameCorpus.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/lldb-defines.h"
@@ -35,6 +37,11 @@ public:
   size_t Find(lldb_private::ConstString name,
               DIEArray &info_array) const;
 
+  /// Finds the DIEs of several names at once, appending those of names[i] to
+  /// info_arrays[i].
+  void Find(llvm::ArrayRef<lldb_private::ConstString> names,
+            std::vector<DIEArray> &info_arrays) const;
+
   size_t Find(const lldb_private::RegularExpression &regex,
               DIEArray &info_array) const;
 
@@ -48,6 +55,10 @@ public:
 
 protected:
   lldb_private::UniqueCStringMap<DIERef> m_map;
+  /// The names of m_map with the indexes of their entries, built by the
+  /// first search by regular expression. Like the rest of the DWARF index,
+  /// it is only searched with the module's mutex held.
+  mutable std::unique_ptr<lldb_private::NameCorpus> m_corpus;
 };
 
 #endif // SymbolFileDWARF_NameToDIE_h_
@@ -9,6 +9,7 @@
 #include "SymbolFileDWARF.h"
 
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Threading.h"
 
@@ -20,6 +21,8 @@
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/Value.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Scalar.h"
 #include "lldb/Utility/StreamString.h"
@@ -30,6 +33,7 @@
 
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Host/TaskPool.h"
 
 #include "lldb/Interpreter/OptionValueFileSpecList.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
@@ -50,6 +54,7 @@
 #include "lldb/Symbol/VariableList.h"
 
 #include "lldb/Target/Language.h"
+#include "lldb/Target/ModuleCache.h"
 #include "lldb/Target/Target.h"
 
 #include "AppleDWARFIndex.h"
@@ -74,10 +79,12 @@
 
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <numeric>
 
 #include <ctype.h>
 #include <string.h>
@@ -909,6 +916,250 @@ SymbolFileDWARF::GetTypeUnitSupportFiles(DWARFTypeUnit &tu) {
   return list;
 }
 
+namespace {
+/// Where the file to compile unit index of a symbol file is kept in the
+/// symbol cache, and the contents of the file it was built from, which a
+/// cache entry must match.
+struct FileIndexCacheKey {
+  FileSpec cache_dir_spec;
+  UUID uuid;
+  std::string entry_name;
+  UUID objfile_uuid;
+  uint64_t file_size;
+};
+} // namespace
+
+// Identifies symbol cache entries written by
+// SymbolFileDWARF::WriteFileToCompileUnitIndex.
+static const uint32_t g_file_index_cache_magic = 0x31554344; // "DCU1"
+
+static bool GetFileIndexCacheKey(ObjectFile &objfile,
+                                 FileIndexCacheKey &key) {
+  ModuleSP module_sp = objfile.GetModule();
+  if (!module_sp || objfile.IsInMemory() || objfile.GetFileOffset() != 0)
+    return false;
+
+  key.cache_dir_spec =
+      ModuleList::GetGlobalModuleListProperties().GetSymbolCachePath();
+  key.uuid = module_sp->GetUUID();
+  const FileSpec &file_spec = objfile.GetFileSpec();
+  if (!key.cache_dir_spec || !key.uuid.IsValid() || !file_spec)
+    return false;
+  key.entry_name = (file_spec.GetFilename().GetStringRef() + ".cufiles").str();
+
+  // The debug info may live in a separate file, which is identified by its
+  // own build ID and size.
+  key.objfile_uuid = objfile.GetUUID();
+  key.file_size = FileSystem::Instance().GetByteSize(file_spec);
+  return true;
+}
+
+bool SymbolFileDWARF::ReadFileToCompileUnitIndex(uint32_t num_cus) {
+  // Object files inside a debug map have no UUID of their own.
+  if (m_debug_map_symfile)
+    return false;
+  FileIndexCacheKey key;
+  if (!GetFileIndexCacheKey(*m_objfile_sp, key))
+    return false;
+
+  const FileSpec entry_spec =
+      ModuleCache::GetEntry(key.cache_dir_spec, key.uuid, key.entry_name);
+  if (!entry_spec)
+    return false;
+  DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(entry_spec);
+  if (!data_sp)
+    return false;
+
+  DataExtractor data(data_sp, endian::InlHostByteOrder(), 4);
+  lldb::offset_t offset = 0;
+  if (data.GetU32(&offset) != g_file_index_cache_magic ||
+      data.GetU64(&offset) != key.file_size)
+    return false;
+  llvm::ArrayRef<uint8_t> objfile_uuid = key.objfile_uuid.GetBytes();
+  const uint8_t objfile_uuid_size = data.GetU8(&offset);
+  const void *objfile_uuid_bytes = data.GetData(&offset, objfile_uuid_size);
+  if (objfile_uuid_size != objfile_uuid.size() ||
+      (objfile_uuid_size &&
+       (!objfile_uuid_bytes || memcmp(objfile_uuid_bytes, objfile_uuid.data(),
+                                      objfile_uuid_size) != 0)))
+    return false;
+  if (data.GetU32(&offset) != num_cus)
+    return false;
+
+  auto read_cu_indexes = [&](std::vector<uint32_t> &cu_indexes) {
+    const uint32_t count = data.GetU32(&offset);
+    if (!data.ValidOffsetForDataOfSize(offset, count * 4ull))
+      return false;
+    cu_indexes.resize(count);
+    for (uint32_t &cu_idx : cu_indexes) {
+      cu_idx = data.GetU32(&offset);
+      if (cu_idx >= num_cus)
+        return false;
+    }
+    return true;
+  };
+
+  std::vector<uint32_t> cus_without_file_index;
+  if (!read_cu_indexes(cus_without_file_index))
+    return false;
+  llvm::DenseMap<ConstString, std::vector<uint32_t>> file_to_cu_index;
+  const uint32_t num_files = data.GetU32(&offset);
+  for (uint32_t i = 0; i < num_files; ++i) {
+    const char *file = data.GetCStr(&offset);
+    if (!file || !read_cu_indexes(file_to_cu_index[ConstString(file)]))
+      return false;
+  }
+
+  m_cus_without_file_index = std::move(cus_without_file_index);
+  m_file_to_cu_index = std::move(file_to_cu_index);
+  return true;
+}
+
+void SymbolFileDWARF::WriteFileToCompileUnitIndex(uint32_t num_cus) {
+  if (m_debug_map_symfile)
+    return;
+  FileIndexCacheKey key;
+  if (!GetFileIndexCacheKey(*m_objfile_sp, key))
+    return;
+
+  StreamString strm(Stream::eBinary, 4, endian::InlHostByteOrder());
+  strm.PutHex32(g_file_index_cache_magic);
+  strm.PutHex64(key.file_size);
+  llvm::ArrayRef<uint8_t> objfile_uuid = key.objfile_uuid.GetBytes();
+  strm.PutHex8(objfile_uuid.size());
+  strm.Write(objfile_uuid.data(), objfile_uuid.size());
+  strm.PutHex32(num_cus);
+
+  auto write_cu_indexes = [&strm](const std::vector<uint32_t> &cu_indexes) {
+    strm.PutHex32(cu_indexes.size());
+    for (uint32_t cu_idx : cu_indexes)
+      strm.PutHex32(cu_idx);
+  };
+  write_cu_indexes(m_cus_without_file_index);
+  strm.PutHex32(m_file_to_cu_index.size());
+  for (const auto &entry : m_file_to_cu_index) {
+    strm.PutCString(entry.first.GetStringRef());
+    write_cu_indexes(entry.second);
+  }
+
+  Status error = ModuleCache::PutEntry(
+      key.cache_dir_spec, key.uuid, key.entry_name,
+      llvm::ArrayRef<uint8_t>(
+          reinterpret_cast<const uint8_t *>(strm.GetData()), strm.GetSize()));
+  if (error.Fail()) {
+    Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+    LLDB_LOGF(log, "Failed to cache the compile unit file index of %s: %s",
+              m_objfile_sp->GetFileSpec().GetPath().c_str(),
+              error.AsCString());
+    return;
+  }
+
+  if (uint64_t max_size =
+          ModuleList::GetGlobalModuleListProperties().GetSymbolCacheMaxSize())
+    ModuleCache::PruneIfNeeded(key.cache_dir_spec, max_size * 1024 * 1024,
+                               strm.GetSize());
+}
+
+void SymbolFileDWARF::BuildFileToCompileUnitIndex() {
+  if (m_file_to_cu_index_built)
+    return;
+  m_file_to_cu_index_built = true;
+
+  DWARFDebugInfo *info = DebugInfo();
+  if (!info)
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s this = %p", LLVM_PRETTY_FUNCTION,
+                     static_cast<void *>(this));
+
+  const uint32_t num_cus = GetNumCompileUnits();
+  if (ReadFileToCompileUnitIndex(num_cus))
+    return;
+
+  std::vector<DWARFCompileUnit *> dwarf_cus(num_cus);
+  for (uint32_t cu_idx = 0; cu_idx < num_cus; ++cu_idx) {
+    if (llvm::Optional<uint32_t> dwarf_idx = GetDWARFUnitIndex(cu_idx))
+      dwarf_cus[cu_idx] = llvm::dyn_cast_or_null<DWARFCompileUnit>(
+          info->GetUnitAtIndex(*dwarf_idx));
+  }
+
+  // Only the header of each line table is read, which holds its file table.
+  // The line tables themselves are left alone until a unit is searched.
+  llvm::DWARFDataExtractor data = m_context.getOrLoadLineData().GetAsLLVM();
+  llvm::DWARFContext &ctx = m_context.GetAsLLVM();
+  std::vector<std::vector<ConstString>> cu_files(num_cus);
+  std::vector<uint8_t> cu_failed(num_cus, false);
+  auto parse_fn = [&](size_t cu_idx) {
+    DWARFCompileUnit *dwarf_cu = dwarf_cus[cu_idx];
+    if (!dwarf_cu)
+      return;
+    const DWARFBaseDIE cu_die = dwarf_cu->GetUnitDIEOnly();
+    if (!cu_die)
+      return;
+
+    std::vector<ConstString> &files = cu_files[cu_idx];
+    // Windows paths match regardless of case, so the index is keyed on the
+    // lower case names. The units it returns are matched exactly later.
+    auto add_file = [&files, dwarf_cu](const char *path) {
+      if (path && path[0])
+        files.push_back(ConstString(
+            llvm::sys::path::filename(path, dwarf_cu->GetPathStyle())
+                .lower()));
+    };
+    // The unit's own file matches even when it has no line table.
+    add_file(cu_die.GetName());
+
+    uint64_t line_offset =
+        cu_die.GetAttributeValueAsUnsigned(DW_AT_stmt_list, DW_INVALID_OFFSET);
+    if (line_offset != DW_INVALID_OFFSET) {
+      llvm::DWARFDebugLine::Prologue prologue;
+      if (llvm::Error error = prologue.parse(data, &line_offset, ctx)) {
+        LLDB_LOG_ERROR(LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO),
+                       std::move(error),
+                       "SymbolFileDWARF::BuildFileToCompileUnitIndex failed "
+                       "to parse the line table prologue");
+        cu_failed[cu_idx] = true;
+        return;
+      }
+      for (const llvm::DWARFDebugLine::FileNameEntry &entry :
+           prologue.FileNames)
+        add_file(llvm::dwarf::toString(entry.Name, nullptr));
+    }
+
+    llvm::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+  };
+  TaskMapOverInt(0, num_cus, parse_fn);
+
+  for (uint32_t cu_idx = 0; cu_idx < num_cus; ++cu_idx) {
+    if (cu_failed[cu_idx])
+      m_cus_without_file_index.push_back(cu_idx);
+    for (ConstString file : cu_files[cu_idx])
+      m_file_to_cu_index[file].push_back(cu_idx);
+  }
+  WriteFileToCompileUnitIndex(num_cus);
+}
+
+bool SymbolFileDWARF::FindCompileUnitsForFile(
+    ConstString filename, std::vector<uint32_t> &cu_indexes) {
+  if (!filename)
+    return false;
+
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  BuildFileToCompileUnitIndex();
+
+  cu_indexes = m_cus_without_file_index;
+  auto pos =
+      m_file_to_cu_index.find(ConstString(filename.GetStringRef().lower()));
+  if (pos != m_file_to_cu_index.end()) {
+    cu_indexes.insert(cu_indexes.end(), pos->second.begin(),
+                      pos->second.end());
+    std::sort(cu_indexes.begin(), cu_indexes.end());
+  }
+  return true;
+}
+
 bool SymbolFileDWARF::ParseIsOptimized(CompileUnit &comp_unit) {
   std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   DWARFUnit *dwarf_cu = GetDWARFCompileUnit(&comp_unit);
@@ -1861,8 +2112,13 @@ uint32_t SymbolFileDWARF::ResolveSymbolContext(const FileSpec &file_spec,
   std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   const uint32_t prev_size = sc_list.GetSize();
   if (resolve_scope & eSymbolContextCompUnit) {
-    for (uint32_t cu_idx = 0, num_cus = GetNumCompileUnits(); cu_idx < num_cus;
-         ++cu_idx) {
+    // Only look at the units whose line tables refer to the file.
+    std::vector<uint32_t> cu_indexes;
+    if (!FindCompileUnitsForFile(file_spec.GetFilename(), cu_indexes)) {
+      cu_indexes.resize(GetNumCompileUnits());
+      std::iota(cu_indexes.begin(), cu_indexes.end(), 0);
+    }
+    for (uint32_t cu_idx : cu_indexes) {
       CompileUnit *dc_cu = ParseCompileUnitAtIndex(cu_idx).get();
       if (!dc_cu)
         continue;
@@ -1962,10 +2218,61 @@ uint32_t SymbolFileDWARF::ResolveSymbolContext(const FileSpec &file_spec,
 }
 
 void SymbolFileDWARF::PreloadSymbols() {
+  // Read and decompress the sections before taking the module lock. Each
+  // section is published once by DWARFContext, so this needs no lock, and
+  // the module isn't blocked for the whole fan-out.
+  m_context.PreloadSections();
+
   std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
   m_index->Preload();
 }
 
+void SymbolFileDWARF::PreloadNames(llvm::ArrayRef<ConstString> names) {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  DWARFDebugInfo *debug_info = DebugInfo();
+  if (!debug_info || !m_index || names.empty())
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "SymbolFileDWARF::PreloadNames (%zu names)",
+                     names.size());
+
+  std::vector<ConstString> sorted_names(names.begin(), names.end());
+  llvm::sort(sorted_names.begin(), sorted_names.end());
+  sorted_names.erase(std::unique(sorted_names.begin(), sorted_names.end()),
+                     sorted_names.end());
+
+  std::vector<DIEArray> dies;
+  m_index->GetDIEsForNames(sorted_names, dies);
+
+  // Collect the units holding any of the names, so that each of them is
+  // parsed once no matter how many of the names it defines.
+  llvm::SetVector<DWARFUnit *> units;
+  for (const DIEArray &name_dies : dies) {
+    for (const DIERef &die_ref : name_dies) {
+      DWARFDebugInfo *unit_debug_info = debug_info;
+      if (die_ref.dwo_num()) {
+        DWARFUnit *skeleton = debug_info->GetUnitAtIndex(*die_ref.dwo_num());
+        SymbolFileDWARFDwo *dwo = skeleton ? skeleton->GetDwoSymbolFile()
+                                           : nullptr;
+        unit_debug_info = dwo ? dwo->DebugInfo() : nullptr;
+      }
+      if (!unit_debug_info)
+        continue;
+      if (DWARFUnit *unit = unit_debug_info->GetUnit(die_ref))
+        units.insert(unit);
+    }
+  }
+
+  if (units.empty())
+    return;
+
+  llvm::ArrayRef<DWARFUnit *> units_to_extract = units.getArrayRef();
+  TaskMapOverInt(0, units_to_extract.size(), [&units_to_extract](size_t idx) {
+    units_to_extract[idx]->ExtractDIEsIfNeeded();
+  });
+}
+
 std::recursive_mutex &SymbolFileDWARF::GetModuleMutex() const {
   lldb::ModuleSP module_sp(m_debug_map_module_wp.lock());
   if (module_sp)
@@ -157,6 +157,9 @@ public:
                        lldb::SymbolContextItem resolve_scope,
                        lldb_private::SymbolContextList &sc_list) override;
 
+  bool FindCompileUnitsForFile(lldb_private::ConstString filename,
+                               std::vector<uint32_t> &cu_indexes) override;
+
   uint32_t
   FindGlobalVariables(lldb_private::ConstString name,
                       const lldb_private::CompilerDeclContext *parent_decl_ctx,
@@ -205,6 +208,8 @@ public:
 
   void PreloadSymbols() override;
 
+  void PreloadNames(llvm::ArrayRef<lldb_private::ConstString> names) override;
+
   std::recursive_mutex &GetModuleMutex() const override;
 
   // PluginInterface protocol
@@ -223,6 +228,8 @@ public:
 
   const DWARFDebugInfo *DebugInfo() const;
 
+  lldb_private::DWARFIndex *GetIndex() { return m_index.get(); }
+
   DWARFDebugRanges *GetDebugRanges();
   DWARFDebugRngLists *GetDebugRngLists();
 
@@ -454,6 +461,17 @@ protected:
 
   const lldb_private::FileSpecList &GetTypeUnitSupportFiles(DWARFTypeUnit &tu);
 
+  /// Build m_file_to_cu_index from the file tables in the line table
+  /// headers of all compile units, or read it from the symbol cache.
+  void BuildFileToCompileUnitIndex();
+
+  /// Restore m_file_to_cu_index from the symbol cache, if it holds an entry
+  /// for the contents of this file with \a num_cus compile units.
+  bool ReadFileToCompileUnitIndex(uint32_t num_cus);
+
+  /// Store m_file_to_cu_index in the symbol cache, if one is configured.
+  void WriteFileToCompileUnitIndex(uint32_t num_cus);
+
   lldb::ModuleWP m_debug_map_module_wp;
   SymbolFileDWARFDebugMap *m_debug_map_symfile;
 
@@ -493,6 +511,14 @@ protected:
   llvm::DenseMap<dw_offset_t, lldb_private::FileSpecList>
       m_type_unit_support_files;
   std::vector<uint32_t> m_lldb_cu_to_dwarf_unit;
+  /// Maps the lower case base name of every file in a line table to the
+  /// indexes of the compile units that refer to it.
+  llvm::DenseMap<lldb_private::ConstString, std::vector<uint32_t>>
+      m_file_to_cu_index;
+  /// Compile units whose line table header could not be read. These have to
+  /// be searched for any file.
+  std::vector<uint32_t> m_cus_without_file_index;
+  bool m_file_to_cu_index_built = false;
 };
 
 #endif // SymbolFileDWARF_SymbolFileDWARF_h_
@@ -1098,6 +1098,14 @@ void SymbolFileDWARFDebugMap::GetTypes(SymbolContextScope *sc_scope,
   }
 }
 
+void SymbolFileDWARFDebugMap::PreloadNames(llvm::ArrayRef<ConstString> names) {
+  std::lock_guard<std::recursive_mutex> guard(GetModuleMutex());
+  ForEachSymbolFile([&](SymbolFileDWARF *oso_dwarf) -> bool {
+    oso_dwarf->PreloadNames(names);
+    return false;
+  });
+}
+
 std::vector<lldb_private::CallEdge>
 SymbolFileDWARFDebugMap::ParseCallEdgesInFunction(UserID func_id) {
   uint32_t oso_idx = GetOSOIndexFromUserID(func_id.GetID());
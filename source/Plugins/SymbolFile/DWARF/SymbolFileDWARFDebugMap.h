@@ -120,6 +120,9 @@ public:
   void GetTypes(lldb_private::SymbolContextScope *sc_scope,
                 lldb::TypeClass type_mask,
                 lldb_private::TypeList &type_list) override;
+
+  void PreloadNames(llvm::ArrayRef<lldb_private::ConstString> names) override;
+
   std::vector<lldb_private::CallEdge>
   ParseCallEdgesInFunction(lldb_private::UserID func_id) override;
 
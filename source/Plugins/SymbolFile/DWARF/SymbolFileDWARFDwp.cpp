@@ -9,130 +9,322 @@
 #include "SymbolFileDWARFDwp.h"
 
 #include "lldb/Core/Section.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Stream.h"
 
-#include "SymbolFileDWARFDwoDwp.h"
-
-static llvm::DWARFSectionKind
-lldbSectTypeToLlvmSectionKind(lldb::SectionType type) {
-  switch (type) {
-  case lldb::eSectionTypeDWARFDebugInfo:
-    return llvm::DW_SECT_INFO;
-  // case lldb::eSectionTypeDWARFDebugTypes:
-  //   return llvm::DW_SECT_TYPES;
-  case lldb::eSectionTypeDWARFDebugAbbrev:
-    return llvm::DW_SECT_ABBREV;
-  case lldb::eSectionTypeDWARFDebugLine:
-    return llvm::DW_SECT_LINE;
-  case lldb::eSectionTypeDWARFDebugLoc:
-    return llvm::DW_SECT_LOC; 
-  case lldb::eSectionTypeDWARFDebugStrOffsets:
-    return llvm::DW_SECT_STR_OFFSETS;
-  // case lldb::eSectionTypeDWARFDebugMacinfo:
-  //   return llvm::DW_SECT_MACINFO;
-  case lldb::eSectionTypeDWARFDebugMacro:
-    return llvm::DW_SECT_MACRO;
-  default:
-    // Note: 0 is an invalid dwarf section kind.
-    return llvm::DWARFSectionKind(0);
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/BinaryFormat/ELF.h"
+
+#include "LogChannelDWARF.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+/// A section of a unit in a DWARF package, and the column of the package's
+/// index that holds the unit's contribution to it.
+struct DWPUnitSectionKind {
+  const char *name;
+  SectionType type;
+  llvm::DWARFSectionKind kind;
+};
+
+/// The sections of a single unit of a DWARF package. Each section's data is
+/// read from the package separately, so the sections have no meaningful file
+/// offsets, and this object file has no data of its own.
+class ObjectFileDWPUnit : public ObjectFile {
+public:
+  struct UnitSection {
+    ConstString name;
+    SectionType type;
+    DataBufferSP data_sp;
+  };
+
+  ObjectFileDWPUnit(const ModuleSP &module_sp, const FileSpec &file,
+                    ByteOrder byte_order, uint32_t addr_byte_size,
+                    std::vector<UnitSection> sections)
+      : ObjectFile(module_sp, &file, 0, 0, DataBufferSP(), 0),
+        m_byte_order(byte_order), m_addr_byte_size(addr_byte_size),
+        m_unit_sections(std::move(sections)) {}
+
+  ConstString GetPluginName() override {
+    static ConstString g_name("dwp-unit");
+    return g_name;
   }
-}
+
+  uint32_t GetPluginVersion() override { return 1; }
+
+  bool ParseHeader() override { return true; }
+
+  ByteOrder GetByteOrder() const override { return m_byte_order; }
+
+  bool IsExecutable() const override { return false; }
+
+  uint32_t GetAddressByteSize() const override { return m_addr_byte_size; }
+
+  Symtab *GetSymtab() override { return nullptr; }
+
+  bool IsStripped() override { return false; }
+
+  void CreateSections(SectionList &unified_section_list) override {
+    if (m_sections_up)
+      return;
+    m_sections_up = std::make_unique<SectionList>();
+    for (const auto &entry : llvm::enumerate(m_unit_sections)) {
+      const UnitSection &unit_section = entry.value();
+      m_sections_up->AddSection(std::make_shared<Section>(
+          GetModule(), this, entry.index() + 1, unit_section.name,
+          unit_section.type, 0, 0, 0, unit_section.data_sp->GetByteSize(), 0,
+          0));
+    }
+  }
+
+  void Dump(Stream *s) override {
+    s->Printf("%p: ", static_cast<void *>(this));
+    s->Indent();
+    s->PutCString("ObjectFileDWPUnit");
+    s->EOL();
+    if (SectionList *sections = GetSectionList(false))
+      sections->Dump(s, nullptr, true, UINT32_MAX);
+  }
+
+  ArchSpec GetArchitecture() override {
+    if (ModuleSP module_sp = GetModule())
+      return module_sp->GetArchitecture();
+    return ArchSpec();
+  }
+
+  UUID GetUUID() override { return UUID(); }
+
+  uint32_t GetDependentModules(FileSpecList &files) override { return 0; }
+
+  Type CalculateType() override { return eTypeDebugInfo; }
+
+  Strata CalculateStrata() override { return eStrataUser; }
+
+  size_t ReadSectionData(Section *section,
+                         DataExtractor &section_data) override {
+    const UnitSection *unit_section = GetUnitSection(section);
+    if (!unit_section)
+      return 0;
+    section_data.SetByteOrder(m_byte_order);
+    section_data.SetAddressByteSize(m_addr_byte_size);
+    return section_data.SetData(unit_section->data_sp);
+  }
+
+  size_t ReadSectionData(Section *section, lldb::offset_t section_offset,
+                         void *dst, size_t dst_len) override {
+    const UnitSection *unit_section = GetUnitSection(section);
+    if (!unit_section || section_offset >= unit_section->data_sp->GetByteSize())
+      return 0;
+    dst_len = std::min<size_t>(
+        dst_len, unit_section->data_sp->GetByteSize() - section_offset);
+    memcpy(dst, unit_section->data_sp->GetBytes() + section_offset, dst_len);
+    return dst_len;
+  }
+
+private:
+  const UnitSection *GetUnitSection(Section *section) const {
+    if (!section || section->GetObjectFile() != this ||
+        section->GetID() == 0 || section->GetID() > m_unit_sections.size())
+      return nullptr;
+    return &m_unit_sections[section->GetID() - 1];
+  }
+
+  ByteOrder m_byte_order;
+  uint32_t m_addr_byte_size;
+  std::vector<UnitSection> m_unit_sections;
+};
+} // namespace
+
+static const DWPUnitSectionKind g_dwp_unit_sections[] = {
+    {".debug_info.dwo", eSectionTypeDWARFDebugInfoDwo, llvm::DW_SECT_INFO},
+    {".debug_abbrev.dwo", eSectionTypeDWARFDebugAbbrevDwo,
+     llvm::DW_SECT_ABBREV},
+    {".debug_line.dwo", eSectionTypeDWARFDebugLine, llvm::DW_SECT_LINE},
+    {".debug_loc.dwo", eSectionTypeDWARFDebugLoc, llvm::DW_SECT_LOC},
+    {".debug_str_offsets.dwo", eSectionTypeDWARFDebugStrOffsetsDwo,
+     llvm::DW_SECT_STR_OFFSETS},
+    {".debug_macro.dwo", eSectionTypeDWARFDebugMacro, llvm::DW_SECT_MACRO},
+};
 
 std::unique_ptr<SymbolFileDWARFDwp>
 SymbolFileDWARFDwp::Create(lldb::ModuleSP module_sp,
                            const lldb_private::FileSpec &file_spec) {
-  const lldb::offset_t file_offset = 0;
-  lldb::DataBufferSP file_data_sp;
-  lldb::offset_t file_data_offset = 0;
-  lldb::ObjectFileSP obj_file = lldb_private::ObjectFile::FindPlugin(
-      module_sp, &file_spec, file_offset,
-      lldb_private::FileSystem::Instance().GetByteSize(file_spec), file_data_sp,
-      file_data_offset);
-  if (obj_file == nullptr)
-    return nullptr;
-
   std::unique_ptr<SymbolFileDWARFDwp> dwp_symfile(
-      new SymbolFileDWARFDwp(module_sp, obj_file));
+      new SymbolFileDWARFDwp(module_sp, file_spec));
+  if (!dwp_symfile->ParseSectionHeaders())
+    return nullptr;
 
-  lldb_private::DWARFDataExtractor debug_cu_index;
-  if (!dwp_symfile->LoadRawSectionData(lldb::eSectionTypeDWARFDebugCuIndex,
-                                       debug_cu_index))
+  DataBufferSP debug_cu_index_sp = dwp_symfile->ReadSection(".debug_cu_index");
+  if (!debug_cu_index_sp)
     return nullptr;
 
   llvm::DataExtractor llvm_debug_cu_index(
-      llvm::StringRef(debug_cu_index.PeekCStr(0), debug_cu_index.GetByteSize()),
-      debug_cu_index.GetByteOrder() == lldb::eByteOrderLittle,
-      debug_cu_index.GetAddressByteSize());
+      llvm::StringRef(
+          reinterpret_cast<const char *>(debug_cu_index_sp->GetBytes()),
+          debug_cu_index_sp->GetByteSize()),
+      dwp_symfile->m_byte_order == lldb::eByteOrderLittle,
+      dwp_symfile->m_addr_byte_size);
   if (!dwp_symfile->m_debug_cu_index.parse(llvm_debug_cu_index))
     return nullptr;
-  dwp_symfile->InitDebugCUIndexMap();
-  return dwp_symfile;
-}
 
-void SymbolFileDWARFDwp::InitDebugCUIndexMap() {
-  m_debug_cu_index_map.clear();
-  for (const auto &entry : m_debug_cu_index.getRows())
-    m_debug_cu_index_map.emplace(entry.getSignature(), &entry);
+  for (const auto &entry : dwp_symfile->m_debug_cu_index.getRows())
+    dwp_symfile->m_debug_cu_index_map.emplace(entry.getSignature(), &entry);
+  return dwp_symfile;
 }
 
 SymbolFileDWARFDwp::SymbolFileDWARFDwp(lldb::ModuleSP module_sp,
-                                       lldb::ObjectFileSP obj_file)
-    : m_obj_file(std::move(obj_file)), m_debug_cu_index(llvm::DW_SECT_INFO) 
-{}
+                                       const lldb_private::FileSpec &file_spec)
+    : m_module_wp(module_sp), m_file_spec(file_spec),
+      m_debug_cu_index(llvm::DW_SECT_INFO) {}
 
-std::unique_ptr<SymbolFileDWARFDwo>
-SymbolFileDWARFDwp::GetSymbolFileForDwoId(DWARFCompileUnit &dwarf_cu,
-                                          uint64_t dwo_id) {
-  return std::unique_ptr<SymbolFileDWARFDwo>(
-      new SymbolFileDWARFDwoDwp(this, m_obj_file, dwarf_cu, dwo_id));
-}
+bool SymbolFileDWARFDwp::ParseSectionHeaders() {
+  using namespace llvm::ELF;
 
-bool SymbolFileDWARFDwp::LoadSectionData(
-    uint64_t dwo_id, lldb::SectionType sect_type,
-    lldb_private::DWARFDataExtractor &data) {
-  lldb_private::DWARFDataExtractor section_data;
-  if (!LoadRawSectionData(sect_type, section_data))
+  DataBufferSP header_sp = ReadFileData(0, sizeof(Elf64_Ehdr));
+  if (!header_sp || header_sp->GetByteSize() < sizeof(Elf32_Ehdr))
+    return false;
+  const uint8_t *ident = header_sp->GetBytes();
+  if (memcmp(ident, ElfMagic, strlen(ElfMagic)) != 0)
     return false;
 
-  auto it = m_debug_cu_index_map.find(dwo_id);
-  if (it == m_debug_cu_index_map.end())
+  if (ident[EI_CLASS] != ELFCLASS32 && ident[EI_CLASS] != ELFCLASS64)
+    return false;
+  const bool is_64 = ident[EI_CLASS] == ELFCLASS64;
+  if (header_sp->GetByteSize() <
+      (is_64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr)))
     return false;
+  m_addr_byte_size = is_64 ? 8 : 4;
+  if (ident[EI_DATA] == ELFDATA2LSB)
+    m_byte_order = eByteOrderLittle;
+  else if (ident[EI_DATA] == ELFDATA2MSB)
+    m_byte_order = eByteOrderBig;
+  else
+    return false;
+
+  // e_shoff, e_shentsize, e_shnum and e_shstrndx. The offset and the fields
+  // in the section headers are the size of an address.
+  DataExtractor header(header_sp, m_byte_order, m_addr_byte_size);
+  lldb::offset_t offset = is_64 ? offsetof(Elf64_Ehdr, e_shoff)
+                                : offsetof(Elf32_Ehdr, e_shoff);
+  const uint64_t shoff = header.GetAddress(&offset);
+  offset = is_64 ? offsetof(Elf64_Ehdr, e_shentsize)
+                 : offsetof(Elf32_Ehdr, e_shentsize);
+  const uint16_t shentsize = header.GetU16(&offset);
+  const uint16_t shnum = header.GetU16(&offset);
+  const uint16_t shstrndx = header.GetU16(&offset);
 
-  auto *offsets =
-      it->second->getOffset(lldbSectTypeToLlvmSectionKind(sect_type));
-  if (offsets) {
-    data.SetData(section_data, offsets->Offset, offsets->Length);
-  } else {
-    data.SetData(section_data, 0, section_data.GetByteSize());
+  // Package files have a handful of sections, so don't bother with extended
+  // section numbering.
+  if (shnum == 0 || shstrndx >= shnum ||
+      shentsize < (is_64 ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr)))
+    return false;
+
+  DataBufferSP shdrs_sp = ReadFileData(shoff, uint64_t(shnum) * shentsize);
+  if (!shdrs_sp)
+    return false;
+  DataExtractor shdrs(shdrs_sp, m_byte_order, m_addr_byte_size);
+
+  struct SectionHeader {
+    uint32_t name;
+    uint64_t flags;
+    SectionInfo info;
+  };
+  std::vector<SectionHeader> headers(shnum);
+  for (uint32_t i = 0; i < shnum; ++i) {
+    offset = i * shentsize;
+    SectionHeader &header = headers[i];
+    header.name = shdrs.GetU32(&offset);
+    shdrs.GetU32(&offset); // sh_type
+    header.flags = shdrs.GetAddress(&offset);
+    shdrs.GetAddress(&offset); // sh_addr
+    header.info.offset = shdrs.GetAddress(&offset);
+    header.info.size = shdrs.GetAddress(&offset);
+  }
+
+  const SectionInfo &shstrtab = headers[shstrndx].info;
+  DataBufferSP names_sp = ReadFileData(shstrtab.offset, shstrtab.size);
+  if (!names_sp)
+    return false;
+  DataExtractor names(names_sp, m_byte_order, m_addr_byte_size);
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
+  for (const SectionHeader &header : headers) {
+    lldb::offset_t name_offset = header.name;
+    const char *name = names.GetCStr(&name_offset);
+    if (!name || !*name)
+      continue;
+    // The index refers to offsets within the uncompressed sections, which
+    // would mean decompressing them whole, defeating the point of this class.
+    if ((header.flags & SHF_COMPRESSED) &&
+        llvm::StringRef(name).startswith(".debug_")) {
+      LLDB_LOG(log, "Not using compressed DWARF package {0}", m_file_spec);
+      return false;
+    }
+    m_sections[name] = header.info;
   }
   return true;
 }
 
-bool SymbolFileDWARFDwp::LoadRawSectionData(
-    lldb::SectionType sect_type, lldb_private::DWARFDataExtractor &data) {
-  std::lock_guard<std::mutex> lock(m_sections_mutex);
+DataBufferSP SymbolFileDWARFDwp::ReadFileData(lldb::offset_t offset,
+                                              lldb::offset_t size) {
+  // A size of zero would map the whole file.
+  if (size == 0)
+    return nullptr;
+  DataBufferSP data_sp =
+      FileSystem::Instance().CreateDataBuffer(m_file_spec, size, offset);
+  if (data_sp)
+    m_loaded_byte_size += data_sp->GetByteSize();
+  return data_sp;
+}
 
-  auto it = m_sections.find(sect_type);
-  if (it != m_sections.end()) {
-    if (it->second.GetByteSize() == 0)
-      return false;
+DataBufferSP SymbolFileDWARFDwp::ReadSection(llvm::StringRef name) {
+  auto pos = m_sections.find(name);
+  if (pos == m_sections.end())
+    return nullptr;
+  return ReadFileData(pos->second.offset, pos->second.size);
+}
 
-    data = it->second;
-    return true;
-  }
+lldb::ObjectFileSP SymbolFileDWARFDwp::GetObjectFileForDwoId(uint64_t dwo_id) {
+  auto it = m_debug_cu_index_map.find(dwo_id);
+  if (it == m_debug_cu_index_map.end())
+    return nullptr;
 
-  const lldb_private::SectionList *section_list =
-      m_obj_file->GetSectionList(false /* update_module_section_list */);
-  if (section_list) {
-    lldb::SectionSP section_sp(
-        section_list->FindSectionByType(sect_type, true));
-    if (section_sp) {
-      if (m_obj_file->ReadSectionData(section_sp.get(), data) != 0) {
-        m_sections[sect_type] = data;
-        return true;
-      }
-    }
+  std::vector<ObjectFileDWPUnit::UnitSection> sections;
+  for (const DWPUnitSectionKind &kind : g_dwp_unit_sections) {
+    const auto *contribution = it->second->getOffset(kind.kind);
+    auto pos = m_sections.find(kind.name);
+    if (!contribution || pos == m_sections.end())
+      continue;
+    const SectionInfo &info = pos->second;
+    if (uint64_t(contribution->Offset) + contribution->Length > info.size)
+      continue;
+    if (DataBufferSP data_sp = ReadFileData(
+            info.offset + contribution->Offset, contribution->Length))
+      sections.push_back({ConstString(kind.name), kind.type, data_sp});
   }
-  m_sections[sect_type].Clear();
-  return false;
+
+  // The strings are shared by all units, so they are read once.
+  llvm::call_once(m_debug_str_once_flag, [this] {
+    m_debug_str_sp = ReadSection(".debug_str.dwo");
+  });
+  if (m_debug_str_sp)
+    sections.push_back({ConstString(".debug_str.dwo"),
+                        eSectionTypeDWARFDebugStrDwo, m_debug_str_sp});
+
+  return std::make_shared<ObjectFileDWPUnit>(m_module_wp.lock(), m_file_spec,
+                                             m_byte_order, m_addr_byte_size,
+                                             std::move(sections));
+}
+
+std::unique_ptr<SymbolFileDWARFDwo>
+SymbolFileDWARFDwp::GetSymbolFileForDwoId(DWARFCompileUnit &dwarf_cu,
+                                          uint64_t dwo_id) {
+  lldb::ObjectFileSP obj_file = GetObjectFileForDwoId(dwo_id);
+  if (!obj_file)
+    return nullptr;
+  return std::make_unique<SymbolFileDWARFDwo>(obj_file, dwarf_cu);
 }
@@ -9,15 +9,26 @@
 #ifndef SymbolFileDWARFDwp_SymbolFileDWARFDwp_h_
 #define SymbolFileDWARFDwp_SymbolFileDWARFDwp_h_
 
+#include <atomic>
+#include <map>
 #include <memory>
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
+#include "llvm/Support/Threading.h"
 
 #include "lldb/Core/Module.h"
 
 #include "DWARFDataExtractor.h"
 #include "SymbolFileDWARFDwo.h"
 
+/// Reads the units of a DWARF package (.dwp) file on demand.
+///
+/// Package files can be many gigabytes, and only a few of their units tend to
+/// be needed, so the package is never mapped as a whole. Only the ELF section
+/// headers and the .debug_cu_index are read up front. Looking up a unit then
+/// reads just that unit's contributions to each indexed section, plus the
+/// shared .debug_str.dwo section, into an object file of its own.
 class SymbolFileDWARFDwp {
 public:
   static std::unique_ptr<SymbolFileDWARFDwp>
@@ -26,22 +37,41 @@ public:
   std::unique_ptr<SymbolFileDWARFDwo>
   GetSymbolFileForDwoId(DWARFCompileUnit &dwarf_cu, uint64_t dwo_id);
 
-  bool LoadSectionData(uint64_t dwo_id, lldb::SectionType sect_type,
-                       lldb_private::DWARFDataExtractor &data);
+  /// Get an object file containing the sections of the unit with the given
+  /// DWO ID.
+  ///
+  /// \return
+  ///     The object file, or nullptr if the package has no such unit.
+  lldb::ObjectFileSP GetObjectFileForDwoId(uint64_t dwo_id);
+
+  /// Get the number of bytes of the package file that have been read or
+  /// mapped so far.
+  uint64_t GetLoadedByteSize() const { return m_loaded_byte_size; }
 
 private:
-  explicit SymbolFileDWARFDwp(lldb::ModuleSP module_sp,
-                              lldb::ObjectFileSP obj_file);
+  struct SectionInfo {
+    lldb::offset_t offset;
+    lldb::offset_t size;
+  };
+
+  SymbolFileDWARFDwp(lldb::ModuleSP module_sp,
+                     const lldb_private::FileSpec &file_spec);
+
+  bool ParseSectionHeaders();
+
+  lldb::DataBufferSP ReadFileData(lldb::offset_t offset, lldb::offset_t size);
 
-  bool LoadRawSectionData(lldb::SectionType sect_type,
-                          lldb_private::DWARFDataExtractor &data);
-  
-  void InitDebugCUIndexMap();
+  lldb::DataBufferSP ReadSection(llvm::StringRef name);
 
-  lldb::ObjectFileSP m_obj_file;
+  lldb::ModuleWP m_module_wp;
+  lldb_private::FileSpec m_file_spec;
+  lldb::ByteOrder m_byte_order = lldb::eByteOrderInvalid;
+  uint32_t m_addr_byte_size = 0;
+  llvm::StringMap<SectionInfo> m_sections;
+  std::atomic<uint64_t> m_loaded_byte_size{0};
 
-  std::mutex m_sections_mutex;
-  std::map<lldb::SectionType, lldb_private::DWARFDataExtractor> m_sections;
+  llvm::once_flag m_debug_str_once_flag;
+  lldb::DataBufferSP m_debug_str_sp;
 
   llvm::DWARFUnitIndex m_debug_cu_index;
   std::map<uint64_t, const llvm::DWARFUnitIndex::Entry *> m_debug_cu_index_map;
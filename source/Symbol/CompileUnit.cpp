@@ -149,10 +149,12 @@ LineTable *CompileUnit::GetLineTable() {
 }
 
 void CompileUnit::SetLineTable(LineTable *line_table) {
-  if (line_table == nullptr)
+  if (line_table == nullptr) {
     m_flags.Clear(flagsParsedLineTable);
-  else
+  } else {
     m_flags.Set(flagsParsedLineTable);
+    line_table->Finalize();
+  }
   m_line_table_up.reset(line_table);
 }
 
@@ -12,14 +12,25 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Utility/Stream.h"
+#include "llvm/ADT/STLExtras.h"
 #include <algorithm>
+#include <tuple>
 
 using namespace lldb;
 using namespace lldb_private;
 
+// The flags of a packed entry, stored above its line number in
+// LineTable::m_lines.
+static const uint32_t g_line_mask = (1u << 27) - 1;
+static const uint32_t g_start_of_statement = 1u << 27;
+static const uint32_t g_start_of_basic_block = 1u << 28;
+static const uint32_t g_prologue_end = 1u << 29;
+static const uint32_t g_epilogue_begin = 1u << 30;
+static const uint32_t g_terminal_entry = 1u << 31;
+
 // LineTable constructor
 LineTable::LineTable(CompileUnit *comp_unit)
-    : m_comp_unit(comp_unit), m_entries() {}
+    : m_comp_unit(comp_unit), m_entries(), m_line_index_valid(false) {}
 
 // Destructor
 LineTable::~LineTable() {}
@@ -34,6 +45,7 @@ void LineTable::InsertLineEntry(lldb::addr_t file_addr, uint32_t line,
               is_start_of_basic_block, is_prologue_end, is_epilogue_begin,
               is_terminal_entry);
 
+  Unpack();
   entry_collection::iterator begin_pos = m_entries.begin();
   entry_collection::iterator end_pos = m_entries.end();
   LineTable::Entry::LessThanBinaryPredicate less_than_bp(this);
@@ -99,6 +111,8 @@ void LineTable::InsertSequence(LineSequence *sequence) {
     return;
   Entry &entry = seq->m_entries.front();
 
+  Unpack();
+
   // If the first entry address in this sequence is greater than or equal to
   // the address of the last item in our entry collection, just append.
   if (m_entries.empty() ||
@@ -156,10 +170,138 @@ operator()(const LineTable::Entry &a, const LineTable::Entry &b) const {
 #undef LT_COMPARE
 }
 
-uint32_t LineTable::GetSize() const { return m_entries.size(); }
+uint32_t LineTable::GetSize() const {
+  return m_entries.empty() ? m_lines.size() : m_entries.size();
+}
+
+void LineTable::Finalize() {
+  if (m_entries.empty())
+    return;
+
+  const size_t count = m_entries.size();
+  m_block_addrs.reserve((count + AddressBlockSize - 1) / AddressBlockSize);
+  m_addr_deltas.reserve(count);
+  m_lines.reserve(count);
+  m_columns.reserve(count);
+  m_file_idxs.reserve(count);
+  for (const Entry &entry : m_entries)
+    AppendPackedEntry(entry);
+  m_far_addrs.shrink_to_fit();
+
+  entry_collection().swap(m_entries);
+}
+
+void LineTable::Unpack() {
+  m_line_index.clear();
+  m_line_index_valid = false;
+  if (m_lines.empty())
+    return;
+
+  assert(m_entries.empty());
+  const uint32_t count = m_lines.size();
+  entry_collection entries;
+  entries.reserve(count);
+  for (uint32_t idx = 0; idx < count; ++idx)
+    entries.push_back(GetEntryAtIndex(idx));
+  m_entries.swap(entries);
+
+  m_block_addrs.clear();
+  m_addr_deltas.clear();
+  m_far_addrs.clear();
+  m_lines.clear();
+  m_columns.clear();
+  m_file_idxs.clear();
+}
+
+void LineTable::AppendPackedEntry(const Entry &entry) {
+  const uint32_t idx = m_lines.size();
+  if (idx % AddressBlockSize == 0)
+    m_block_addrs.push_back(entry.file_addr);
+
+  const lldb::addr_t block_addr = m_block_addrs.back();
+  if (entry.file_addr >= block_addr &&
+      entry.file_addr - block_addr < UINT16_MAX) {
+    m_addr_deltas.push_back(entry.file_addr - block_addr);
+  } else {
+    m_addr_deltas.push_back(UINT16_MAX);
+    m_far_addrs.emplace_back(idx, entry.file_addr);
+  }
+
+  uint32_t line_and_flags = entry.line;
+  if (entry.is_start_of_statement)
+    line_and_flags |= g_start_of_statement;
+  if (entry.is_start_of_basic_block)
+    line_and_flags |= g_start_of_basic_block;
+  if (entry.is_prologue_end)
+    line_and_flags |= g_prologue_end;
+  if (entry.is_epilogue_begin)
+    line_and_flags |= g_epilogue_begin;
+  if (entry.is_terminal_entry)
+    line_and_flags |= g_terminal_entry;
+  m_lines.push_back(line_and_flags);
+  m_columns.push_back(entry.column);
+  m_file_idxs.push_back(entry.file_idx);
+}
+
+LineTable::Entry LineTable::GetEntryAtIndex(uint32_t idx) const {
+  if (!m_entries.empty())
+    return m_entries[idx];
+
+  const uint32_t line_and_flags = m_lines[idx];
+  return Entry(GetFileAddressAtIndex(idx), line_and_flags & g_line_mask,
+               m_columns[idx], m_file_idxs[idx],
+               line_and_flags & g_start_of_statement,
+               line_and_flags & g_start_of_basic_block,
+               line_and_flags & g_prologue_end,
+               line_and_flags & g_epilogue_begin,
+               line_and_flags & g_terminal_entry);
+}
+
+lldb::addr_t LineTable::GetFileAddressAtIndex(uint32_t idx) const {
+  const uint16_t delta = m_addr_deltas[idx];
+  if (delta != UINT16_MAX)
+    return m_block_addrs[idx / AddressBlockSize] + delta;
+
+  auto pos = llvm::lower_bound(
+      m_far_addrs, idx,
+      [](const std::pair<uint32_t, lldb::addr_t> &far_addr, uint32_t idx) {
+        return far_addr.first < idx;
+      });
+  assert(pos != m_far_addrs.end() && pos->first == idx);
+  return pos->second;
+}
+
+uint32_t LineTable::GetLineAtIndex(uint32_t idx) const {
+  return m_lines[idx] & g_line_mask;
+}
+
+bool LineTable::IsTerminalEntryAtIndex(uint32_t idx) const {
+  return m_lines[idx] & g_terminal_entry;
+}
+
+uint32_t LineTable::LowerBoundForAddress(lldb::addr_t file_addr) const {
+  const uint32_t count = GetSize();
+
+  // Find the first block that starts at or after the address. The entry
+  // we're looking for is at most its first entry, and comes after the first
+  // entry of the block before it.
+  const uint32_t block =
+      llvm::lower_bound(m_block_addrs, file_addr) - m_block_addrs.begin();
+  uint32_t begin = block == 0 ? 0 : (block - 1) * AddressBlockSize + 1;
+  uint32_t end = std::min<uint32_t>(block * AddressBlockSize, count);
+  while (begin < end) {
+    const uint32_t mid = begin + (end - begin) / 2;
+    if (GetFileAddressAtIndex(mid) < file_addr)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return begin;
+}
 
 bool LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry &line_entry) {
-  if (idx < m_entries.size()) {
+  Finalize();
+  if (idx < GetSize()) {
     ConvertEntryAtIndexToLineEntry(idx, line_entry);
     return true;
   }
@@ -173,78 +315,67 @@ bool LineTable::FindLineEntryByAddress(const Address &so_addr,
   if (index_ptr != nullptr)
     *index_ptr = UINT32_MAX;
 
-  bool success = false;
-
-  if (so_addr.GetModule().get() == m_comp_unit->GetModule().get()) {
-    Entry search_entry;
-    search_entry.file_addr = so_addr.GetFileAddress();
-    if (search_entry.file_addr != LLDB_INVALID_ADDRESS) {
-      entry_collection::const_iterator begin_pos = m_entries.begin();
-      entry_collection::const_iterator end_pos = m_entries.end();
-      entry_collection::const_iterator pos = lower_bound(
-          begin_pos, end_pos, search_entry, Entry::EntryAddressLessThan);
-      if (pos != end_pos) {
-        if (pos != begin_pos) {
-          if (pos->file_addr != search_entry.file_addr)
-            --pos;
-          else if (pos->file_addr == search_entry.file_addr) {
-            // If this is a termination entry, it shouldn't match since entries
-            // with the "is_terminal_entry" member set to true are termination
-            // entries that define the range for the previous entry.
-            if (pos->is_terminal_entry) {
-              // The matching entry is a terminal entry, so we skip ahead to
-              // the next entry to see if there is another entry following this
-              // one whose section/offset matches.
-              ++pos;
-              if (pos != end_pos) {
-                if (pos->file_addr != search_entry.file_addr)
-                  pos = end_pos;
-              }
-            }
-
-            if (pos != end_pos) {
-              // While in the same section/offset backup to find the first line
-              // entry that matches the address in case there are multiple
-              while (pos != begin_pos) {
-                entry_collection::const_iterator prev_pos = pos - 1;
-                if (prev_pos->file_addr == search_entry.file_addr &&
-                    prev_pos->is_terminal_entry == false)
-                  --pos;
-                else
-                  break;
-              }
-            }
-          }
-        }
-        else
-        {
-          // There might be code in the containing objfile before the first
-          // line table entry.  Make sure that does not get considered part of
-          // the first line table entry.
-          if (pos->file_addr > so_addr.GetFileAddress())
-            return false;
-        }
-
-        // Make sure we have a valid match and that the match isn't a
-        // terminating entry for a previous line...
-        if (pos != end_pos && pos->is_terminal_entry == false) {
-          uint32_t match_idx = std::distance(begin_pos, pos);
-          success = ConvertEntryAtIndexToLineEntry(match_idx, line_entry);
-          if (index_ptr != nullptr && success)
-            *index_ptr = match_idx;
-        }
+  if (so_addr.GetModule().get() != m_comp_unit->GetModule().get())
+    return false;
+
+  const lldb::addr_t file_addr = so_addr.GetFileAddress();
+  if (file_addr == LLDB_INVALID_ADDRESS)
+    return false;
+
+  Finalize();
+  const uint32_t count = GetSize();
+  uint32_t idx = LowerBoundForAddress(file_addr);
+  if (idx == count)
+    return false;
+
+  if (idx != 0) {
+    if (GetFileAddressAtIndex(idx) != file_addr) {
+      --idx;
+    } else {
+      // If this is a termination entry, it shouldn't match since entries
+      // with the "is_terminal_entry" member set to true are termination
+      // entries that define the range for the previous entry.
+      if (IsTerminalEntryAtIndex(idx)) {
+        // The matching entry is a terminal entry, so we skip ahead to the
+        // next entry to see if there is another entry following this one
+        // whose section/offset matches.
+        ++idx;
+        if (idx != count && GetFileAddressAtIndex(idx) != file_addr)
+          idx = count;
+      }
+
+      // While in the same section/offset backup to find the first line
+      // entry that matches the address in case there are multiple
+      if (idx != count) {
+        while (idx != 0 && GetFileAddressAtIndex(idx - 1) == file_addr &&
+               !IsTerminalEntryAtIndex(idx - 1))
+          --idx;
       }
     }
+  } else if (GetFileAddressAtIndex(idx) > file_addr) {
+    // There might be code in the containing objfile before the first line
+    // table entry.  Make sure that does not get considered part of the first
+    // line table entry.
+    return false;
   }
-  return success;
+
+  // Make sure we have a valid match and that the match isn't a terminating
+  // entry for a previous line...
+  if (idx == count || IsTerminalEntryAtIndex(idx))
+    return false;
+  if (!ConvertEntryAtIndexToLineEntry(idx, line_entry))
+    return false;
+  if (index_ptr != nullptr)
+    *index_ptr = idx;
+  return true;
 }
 
 bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
                                                LineEntry &line_entry) {
-  if (idx >= m_entries.size())
+  if (idx >= GetSize())
     return false;
 
-  const Entry &entry = m_entries[idx];
+  const Entry entry = GetEntryAtIndex(idx);
   ModuleSP module_sp(m_comp_unit->GetModule());
   if (!module_sp)
     return false;
@@ -264,8 +395,8 @@ bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
   if (entry.is_terminal_entry)
     line_entry.range.GetBaseAddress().Slide(1);
 
-  if (!entry.is_terminal_entry && idx + 1 < m_entries.size())
-    line_entry.range.SetByteSize(m_entries[idx + 1].file_addr -
+  if (!entry.is_terminal_entry && idx + 1 < GetSize())
+    line_entry.range.SetByteSize(GetEntryAtIndex(idx + 1).file_addr -
                                  entry.file_addr);
   else
     line_entry.range.SetByteSize(0);
@@ -284,94 +415,104 @@ bool LineTable::ConvertEntryAtIndexToLineEntry(uint32_t idx,
   return true;
 }
 
-uint32_t LineTable::FindLineEntryIndexByFileIndex(
-    uint32_t start_idx, const std::vector<uint32_t> &file_indexes,
-    uint32_t line, bool exact, LineEntry *line_entry_ptr) {
-
-  const size_t count = m_entries.size();
-  std::vector<uint32_t>::const_iterator begin_pos = file_indexes.begin();
-  std::vector<uint32_t>::const_iterator end_pos = file_indexes.end();
-  size_t best_match = UINT32_MAX;
-
-  for (size_t idx = start_idx; idx < count; ++idx) {
-    // Skip line table rows that terminate the previous row (is_terminal_entry
-    // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
-      continue;
+const std::vector<uint32_t> &LineTable::GetLineIndex() {
+  Finalize();
+  if (m_line_index_valid.load(std::memory_order_acquire))
+    return m_line_index;
 
-    if (find(begin_pos, end_pos, m_entries[idx].file_idx) == end_pos)
-      continue;
-
-    // Exact match always wins.  Otherwise try to find the closest line > the
-    // desired line.
-    // FIXME: Maybe want to find the line closest before and the line closest
-    // after and
-    // if they're not in the same function, don't return a match.
-
-    if (m_entries[idx].line < line) {
-      continue;
-    } else if (m_entries[idx].line == line) {
-      if (line_entry_ptr)
-        ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
-      return idx;
-    } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
-        best_match = idx;
+  std::lock_guard<std::mutex> guard(m_line_index_mutex);
+  if (!m_line_index_valid.load(std::memory_order_relaxed)) {
+    const uint32_t count = GetSize();
+    std::vector<uint32_t> line_index;
+    for (uint32_t idx = 0; idx < count; ++idx) {
+      // Skip line table rows that terminate the previous row
+      if (!IsTerminalEntryAtIndex(idx))
+        line_index.push_back(idx);
     }
+    llvm::sort(line_index.begin(), line_index.end(),
+               [this](uint32_t lhs, uint32_t rhs) {
+                 return std::make_tuple(m_file_idxs[lhs], GetLineAtIndex(lhs),
+                                        lhs) <
+                        std::make_tuple(m_file_idxs[rhs], GetLineAtIndex(rhs),
+                                        rhs);
+               });
+    m_line_index = std::move(line_index);
+    m_line_index_valid.store(true, std::memory_order_release);
   }
+  return m_line_index;
+}
 
-  if (best_match != UINT32_MAX) {
-    if (line_entry_ptr)
-      ConvertEntryAtIndexToLineEntry(best_match, *line_entry_ptr);
-    return best_match;
+uint32_t LineTable::FindEntryIndexByFileIndex(uint32_t start_idx,
+                                              uint32_t file_idx, uint32_t line,
+                                              bool exact) {
+  const std::vector<uint32_t> &line_index = GetLineIndex();
+  auto key_less = [this](uint32_t idx,
+                         const std::pair<uint32_t, uint32_t> &key) {
+    return std::make_pair(uint32_t(m_file_idxs[idx]),
+                                              GetLineAtIndex(idx)) < key;
+  };
+  auto key_greater = [this](const std::pair<uint32_t, uint32_t> &key,
+                            uint32_t idx) {
+    return key < std::make_pair(uint32_t(m_file_idxs[idx]),
+                                                    GetLineAtIndex(idx));
+  };
+
+  // Exact match always wins.  Otherwise find the closest line > the desired
+  // line. Entries of the same line are sorted by index, so within each line
+  // the first entry at or after start_idx is a binary search away.
+  // FIXME: Maybe want to find the line closest before and the line closest
+  // after and if they're not in the same function, don't return a match.
+  auto pos = std::lower_bound(line_index.begin(), line_index.end(),
+                              std::make_pair(file_idx, line), key_less);
+  while (pos != line_index.end() && m_file_idxs[*pos] == file_idx) {
+    const uint32_t entry_line = GetLineAtIndex(*pos);
+    if (exact && entry_line != line)
+      break;
+    auto line_end = std::upper_bound(pos, line_index.end(),
+                                     std::make_pair(file_idx, entry_line),
+                                     key_greater);
+    auto match = std::lower_bound(pos, line_end, start_idx);
+    if (match != line_end)
+      return *match;
+    pos = line_end;
   }
   return UINT32_MAX;
 }
 
+uint32_t LineTable::FindLineEntryIndexByFileIndex(
+    uint32_t start_idx, const std::vector<uint32_t> &file_indexes,
+    uint32_t line, bool exact, LineEntry *line_entry_ptr) {
+  // Find the best match for each file. An exact match in any of them wins,
+  // and the first one of those in the table. Otherwise pick the closest line
+  // > the desired line, and the first entry of that line.
+  uint32_t best_match = UINT32_MAX;
+  for (uint32_t file_idx : file_indexes) {
+    const uint32_t idx =
+        FindEntryIndexByFileIndex(start_idx, file_idx, line, exact);
+    if (idx == UINT32_MAX)
+      continue;
+    // Every candidate is at least the desired line, so the lowest line
+    // number is the best one.
+    if (best_match == UINT32_MAX ||
+        std::make_pair(GetLineAtIndex(idx), idx) <
+            std::make_pair(GetLineAtIndex(best_match), best_match))
+      best_match = idx;
+  }
+
+  if (best_match != UINT32_MAX && line_entry_ptr)
+    ConvertEntryAtIndexToLineEntry(best_match, *line_entry_ptr);
+  return best_match;
+}
+
 uint32_t LineTable::FindLineEntryIndexByFileIndex(uint32_t start_idx,
                                                   uint32_t file_idx,
                                                   uint32_t line, bool exact,
                                                   LineEntry *line_entry_ptr) {
-  const size_t count = m_entries.size();
-  size_t best_match = UINT32_MAX;
-
-  for (size_t idx = start_idx; idx < count; ++idx) {
-    // Skip line table rows that terminate the previous row (is_terminal_entry
-    // is non-zero)
-    if (m_entries[idx].is_terminal_entry)
-      continue;
-
-    if (m_entries[idx].file_idx != file_idx)
-      continue;
-
-    // Exact match always wins.  Otherwise try to find the closest line > the
-    // desired line.
-    // FIXME: Maybe want to find the line closest before and the line closest
-    // after and
-    // if they're not in the same function, don't return a match.
-
-    if (m_entries[idx].line < line) {
-      continue;
-    } else if (m_entries[idx].line == line) {
-      if (line_entry_ptr)
-        ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
-      return idx;
-    } else if (!exact) {
-      if (best_match == UINT32_MAX)
-        best_match = idx;
-      else if (m_entries[idx].line < m_entries[best_match].line)
-        best_match = idx;
-    }
-  }
-
-  if (best_match != UINT32_MAX) {
-    if (line_entry_ptr)
-      ConvertEntryAtIndexToLineEntry(best_match, *line_entry_ptr);
-    return best_match;
-  }
-  return UINT32_MAX;
+  const uint32_t idx =
+      FindEntryIndexByFileIndex(start_idx, file_idx, line, exact);
+  if (idx != UINT32_MAX && line_entry_ptr)
+    ConvertEntryAtIndexToLineEntry(idx, *line_entry_ptr);
+  return idx;
 }
 
 size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
@@ -380,23 +521,28 @@ size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
   if (!append)
     sc_list.Clear();
 
-  size_t num_added = 0;
-  const size_t count = m_entries.size();
-  if (count > 0) {
-    SymbolContext sc(m_comp_unit);
+  const std::vector<uint32_t> &line_index = GetLineIndex();
+  auto file_less = [this](uint32_t idx, uint32_t file_idx) {
+    return m_file_idxs[idx] < file_idx;
+  };
+  auto file_greater = [this](uint32_t file_idx, uint32_t idx) {
+    return file_idx < m_file_idxs[idx];
+  };
+  auto begin_pos = std::lower_bound(line_index.begin(), line_index.end(),
+                                    file_idx, file_less);
+  auto end_pos =
+      std::upper_bound(begin_pos, line_index.end(), file_idx, file_greater);
+
+  // Report the entries in table order.
+  std::vector<uint32_t> matches(begin_pos, end_pos);
+  llvm::sort(matches.begin(), matches.end());
 
-    for (size_t idx = 0; idx < count; ++idx) {
-      // Skip line table rows that terminate the previous row
-      // (is_terminal_entry is non-zero)
-      if (m_entries[idx].is_terminal_entry)
-        continue;
-
-      if (m_entries[idx].file_idx == file_idx) {
-        if (ConvertEntryAtIndexToLineEntry(idx, sc.line_entry)) {
-          ++num_added;
-          sc_list.Append(sc);
-        }
-      }
+  size_t num_added = 0;
+  SymbolContext sc(m_comp_unit);
+  for (uint32_t idx : matches) {
+    if (ConvertEntryAtIndexToLineEntry(idx, sc.line_entry)) {
+      ++num_added;
+      sc_list.Append(sc);
     }
   }
   return num_added;
@@ -404,7 +550,8 @@ size_t LineTable::FineLineEntriesForFileIndex(uint32_t file_idx, bool append,
 
 void LineTable::Dump(Stream *s, Target *target, Address::DumpStyle style,
                      Address::DumpStyle fallback_style, bool show_line_ranges) {
-  const size_t count = m_entries.size();
+  Finalize();
+  const size_t count = GetSize();
   LineEntry line_entry;
   FileSpec prev_file;
   for (size_t idx = 0; idx < count; ++idx) {
@@ -418,7 +565,8 @@ void LineTable::Dump(Stream *s, Target *target, Address::DumpStyle style,
 
 void LineTable::GetDescription(Stream *s, Target *target,
                                DescriptionLevel level) {
-  const size_t count = m_entries.size();
+  Finalize();
+  const size_t count = GetSize();
   LineEntry line_entry;
   for (size_t idx = 0; idx < count; ++idx) {
     ConvertEntryAtIndexToLineEntry(idx, line_entry);
@@ -433,11 +581,12 @@ size_t LineTable::GetContiguousFileAddressRanges(FileAddressRanges &file_ranges,
     file_ranges.Clear();
   const size_t initial_count = file_ranges.GetSize();
 
-  const size_t count = m_entries.size();
+  Finalize();
+  const size_t count = GetSize();
   LineEntry line_entry;
   FileAddressRanges::Entry range(LLDB_INVALID_ADDRESS, 0);
   for (size_t idx = 0; idx < count; ++idx) {
-    const Entry &entry = m_entries[idx];
+    const Entry entry = GetEntryAtIndex(idx);
 
     if (entry.is_terminal_entry) {
       if (range.GetRangeBase() != LLDB_INVALID_ADDRESS) {
@@ -455,7 +604,8 @@ size_t LineTable::GetContiguousFileAddressRanges(FileAddressRanges &file_ranges,
 LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   std::unique_ptr<LineTable> line_table_up(new LineTable(m_comp_unit));
   LineSequenceImpl sequence;
-  const size_t count = m_entries.size();
+  Finalize();
+  const size_t count = GetSize();
   LineEntry line_entry;
   const FileRangeMap::Entry *file_range_entry = nullptr;
   const FileRangeMap::Entry *prev_file_range_entry = nullptr;
@@ -463,7 +613,7 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
   bool prev_entry_was_linked = false;
   bool range_changed = false;
   for (size_t idx = 0; idx < count; ++idx) {
-    const Entry &entry = m_entries[idx];
+    const Entry entry = GetEntryAtIndex(idx);
 
     const bool end_sequence = entry.is_terminal_entry;
     const lldb::addr_t lookup_file_addr =
@@ -541,7 +691,18 @@ LineTable *LineTable::LinkLineTable(const FileRangeMap &file_range_map) {
     prev_file_addr = entry.file_addr;
     range_changed = false;
   }
-  if (line_table_up->m_entries.empty())
+  if (line_table_up->GetSize() == 0)
     return nullptr;
   return line_table_up.release();
 }
+
+size_t LineTable::MemorySize() const {
+  return sizeof(LineTable) + m_entries.capacity() * sizeof(Entry) +
+         m_block_addrs.capacity() * sizeof(lldb::addr_t) +
+         m_addr_deltas.capacity() * sizeof(uint16_t) +
+         m_far_addrs.capacity() * sizeof(std::pair<uint32_t, lldb::addr_t>) +
+         m_lines.capacity() * sizeof(uint32_t) +
+         m_columns.capacity() * sizeof(uint16_t) +
+         m_file_idxs.capacity() * sizeof(uint16_t) +
+         m_line_index.capacity() * sizeof(uint32_t);
+}
@@ -12,6 +12,7 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Target/ModuleCache.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/DataBuffer.h"
 #include "lldb/Utility/DataExtractor.h"
@@ -228,6 +229,58 @@ static FileSpec LocateExecutableSymbolFileDsym(const ModuleSpec &module_spec) {
   return dsym_module_spec.GetSymbolFileSpec();
 }
 
+// Find the file |entry_name| of the module described by |module_spec| in the
+// symbol cache, if there is one.
+static FileSpec LookupSymbolCache(const ModuleSpec &module_spec,
+                                  llvm::StringRef entry_name) {
+  const FileSpec cache_dir_spec =
+      ModuleList::GetGlobalModuleListProperties().GetSymbolCachePath();
+  if (!cache_dir_spec || entry_name.empty())
+    return FileSpec();
+  return ModuleCache::GetEntry(cache_dir_spec, module_spec.GetUUID(),
+                               entry_name);
+}
+
+// Copy |file_spec| into the symbol cache as the file |entry_name| of the
+// module described by |module_spec|, so that the next lookup doesn't have to
+// search for it again. The copy is made before returning, so that it can't
+// outlive the file system or the process.
+static void AddToSymbolCache(const ModuleSpec &module_spec,
+                             llvm::StringRef entry_name,
+                             const FileSpec &file_spec) {
+  const ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  const FileSpec cache_dir_spec = properties.GetSymbolCachePath();
+  if (!cache_dir_spec || entry_name.empty() ||
+      !module_spec.GetUUID().IsValid())
+    return;
+
+  const uint64_t max_size = properties.GetSymbolCacheMaxSize() * 1024 * 1024;
+  const UUID uuid = module_spec.GetUUID();
+  Status error =
+      ModuleCache::PutEntry(cache_dir_spec, uuid, entry_name, file_spec);
+  if (error.Fail()) {
+    Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_HOST);
+    LLDB_LOGF(log, "Failed to add %s to the symbol cache: %s",
+              file_spec.GetPath().c_str(), error.AsCString());
+    return;
+  }
+
+  if (max_size)
+    ModuleCache::PruneIfNeeded(cache_dir_spec, max_size,
+                               FileSystem::Instance().GetByteSize(file_spec));
+}
+
+// Separate debug files are cached under the module's name with a ".debug"
+// extension. The cache is keyed by UUID, so the name only has to be stable.
+static std::string GetCachedSymbolFileName(const ModuleSpec &module_spec) {
+  llvm::StringRef module_name =
+      module_spec.GetFileSpec().GetFilename().GetStringRef();
+  if (module_name.empty())
+    return std::string();
+  return (module_name + ".debug").str();
+}
+
 ModuleSpec Symbols::LocateExecutableObjectFile(const ModuleSpec &module_spec) {
   ModuleSpec result;
   const FileSpec *exec_fspec = module_spec.GetFileSpecPtr();
@@ -246,7 +299,10 @@ ModuleSpec Symbols::LocateExecutableObjectFile(const ModuleSpec &module_spec) {
       module_specs.FindMatchingModuleSpec(module_spec, matched_module_spec)) {
     result.GetFileSpec() = exec_fspec;
   } else {
-    LocateMacOSXFilesUsingDebugSymbols(module_spec, result);
+    result.GetFileSpec() = LookupSymbolCache(
+        module_spec, module_spec.GetFileSpec().GetFilename().GetStringRef());
+    if (!result.GetFileSpec())
+      LocateMacOSXFilesUsingDebugSymbols(module_spec, result);
   }
   return result;
 }
@@ -261,6 +317,12 @@ Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec,
       FileSystem::Instance().Exists(symbol_file_spec))
     return symbol_file_spec;
 
+  const std::string cached_symbol_file_name =
+      GetCachedSymbolFileName(module_spec);
+  if (FileSpec cached_file_spec =
+          LookupSymbolCache(module_spec, cached_symbol_file_name))
+    return cached_file_spec;
+
   FileSpecList debug_file_search_paths = default_search_paths;
 
   // Add module directory.
@@ -363,8 +425,11 @@ Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec,
             // Skip the uuids check if module_uuid is invalid. For example,
             // this happens for *.dwp files since at the moment llvm-dwp
             // doesn't output build ids, nor does binutils dwp.
-            if (!module_uuid.IsValid() || module_uuid == mspec.GetUUID())
+            if (!module_uuid.IsValid() || module_uuid == mspec.GetUUID()) {
+              AddToSymbolCache(module_spec, cached_symbol_file_name,
+                               file_spec);
               return file_spec;
+            }
           }
         }
       }
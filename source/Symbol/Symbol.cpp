@@ -17,6 +17,7 @@
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Stream.h"
 
 using namespace lldb;
@@ -567,3 +568,74 @@ bool Symbol::GetDisassembly(const ExecutionContext &exe_ctx, const char *flavor,
 bool Symbol::ContainsFileAddress(lldb::addr_t file_addr) const {
   return m_addr_range.ContainsFileAddress(file_addr);
 }
+
+// uid, type data, flag bits, type, flags, names and address range.
+static const lldb::offset_t g_encoded_symbol_size = 4 + 2 + 2 + 1 + 4 + 4 + 4 +
+                                                    1 + 8 + 8 + 8;
+
+void Symbol::Encode(
+    Stream &strm, llvm::function_ref<uint32_t(ConstString)> string_index) const {
+  strm.PutHex32(m_uid);
+  strm.PutHex16(m_type_data);
+  strm.PutHex16(m_type_data_resolved | m_is_synthetic << 1 | m_is_debug << 2 |
+                m_is_external << 3 | m_size_is_sibling << 4 |
+                m_size_is_synthesized << 5 | m_size_is_valid << 6 |
+                m_demangled_is_synthesized << 7 |
+                m_contains_linker_annotations << 8 | m_is_weak << 9);
+  strm.PutHex8(m_type);
+  strm.PutHex32(m_flags);
+  strm.PutHex32(string_index(m_mangled.GetMangledName()));
+  strm.PutHex32(string_index(m_mangled.GetDemangledName(GetLanguage())));
+
+  const Address &base_addr = m_addr_range.GetBaseAddress();
+  SectionSP section_sp = base_addr.GetSection();
+  strm.PutHex8(section_sp ? 1 : 0);
+  strm.PutHex64(section_sp ? section_sp->GetID() : 0);
+  strm.PutHex64(base_addr.GetOffset());
+  strm.PutHex64(m_addr_range.GetByteSize());
+}
+
+bool Symbol::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                    const SectionList *section_list,
+                    llvm::ArrayRef<ConstString> strings) {
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, g_encoded_symbol_size))
+    return false;
+
+  m_uid = data.GetU32(offset_ptr);
+  m_type_data = data.GetU16(offset_ptr);
+  const uint16_t bits = data.GetU16(offset_ptr);
+  m_type_data_resolved = bits & 1;
+  m_is_synthetic = (bits >> 1) & 1;
+  m_is_debug = (bits >> 2) & 1;
+  m_is_external = (bits >> 3) & 1;
+  m_size_is_sibling = (bits >> 4) & 1;
+  m_size_is_synthesized = (bits >> 5) & 1;
+  m_size_is_valid = (bits >> 6) & 1;
+  m_demangled_is_synthesized = (bits >> 7) & 1;
+  m_contains_linker_annotations = (bits >> 8) & 1;
+  m_is_weak = (bits >> 9) & 1;
+  m_type = data.GetU8(offset_ptr);
+  m_flags = data.GetU32(offset_ptr);
+
+  const uint32_t mangled_idx = data.GetU32(offset_ptr);
+  const uint32_t demangled_idx = data.GetU32(offset_ptr);
+  if (mangled_idx >= strings.size() || demangled_idx >= strings.size())
+    return false;
+  m_mangled.SetMangledName(strings[mangled_idx]);
+  m_mangled.SetDemangledName(strings[demangled_idx]);
+
+  const bool has_section = data.GetU8(offset_ptr) != 0;
+  const user_id_t section_id = data.GetU64(offset_ptr);
+  const addr_t offset = data.GetU64(offset_ptr);
+  const addr_t byte_size = data.GetU64(offset_ptr);
+  if (has_section) {
+    SectionSP section_sp =
+        section_list ? section_list->FindSectionByID(section_id) : SectionSP();
+    if (!section_sp)
+      return false;
+    m_addr_range = AddressRange(section_sp, offset, byte_size);
+  } else {
+    m_addr_range = AddressRange(Address(offset), byte_size);
+  }
+  return true;
+}
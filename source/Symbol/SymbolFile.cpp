@@ -28,6 +28,10 @@ void SymbolFile::PreloadSymbols() {
   // No-op for most implementations.
 }
 
+void SymbolFile::PreloadNames(llvm::ArrayRef<ConstString> names) {
+  // No-op for most implementations.
+}
+
 std::recursive_mutex &SymbolFile::GetModuleMutex() const {
   return GetObjectFile()->GetModule()->GetMutex();
 }
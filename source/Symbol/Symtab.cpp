@@ -19,10 +19,12 @@
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
-#include "lldb/Utility/Stream.h"
+#include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 
 using namespace lldb;
@@ -45,6 +47,7 @@ Symbol *Symtab::Resize(size_t count) {
   // Clients should grab the mutex from this symbol table and lock it manually
   // when calling this function to avoid performance issues.
   m_symbols.resize(count);
+  m_name_corpus.reset();
   return m_symbols.empty() ? nullptr : &m_symbols[0];
 }
 
@@ -57,6 +60,7 @@ uint32_t Symtab::AddSymbol(const Symbol &symbol) {
   m_symbols.push_back(symbol);
   m_file_addr_to_index_computed = false;
   m_name_indexes_computed = false;
+  m_name_corpus.reset();
   return symbol_idx;
 }
 
@@ -679,17 +683,13 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   uint32_t prev_size = indexes.size();
-  uint32_t sym_end = m_symbols.size();
 
-  for (uint32_t i = 0; i < sym_end; i++) {
+  std::vector<uint32_t> matches;
+  GetNameCorpus().FindValues(regexp, matches);
+  for (uint32_t i : matches) {
     if (symbol_type == eSymbolTypeAny ||
-        m_symbols[i].GetType() == symbol_type) {
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
-        if (regexp.Execute(name))
-          indexes.push_back(i);
-      }
-    }
+        m_symbols[i].GetType() == symbol_type)
+      indexes.push_back(i);
   }
   return indexes.size() - prev_size;
 }
@@ -701,24 +701,34 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   uint32_t prev_size = indexes.size();
-  uint32_t sym_end = m_symbols.size();
 
-  for (uint32_t i = 0; i < sym_end; i++) {
+  std::vector<uint32_t> matches;
+  GetNameCorpus().FindValues(regexp, matches);
+  for (uint32_t i : matches) {
     if (symbol_type == eSymbolTypeAny ||
         m_symbols[i].GetType() == symbol_type) {
-      if (!CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility))
-        continue;
-
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
-        if (regexp.Execute(name))
-          indexes.push_back(i);
-      }
+      if (CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility))
+        indexes.push_back(i);
     }
   }
   return indexes.size() - prev_size;
 }
 
+const NameCorpus &Symtab::GetNameCorpus() {
+  if (!m_name_corpus) {
+    static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+    Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+    m_name_corpus.reset(new NameCorpus());
+    const uint32_t num_symbols = m_symbols.size();
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      if (ConstString name = m_symbols[i].GetName())
+        m_name_corpus->Append(name, i);
+    }
+    m_name_corpus->Finalize();
+  }
+  return *m_name_corpus;
+}
+
 Symbol *Symtab::FindSymbolWithType(SymbolType symbol_type,
                                    Debug symbol_debug_type,
                                    Visibility symbol_visibility,
@@ -1127,3 +1137,140 @@ const Symbol *Symtab::GetParent(Symbol *child_symbol) const {
   }
   return nullptr;
 }
+
+// Bump this whenever the layout written by Symtab::Encode or Symbol::Encode
+// changes, so that stale caches are ignored rather than misread.
+static const uint32_t g_symtab_encoding_version = 1;
+
+void Symtab::Encode(Stream &strm) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  InitNameIndexes();
+  InitAddressIndexes();
+
+  // Symbols and index entries refer to names by their position in a string
+  // table that precedes them, so each name is written only once. Index 0 is
+  // reserved for the null string.
+  llvm::DenseMap<const char *, uint32_t> string_indexes;
+  std::vector<llvm::StringRef> strings;
+  auto string_index = [&](ConstString str) -> uint32_t {
+    if (str.IsNull())
+      return 0;
+    auto insertion =
+        string_indexes.try_emplace(str.GetCString(), strings.size() + 1);
+    if (insertion.second)
+      strings.push_back(str.GetStringRef());
+    return insertion.first->second;
+  };
+
+  StreamString body(Stream::eBinary, strm.GetAddressByteSize(),
+                    strm.GetByteOrder());
+  body.PutHex32(m_symbols.size());
+  for (const Symbol &symbol : m_symbols)
+    symbol.Encode(body, string_index);
+
+  for (const NameToIndexMap *map : {&m_name_to_index, &m_basename_to_index,
+                                    &m_method_to_index, &m_selector_to_index}) {
+    body.PutHex32(map->GetSize());
+    for (size_t i = 0; i < map->GetSize(); ++i) {
+      body.PutHex32(string_index(map->GetCStringAtIndexUnchecked(i)));
+      body.PutHex32(map->GetValueRefAtIndexUnchecked(i));
+    }
+  }
+
+  body.PutHex32(m_file_addr_to_index.GetSize());
+  for (size_t i = 0; i < m_file_addr_to_index.GetSize(); ++i) {
+    const FileRangeToIndexMap::Entry &entry =
+        m_file_addr_to_index.GetEntryRef(i);
+    body.PutHex64(entry.GetRangeBase());
+    body.PutHex64(entry.GetByteSize());
+    body.PutHex32(entry.data);
+  }
+
+  strm.PutHex32(g_symtab_encoding_version);
+  strm.PutHex32(strings.size());
+  for (llvm::StringRef str : strings) {
+    strm.Write(str.data(), str.size());
+    strm.PutHex8(0);
+  }
+  strm.Write(body.GetData(), body.GetSize());
+}
+
+bool Symtab::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                    const SectionList *section_list) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+
+  auto fail = [this]() {
+    m_symbols.clear();
+    m_name_to_index.Clear();
+    m_basename_to_index.Clear();
+    m_method_to_index.Clear();
+    m_selector_to_index.Clear();
+    m_file_addr_to_index.Clear();
+    return false;
+  };
+
+  if (data.GetU32(offset_ptr) != g_symtab_encoding_version)
+    return false;
+
+  const uint32_t num_strings = data.GetU32(offset_ptr);
+  std::vector<ConstString> strings;
+  strings.reserve(num_strings + 1);
+  strings.push_back(ConstString());
+  for (uint32_t i = 0; i < num_strings; ++i) {
+    const lldb::offset_t str_offset = *offset_ptr;
+    const char *str = data.GetCStr(offset_ptr);
+    if (!str)
+      return false;
+    strings.push_back(
+        ConstString(llvm::StringRef(str, *offset_ptr - str_offset - 1)));
+  }
+
+  // Make sure a corrupt count can't make us allocate more symbols than the
+  // data could possibly hold.
+  const uint32_t num_symbols = data.GetU32(offset_ptr);
+  if (num_symbols > data.BytesLeft(*offset_ptr))
+    return false;
+  m_symbols.resize(num_symbols);
+  m_name_corpus.reset();
+  for (Symbol &symbol : m_symbols) {
+    if (!symbol.Decode(data, offset_ptr, section_list, strings))
+      return fail();
+  }
+
+  for (NameToIndexMap *map : {&m_name_to_index, &m_basename_to_index,
+                              &m_method_to_index, &m_selector_to_index}) {
+    const uint32_t num_entries = data.GetU32(offset_ptr);
+    if (!data.ValidOffsetForDataOfSize(*offset_ptr, num_entries * 8ull))
+      return fail();
+    map->Reserve(num_entries);
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      const uint32_t str_idx = data.GetU32(offset_ptr);
+      const uint32_t symbol_idx = data.GetU32(offset_ptr);
+      if (str_idx >= strings.size() || symbol_idx >= num_symbols)
+        return fail();
+      map->Append(strings[str_idx], symbol_idx);
+    }
+    // The maps are ordered by string pool address, which differs from one
+    // process to the next.
+    map->Sort();
+  }
+
+  const uint32_t num_addr_entries = data.GetU32(offset_ptr);
+  if (!data.ValidOffsetForDataOfSize(*offset_ptr, num_addr_entries * 20ull))
+    return fail();
+  for (uint32_t i = 0; i < num_addr_entries; ++i) {
+    FileRangeToIndexMap::Entry entry;
+    entry.SetRangeBase(data.GetU64(offset_ptr));
+    entry.SetByteSize(data.GetU64(offset_ptr));
+    entry.data = data.GetU32(offset_ptr);
+    if (entry.data >= num_symbols)
+      return fail();
+    m_file_addr_to_index.Append(entry);
+  }
+
+  m_name_indexes_computed = true;
+  m_file_addr_to_index_computed = true;
+  return true;
+}
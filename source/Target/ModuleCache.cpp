@@ -14,12 +14,21 @@
 #include "lldb/Host/File.h"
 #include "lldb/Host/LockFile.h"
 #include "lldb/Utility/Log.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include <assert.h>
 
+#include <chrono>
 #include <cstdio>
+#include <mutex>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -31,6 +40,9 @@ const char *kLockDirName = ".lock";
 const char *kTempFileName = ".temp";
 const char *kTempSymFileName = ".symtemp";
 const char *kSymFileExtension = ".sym";
+const char *kTempEntryPrefix = ".entry-";
+const char *kTempEntryModel = ".entry-%%%%%%%%";
+const char *kLastUsedFileName = ".last-used";
 const char *kFSIllegalChars = "\\/:*?\"<>|";
 
 std::string GetEscapedHostname(const char *hostname) {
@@ -53,7 +65,10 @@ private:
   FileSpec m_file_spec;
 
 public:
-  ModuleLock(const FileSpec &root_dir_spec, const UUID &uuid, Status &error);
+  ModuleLock(const FileSpec &root_dir_spec, const UUID &uuid, Status &error)
+      : ModuleLock(root_dir_spec, uuid.GetAsString(), error) {}
+  ModuleLock(const FileSpec &root_dir_spec, llvm::StringRef lock_name,
+             Status &error);
   void Delete();
 };
 
@@ -147,16 +162,94 @@ Status CreateHostSysRootModuleLink(const FileSpec &root_dir_spec,
                                          sysroot_module_path_spec.GetPath());
 }
 
+// Mark a cached module as used, which is what ModuleCache::Prune goes by.
+// The time is kept on an empty file of its own, as the timestamps of the
+// cached files themselves are those of the originals and others rely on them.
+void MarkModuleUsed(const FileSpec &module_spec_dir) {
+  int fd;
+  if (llvm::sys::fs::openFileForWrite(
+          JoinPath(module_spec_dir, kLastUsedFileName).GetPath(), fd,
+          llvm::sys::fs::CD_OpenAlways, llvm::sys::fs::OF_Append))
+    return;
+  llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now());
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+}
+
+// Have |writer| fill a temporary file next to the entry and rename that over
+// the entry, so that other debuggers never see a partially written file.
+Status InstallEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                    llvm::StringRef entry_name,
+                    llvm::function_ref<std::error_code(int)> writer) {
+  if (!uuid.IsValid())
+    return Status("Invalid module UUID");
+
+  const auto module_spec_dir = GetModuleDirectory(root_dir_spec, uuid);
+  auto error = MakeDirectory(module_spec_dir);
+  if (error.Fail())
+    return error;
+
+  ModuleLock lock(root_dir_spec, uuid, error);
+  if (error.Fail())
+    return Status("Failed to lock module %s: %s", uuid.GetAsString().c_str(),
+                  error.AsCString());
+
+  int fd;
+  llvm::SmallString<128> tmp_file_path;
+  auto err_code = llvm::sys::fs::createUniqueFile(
+      JoinPath(module_spec_dir, kTempEntryModel).GetPath(), fd,
+      tmp_file_path);
+  if (err_code)
+    return Status("Failed to create temporary file in %s: %s",
+                  module_spec_dir.GetPath().c_str(),
+                  err_code.message().c_str());
+  llvm::FileRemover tmp_file_remover(tmp_file_path);
+
+  err_code = writer(fd);
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+  if (err_code)
+    return Status("Failed to write file %s: %s", tmp_file_path.c_str(),
+                  err_code.message().c_str());
+
+  const auto entry_file_path =
+      JoinPath(module_spec_dir, entry_name.str().c_str()).GetPath();
+  err_code = llvm::sys::fs::rename(tmp_file_path, entry_file_path);
+  if (err_code)
+    return Status("Failed to rename file %s to %s: %s", tmp_file_path.c_str(),
+                  entry_file_path.c_str(), err_code.message().c_str());
+
+  tmp_file_remover.releaseFile();
+  MarkModuleUsed(module_spec_dir);
+  return Status();
+}
+
+// The size of each symbol cache as of the last time it was pruned, plus that
+// of the entries this process added to it since.
+struct CacheSize {
+  uint64_t total_size;
+  uint64_t added_size;
+};
+
+std::mutex &GetCacheSizesMutex() {
+  static std::mutex g_mutex;
+  return g_mutex;
+}
+
+llvm::StringMap<CacheSize> &GetCacheSizes() {
+  static llvm::StringMap<CacheSize> g_cache_sizes;
+  return g_cache_sizes;
+}
+
 } // namespace
 
-ModuleLock::ModuleLock(const FileSpec &root_dir_spec, const UUID &uuid,
+ModuleLock::ModuleLock(const FileSpec &root_dir_spec, llvm::StringRef lock_name,
                        Status &error) {
   const auto lock_dir_spec = JoinPath(root_dir_spec, kLockDirName);
   error = MakeDirectory(lock_dir_spec);
   if (error.Fail())
     return;
 
-  m_file_spec = JoinPath(lock_dir_spec, uuid.GetAsString().c_str());
+  m_file_spec = JoinPath(lock_dir_spec, lock_name.str().c_str());
 
   auto file = FileSystem::Instance().Open(
       m_file_spec, File::eOpenOptionWrite | File::eOpenOptionCanCreate |
@@ -333,3 +426,149 @@ Status ModuleCache::GetAndPut(const FileSpec &root_dir_spec,
   cached_module_sp->SetSymbolFileFileSpec(symfile_spec);
   return Status();
 }
+
+FileSpec ModuleCache::GetEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                               llvm::StringRef entry_name) {
+  if (!uuid.IsValid())
+    return FileSpec();
+
+  const auto module_spec_dir = GetModuleDirectory(root_dir_spec, uuid);
+  const auto entry_file_spec =
+      JoinPath(module_spec_dir, entry_name.str().c_str());
+  if (!FileSystem::Instance().Exists(entry_file_spec))
+    return FileSpec();
+
+  MarkModuleUsed(module_spec_dir);
+  return entry_file_spec;
+}
+
+Status ModuleCache::PutEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                             llvm::StringRef entry_name,
+                             const FileSpec &file_spec) {
+  return InstallEntry(root_dir_spec, uuid, entry_name, [&](int fd) {
+    return llvm::sys::fs::copy_file(file_spec.GetPath(), fd);
+  });
+}
+
+Status ModuleCache::PutEntry(const FileSpec &root_dir_spec, const UUID &uuid,
+                             llvm::StringRef entry_name,
+                             llvm::ArrayRef<uint8_t> data) {
+  return InstallEntry(root_dir_spec, uuid, entry_name, [&](int fd) {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/false);
+    os.write(reinterpret_cast<const char *>(data.data()), data.size());
+    os.flush();
+    return os.error();
+  });
+}
+
+uint64_t ModuleCache::Prune(const FileSpec &root_dir_spec, uint64_t max_size) {
+  namespace fs = llvm::sys::fs;
+
+  struct CachedModule {
+    std::string name;
+    std::string path;
+    uint64_t size;
+    llvm::sys::TimePoint<> last_used;
+  };
+
+  // A module was last used when any one of its entries was.
+  std::vector<CachedModule> modules;
+  uint64_t total_size = 0;
+  std::error_code ec;
+  const auto modules_dir_path =
+      JoinPath(root_dir_spec, kModulesSubdir).GetPath();
+  for (fs::directory_iterator module_it(modules_dir_path, ec), end;
+       !ec && module_it != end; module_it.increment(ec)) {
+    if (module_it->type() != fs::file_type::directory_file)
+      continue;
+
+    CachedModule module{llvm::sys::path::filename(module_it->path()).str(),
+                        module_it->path(), 0, llvm::sys::TimePoint<>()};
+    std::error_code entry_ec;
+    bool has_last_used = false;
+    std::vector<std::string> temp_entries;
+    for (fs::directory_iterator entry_it(module.path, entry_ec);
+         !entry_ec && entry_it != end; entry_it.increment(entry_ec)) {
+      if (llvm::sys::path::filename(entry_it->path())
+              .startswith(kTempEntryPrefix)) {
+        temp_entries.push_back(entry_it->path());
+        continue;
+      }
+      fs::file_status st;
+      if (fs::status(entry_it->path(), st))
+        continue;
+      module.size += st.getSize();
+      // Modules that were cached without a last-used file go by the time
+      // their files were added.
+      if (llvm::sys::path::filename(entry_it->path()) == kLastUsedFileName) {
+        module.last_used = st.getLastModificationTime();
+        has_last_used = true;
+      } else if (!has_last_used) {
+        module.last_used =
+            std::max(module.last_used, st.getLastModificationTime());
+      }
+    }
+    // Entries are only written while their module is locked, so temporary
+    // entries found under the lock are left over from an interrupted copy.
+    if (!temp_entries.empty()) {
+      Status error;
+      ModuleLock lock(root_dir_spec, module.name, error);
+      if (error.Success()) {
+        for (const std::string &temp_entry : temp_entries)
+          if (!fs::remove(temp_entry))
+            LLDB_LOGF(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES),
+                      "Removed stale cache entry %s", temp_entry.c_str());
+      }
+    }
+    total_size += module.size;
+    modules.push_back(std::move(module));
+  }
+
+  if (total_size <= max_size)
+    return total_size;
+
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+  llvm::sort(modules, [](const CachedModule &lhs, const CachedModule &rhs) {
+    return lhs.last_used < rhs.last_used;
+  });
+  for (const CachedModule &module : modules) {
+    if (total_size <= max_size)
+      break;
+
+    Status error;
+    ModuleLock lock(root_dir_spec, module.name, error);
+    if (error.Fail()) {
+      LLDB_LOGF(log, "Failed to lock module %s: %s", module.name.c_str(),
+                error.AsCString());
+      continue;
+    }
+
+    if (fs::remove_directories(module.path))
+      continue;
+    lock.Delete();
+    total_size -= module.size;
+    LLDB_LOGF(log, "Evicted module %s from the cache", module.name.c_str());
+  }
+  return total_size;
+}
+
+void ModuleCache::PruneIfNeeded(const FileSpec &root_dir_spec,
+                                uint64_t max_size, uint64_t added_size) {
+  const std::string root_dir_path = root_dir_spec.GetPath();
+  {
+    std::lock_guard<std::mutex> guard(GetCacheSizesMutex());
+    auto pos = GetCacheSizes().find(root_dir_path);
+    if (pos != GetCacheSizes().end()) {
+      CacheSize &size = pos->second;
+      size.added_size += added_size;
+      if (size.total_size + size.added_size <= max_size)
+        return;
+    }
+  }
+
+  // Either this is the first entry this process adds to the cache, or the
+  // cache may have grown past its limit since it was last pruned.
+  const uint64_t total_size = Prune(root_dir_spec, max_size);
+  std::lock_guard<std::mutex> guard(GetCacheSizesMutex());
+  GetCacheSizes()[root_dir_path] = CacheSize{total_size, 0};
+}
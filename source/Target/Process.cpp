@@ -16,6 +16,7 @@
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -2174,6 +2175,13 @@ size_t Process::WriteMemory(addr_t addr, const void *buf, size_t size,
 
   m_mod_id.BumpMemoryID();
 
+  // Code disassembled from this range may no longer match memory.
+  Address so_addr;
+  if (GetTarget().ResolveLoadAddress(addr, so_addr))
+    if (ModuleSP module_sp = so_addr.GetModule())
+      module_sp->GetDisassemblerCache().Invalidate(so_addr.GetFileAddress(),
+                                                   size);
+
   // We need to write any data that would go where any current software traps
   // (enabled software breakpoints) any software traps (breakpoints) that we
   // may have placed in our tasks memory.
@@ -41,6 +41,7 @@
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Target/LanguageRuntime.h"
 #include "lldb/Target/Process.h"
@@ -1377,6 +1378,41 @@ void Target::ClearModules(bool delete_locations) {
   m_ast_importer_sp.reset();
 }
 
+std::vector<uint64_t> Target::GetStatistics() {
+  std::vector<uint64_t> stats = m_stats_storage;
+
+  // Decompression happens in the object files, so gather it up from the
+  // modules rather than counting it as it happens. Like the other counters,
+  // these are only filled in while statistics are being collected.
+  if (GetCollectingStats()) {
+    std::chrono::nanoseconds decompression_time(0);
+    uint32_t modules_not_fully_parsed = 0;
+    for (ModuleSP module_sp : m_images.Modules()) {
+      if (!module_sp->HasParsedSections())
+        ++modules_not_fully_parsed;
+      ObjectFile *objfile = module_sp->GetObjectFile();
+      if (objfile)
+        decompression_time += objfile->GetSectionDecompressionTime();
+      if (SymbolFile *symfile = module_sp->GetSymbolFile(false)) {
+        ObjectFile *sym_objfile = symfile->GetObjectFile();
+        if (sym_objfile && sym_objfile != objfile)
+          decompression_time += sym_objfile->GetSectionDecompressionTime();
+      }
+    }
+    auto decompression_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            decompression_time);
+    stats[StatisticKind::SectionDecompressionTime] =
+        static_cast<uint64_t>(decompression_ms.count());
+    stats[StatisticKind::ModulesNotFullyParsed] = modules_not_fully_parsed;
+  }
+  stats[StatisticKind::BreakpointResolutionTime] = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          m_breakpoint_resolution_time)
+          .count());
+  return stats;
+}
+
 void Target::DidExec() {
   // When a process exec's we need to know about it so we can do some cleanup.
   m_breakpoint_list.RemoveInvalidLocations(m_arch.GetSpec());
@@ -1609,8 +1645,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
     }
-    m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+    ResolveBreakpointsInLoadedModules(module_list);
     if (m_process_sp) {
       m_process_sp->ModulesDidLoad(module_list);
     }
@@ -1627,13 +1662,20 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
       }
     }
 
-    m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+    ResolveBreakpointsInLoadedModules(module_list);
     BroadcastEvent(eBroadcastBitSymbolsLoaded,
                    new TargetEventData(this->shared_from_this(), module_list));
   }
 }
 
+void Target::ResolveBreakpointsInLoadedModules(ModuleList &module_list) {
+  const auto start = std::chrono::steady_clock::now();
+  m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+  m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+  if (GetCollectingStats())
+    m_breakpoint_resolution_time += std::chrono::steady_clock::now() - start;
+}
+
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
     UnloadModuleSections(module_list);
@@ -2071,7 +2113,7 @@ ModuleSP Target::GetOrCreateModule(const ModuleSpec &module_spec, bool notify,
 
         // Preload symbols outside of any lock, so hopefully we can do this for
         // each library in parallel.
-        if (GetPreloadSymbols())
+        if (GetPreloadSymbols() && !GetLazyModuleParsing())
           module_sp->PreloadSymbols();
 
         if (old_module_sp && m_images.GetIndexForModule(old_module_sp.get()) !=
@@ -3614,6 +3656,18 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
+bool TargetProperties::GetLazyModuleParsing() const {
+  const uint32_t idx = ePropertyLazyModuleParsing;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -3765,6 +3819,18 @@ bool TargetProperties::GetEnableImportStdModule() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+bool TargetProperties::GetEnableLazyTypeImport() const {
+  const uint32_t idx = ePropertyLazyTypeImport;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
+bool TargetProperties::GetPreloadExpressionNames() const {
+  const uint32_t idx = ePropertyPreloadExpressionNames;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetEnableAutoApplyFixIts() const {
   const uint32_t idx = ePropertyAutoApplyFixIts;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -686,6 +686,12 @@ bool Thread::ShouldResume(StateType resume_state) {
 
   if (need_to_resume) {
     ClearStackFrames();
+    m_resume_step_range_start = LLDB_INVALID_ADDRESS;
+    m_resume_step_range_end = LLDB_INVALID_ADDRESS;
+    if (resume_state == eStateStepping && GetProcess()->SupportsRangeStepping())
+      if (ThreadPlan *current_plan = GetCurrentPlan())
+        current_plan->GetResumeStepRange(m_resume_step_range_start,
+                                         m_resume_step_range_end);
     // Let Thread subclasses do any special work they need to prior to resuming
     WillResume(resume_state);
   }
@@ -301,8 +301,9 @@ bool ThreadPlanStepRange::SetNextBranchBreakpoint() {
 
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_STEP));
   // Stepping through ranges using breakpoints doesn't work yet, but with this
-  // off we fall back to instruction single stepping.
-  if (!m_use_fast_step)
+  // off we fall back to instruction single stepping. If the process can step
+  // through the whole range on its own, that beats stopping at each branch.
+  if (!m_use_fast_step || m_thread.GetProcess()->SupportsRangeStepping())
     return false;
 
   lldb::addr_t cur_addr = GetThread().GetRegisterContext()->GetPC();
@@ -423,6 +424,29 @@ StateType ThreadPlanStepRange::GetPlanRunState() {
     return eStateStepping;
 }
 
+bool ThreadPlanStepRange::GetResumeStepRange(lldb::addr_t &start,
+                                             lldb::addr_t &end) {
+  // A tracer wants to see every instruction.
+  lldb::ThreadPlanTracerSP tracer_sp = GetThreadPlanTracer();
+  if (tracer_sp && tracer_sp->TracingEnabled())
+    return false;
+
+  Target &target = GetTarget();
+  const lldb::addr_t pc = m_thread.GetRegisterContext()->GetPC();
+  for (const AddressRange &range : m_address_ranges) {
+    const lldb::addr_t range_start =
+        range.GetBaseAddress().GetLoadAddress(&target);
+    if (range_start == LLDB_INVALID_ADDRESS)
+      continue;
+    if (range_start <= pc && pc < range_start + range.GetByteSize()) {
+      start = range_start;
+      end = range_start + range.GetByteSize();
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ThreadPlanStepRange::MischiefManaged() {
   // If we have pushed some plans between ShouldStop & MischiefManaged, then
   // we're not done...
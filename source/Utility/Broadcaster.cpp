@@ -202,13 +202,14 @@ void Broadcaster::BroadcasterImpl::PrivateBroadcastEvent(EventSP &event_sp,
 
   std::lock_guard<std::recursive_mutex> guard(m_listeners_mutex);
 
-  ListenerSP hijacking_listener_sp;
+  // The hijacking listeners can't go away while we hold the mutex, so there
+  // is no need for another reference to the current one.
+  Listener *hijacking_listener = nullptr;
 
   if (!m_hijacking_listeners.empty()) {
     assert(!m_hijacking_masks.empty());
-    hijacking_listener_sp = m_hijacking_listeners.back();
-    if ((event_type & m_hijacking_masks.back()) == 0)
-      hijacking_listener_sp.reset();
+    if (event_type & m_hijacking_masks.back())
+      hijacking_listener = m_hijacking_listeners.back().get();
   }
 
   if (Log *log = lldb_private::GetLogIfAnyCategoriesSet(LIBLLDB_LOG_EVENTS)) {
@@ -219,14 +220,14 @@ void Broadcaster::BroadcasterImpl::PrivateBroadcastEvent(EventSP &event_sp,
               "unique =%i) hijack = %p",
               static_cast<void *>(this), GetBroadcasterName(),
               event_description.GetData(), unique,
-              static_cast<void *>(hijacking_listener_sp.get()));
+              static_cast<void *>(hijacking_listener));
   }
 
-  if (hijacking_listener_sp) {
-    if (unique && hijacking_listener_sp->PeekAtNextEventForBroadcasterWithType(
+  if (hijacking_listener) {
+    if (unique && hijacking_listener->PeekAtNextEventForBroadcasterWithType(
                       &m_broadcaster, event_type))
       return;
-    hijacking_listener_sp->AddEvent(event_sp);
+    hijacking_listener->AddEvent(event_sp);
   } else {
     for (auto &pair : GetListeners()) {
       if (!(pair.second & event_type))
@@ -242,19 +243,19 @@ void Broadcaster::BroadcasterImpl::PrivateBroadcastEvent(EventSP &event_sp,
 
 void Broadcaster::BroadcasterImpl::BroadcastEvent(uint32_t event_type,
                                                   EventData *event_data) {
-  auto event_sp = std::make_shared<Event>(event_type, event_data);
+  auto event_sp = Event::Create(event_type, event_data);
   PrivateBroadcastEvent(event_sp, false);
 }
 
 void Broadcaster::BroadcasterImpl::BroadcastEvent(
     uint32_t event_type, const lldb::EventDataSP &event_data_sp) {
-  auto event_sp = std::make_shared<Event>(event_type, event_data_sp);
+  auto event_sp = Event::Create(event_type, event_data_sp);
   PrivateBroadcastEvent(event_sp, false);
 }
 
 void Broadcaster::BroadcasterImpl::BroadcastEventIfUnique(
     uint32_t event_type, EventData *event_data) {
-  auto event_sp = std::make_shared<Event>(event_type, event_data);
+  auto event_sp = Event::Create(event_type, event_data);
   PrivateBroadcastEvent(event_sp, true);
 }
 
@@ -0,0 +1,190 @@
+//===-- CRC32.cpp -----------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/CRC32.h"
+
+#include "llvm/Support/Endian.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LLDB_CRC32_USE_PCLMUL 1
+#include <immintrin.h>
+#endif
+
+using namespace lldb_private;
+
+// The bit-reversed form of the CRC-32 polynomial 0x04C11DB7.
+static const uint32_t g_crc32_polynomial = 0xEDB88320;
+
+namespace {
+// Lookup tables for slicing-by-8: table[0] is the classic byte-at-a-time
+// table, and table[k] advances a byte's contribution past k more zero bytes.
+struct CRC32Tables {
+  uint32_t table[8][256];
+
+  CRC32Tables() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit)
+        crc = (crc >> 1) ^ ((crc & 1) ? g_crc32_polynomial : 0);
+      table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+      for (int k = 1; k < 8; ++k)
+        table[k][i] =
+            (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+  }
+};
+} // namespace
+
+static const CRC32Tables &GetCRC32Tables() {
+  static const CRC32Tables g_tables;
+  return g_tables;
+}
+
+uint32_t lldb_private::CalculateCRC32Portable(uint32_t crc,
+                                              llvm::ArrayRef<uint8_t> data) {
+  using llvm::support::endian::read32le;
+  const auto &t = GetCRC32Tables().table;
+  const uint8_t *p = data.data();
+  size_t size = data.size();
+
+  crc = ~crc;
+  while (size >= 8) {
+    const uint32_t lo = crc ^ read32le(p);
+    const uint32_t hi = read32le(p + 4);
+    crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^
+          t[4][lo >> 24] ^ t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+          t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+    p += 8;
+    size -= 8;
+  }
+  while (size--)
+    crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xff];
+  return ~crc;
+}
+
+#ifdef LLDB_CRC32_USE_PCLMUL
+#define LLDB_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+static inline __m128i Load128(const uint8_t *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+// Multiplies both halves of \a x by the matching constants in \a k, which
+// moves them 128 or 512 bits along, and adds in the \a next block.
+LLDB_CRC32_PCLMUL_TARGET static inline __m128i Fold128(__m128i x, __m128i k,
+                                                       __m128i next) {
+  __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+// Folds \a size bytes, a multiple of 16 and at least 64, into the CRC with
+// carry-less multiplication, four 128-bit lanes at a time, and then reduces
+// the result to 32 bits with a Barrett reduction. See Intel's "Fast CRC
+// Computation for Generic Polynomials Using PCLMULQDQ Instruction". \a crc is
+// the raw register value, i.e. without the pre- and post-inversion.
+LLDB_CRC32_PCLMUL_TARGET static uint32_t FoldCRC32(uint32_t crc,
+                                                   const uint8_t *p,
+                                                   size_t size) {
+  // x^(4*128+32) mod P and x^(4*128-32) mod P, for folding across 4 lanes.
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  // x^(128+32) mod P and x^(128-32) mod P, for folding across 1 lane.
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  // x^64 mod P, for folding 128 bits down to 64.
+  const __m128i k5 = _mm_set_epi64x(0, 0x0163cd6124);
+  // The polynomial and its Barrett constant floor(x^64 / P).
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  __m128i x1 = _mm_xor_si128(Load128(p), _mm_cvtsi32_si128(crc));
+  __m128i x2 = Load128(p + 16);
+  __m128i x3 = Load128(p + 32);
+  __m128i x4 = Load128(p + 48);
+  p += 64;
+  size -= 64;
+
+  while (size >= 64) {
+    x1 = Fold128(x1, k1k2, Load128(p));
+    x2 = Fold128(x2, k1k2, Load128(p + 16));
+    x3 = Fold128(x3, k1k2, Load128(p + 32));
+    x4 = Fold128(x4, k1k2, Load128(p + 48));
+    p += 64;
+    size -= 64;
+  }
+
+  x1 = Fold128(x1, k3k4, x2);
+  x1 = Fold128(x1, k3k4, x3);
+  x1 = Fold128(x1, k3k4, x4);
+  while (size >= 16) {
+    x1 = Fold128(x1, k3k4, Load128(p));
+    p += 16;
+    size -= 16;
+  }
+
+  // Fold 128 bits to 64.
+  __m128i t = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+  t = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5, 0x00), t);
+
+  // Barrett reduction to 32 bits.
+  t = _mm_and_si128(x1, mask32);
+  t = _mm_clmulepi64_si128(t, poly, 0x10);
+  t = _mm_and_si128(t, mask32);
+  t = _mm_clmulepi64_si128(t, poly, 0x00);
+  x1 = _mm_xor_si128(x1, t);
+  return _mm_extract_epi32(x1, 1);
+}
+
+static bool HostSupportsPCLMUL() {
+  static const bool g_supported = __builtin_cpu_supports("pclmul") &&
+                                  __builtin_cpu_supports("sse4.1");
+  return g_supported;
+}
+#endif
+
+uint32_t lldb_private::CalculateCRC32(uint32_t crc,
+                                      llvm::ArrayRef<uint8_t> data) {
+#ifdef LLDB_CRC32_USE_PCLMUL
+  if (data.size() >= 64 && HostSupportsPCLMUL()) {
+    const size_t folded = data.size() & ~size_t(15);
+    crc = ~FoldCRC32(~crc, data.data(), folded);
+    data = data.drop_front(folded);
+  }
+#endif
+  return CalculateCRC32Portable(crc, data);
+}
+
+// Returns a * b modulo the CRC polynomial, both operands being polynomials in
+// the CRC's reflected representation.
+static uint32_t MultiplyModPolynomial(uint32_t a, uint32_t b) {
+  uint32_t product = 0;
+  for (uint32_t m = uint32_t(1) << 31; m != 0; m >>= 1) {
+    if (a & m)
+      product ^= b;
+    b = (b & 1) ? (b >> 1) ^ g_crc32_polynomial : b >> 1;
+  }
+  return product;
+}
+
+uint32_t lldb_private::CombineCRC32(uint32_t crc_a, uint32_t crc_b,
+                                    uint64_t length_b) {
+  // Appending length_b bytes to A multiplies its CRC by x^(8 * length_b).
+  // Compute that power by squaring: power_of_x holds x^(2^k), starting at
+  // x^8, i.e. x^(2^3).
+  uint32_t shift = uint32_t(1) << 31; // x^0
+  uint32_t power_of_x = uint32_t(1) << 23; // x^8
+  for (; length_b != 0; length_b >>= 1) {
+    if (length_b & 1)
+      shift = MultiplyModPolynomial(power_of_x, shift);
+    power_of_x = MultiplyModPolynomial(power_of_x, power_of_x);
+  }
+  return MultiplyModPolynomial(shift, crc_a) ^ crc_b;
+}
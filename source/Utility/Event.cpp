@@ -16,6 +16,8 @@
 #include "lldb/lldb-enumerations.h"
 
 #include <algorithm>
+#include <mutex>
+#include <vector>
 
 #include <ctype.h>
 
@@ -44,6 +46,84 @@ Event::Event(uint32_t event_type, const EventDataSP &event_data_sp)
 
 Event::~Event() = default;
 
+namespace {
+// A free list of the memory blocks backing the events made by Event::Create.
+// std::allocate_shared always asks for blocks of the same size, which is
+// only known once the first event gets allocated.
+class EventPool {
+public:
+  static EventPool &Get() {
+    // Leaked on purpose, events can outlive static destructors.
+    static EventPool *g_pool = new EventPool();
+    return *g_pool;
+  }
+
+  void *Allocate(size_t size) {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_block_size == 0)
+        m_block_size = size;
+      if (size == m_block_size && !m_free_blocks.empty()) {
+        void *block = m_free_blocks.back();
+        m_free_blocks.pop_back();
+        return block;
+      }
+    }
+    return ::operator new(size);
+  }
+
+  void Deallocate(void *block, size_t size) {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (size == m_block_size && m_free_blocks.size() < g_max_free_blocks) {
+        m_free_blocks.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+private:
+  static constexpr size_t g_max_free_blocks = 1024;
+
+  std::mutex m_mutex;
+  size_t m_block_size = 0;
+  std::vector<void *> m_free_blocks;
+};
+
+template <typename T> struct EventAllocator {
+  typedef T value_type;
+
+  EventAllocator() = default;
+  template <typename U> EventAllocator(const EventAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(EventPool::Get().Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {
+    EventPool::Get().Deallocate(p, n * sizeof(T));
+  }
+
+  template <typename U> bool operator==(const EventAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const EventAllocator<U> &) const {
+    return false;
+  }
+};
+} // namespace
+
+EventSP Event::Create(uint32_t event_type, EventData *data) {
+  return std::allocate_shared<Event>(EventAllocator<Event>(), event_type,
+                                     data);
+}
+
+EventSP Event::Create(uint32_t event_type, const EventDataSP &event_data_sp) {
+  return std::allocate_shared<Event>(EventAllocator<Event>(), event_type,
+                                     event_data_sp);
+}
+
 void Event::Dump(Stream *s) const {
   Broadcaster *broadcaster;
   Broadcaster::BroadcasterImplSP broadcaster_impl_sp(m_broadcaster_wp.lock());
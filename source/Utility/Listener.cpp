@@ -39,7 +39,7 @@ public:
 
 Listener::Listener(const char *name)
     : m_name(name), m_broadcasters(), m_broadcasters_mutex(), m_events(),
-      m_events_mutex() {
+      m_events_mutex(), m_pending_events(nullptr), m_num_waiters(0) {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT));
   if (log != nullptr)
     LLDB_LOGF(log, "%p Listener::Listener('%s')", static_cast<void *>(this),
@@ -50,6 +50,8 @@ Listener::~Listener() {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT));
 
   Clear();
+  // A broadcaster may still have added an event while Clear() was running.
+  DiscardPendingEvents();
 
   LLDB_LOGF(log, "%p Listener::%s('%s')", static_cast<void *>(this),
             __FUNCTION__, m_name.c_str());
@@ -77,6 +79,10 @@ void Listener::Clear() {
       manager_sp->RemoveListener(this);
   }
 
+  // Only drop the pending events once no broadcaster knows about us anymore,
+  // so that the ones added while we were removing ourselves are freed too.
+  DiscardPendingEvents();
+
   LLDB_LOGF(log, "%p Listener::%s('%s')", static_cast<void *>(this),
             __FUNCTION__, m_name.c_str());
 }
@@ -174,6 +180,7 @@ void Listener::BroadcasterWillDestruct(Broadcaster *broadcaster) {
   // Scope for "event_locker"
   {
     std::lock_guard<std::mutex> events_guard(m_events_mutex);
+    MovePendingEvents();
     // Remove all events for this broadcaster object.
     event_collection::iterator pos = m_events.begin();
     while (pos != m_events.end()) {
@@ -206,9 +213,40 @@ void Listener::AddEvent(EventSP &event_sp) {
               static_cast<void *>(this), m_name.c_str(),
               static_cast<void *>(event_sp.get()));
 
-  std::lock_guard<std::mutex> guard(m_events_mutex);
-  m_events.push_back(event_sp);
-  m_events_condition.notify_all();
+  PendingEvent *pending = new PendingEvent{event_sp, nullptr};
+  PendingEvent *head = m_pending_events.load(std::memory_order_relaxed);
+  do {
+    pending->next = head;
+  } while (!m_pending_events.compare_exchange_weak(head, pending));
+
+  // Waiting threads take all pending events at once, so only the broadcaster
+  // that found the stack empty has to wake them up. Taking the mutex makes
+  // sure a thread that is about to wait doesn't miss the notification.
+  if (head == nullptr && m_num_waiters.load() != 0) {
+    std::lock_guard<std::mutex> guard(m_events_mutex);
+    m_events_condition.notify_all();
+  }
+}
+
+void Listener::MovePendingEvents() {
+  PendingEvent *pending = m_pending_events.exchange(nullptr);
+  // Insert each event in front of the one that was added after it.
+  event_collection::iterator pos = m_events.end();
+  while (pending) {
+    pos = m_events.insert(pos, std::move(pending->event_sp));
+    PendingEvent *next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
+void Listener::DiscardPendingEvents() {
+  PendingEvent *pending = m_pending_events.exchange(nullptr);
+  while (pending) {
+    PendingEvent *next = pending->next;
+    delete pending;
+    pending = next;
+  }
 }
 
 class EventBroadcasterMatches {
@@ -272,6 +310,7 @@ bool Listener::FindNextEventInternal(
   // recursive.
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EVENTS));
 
+  MovePendingEvents();
   if (m_events.empty())
     return false;
 
@@ -359,11 +398,20 @@ bool Listener::GetEventInternal(
                               true)) {
       return true;
     } else {
+      // Announce that we are waiting before checking for pending events one
+      // last time, so that any event added after the check wakes us up.
+      ++m_num_waiters;
+      if (m_pending_events.load() != nullptr) {
+        --m_num_waiters;
+        continue;
+      }
+
       std::cv_status result = std::cv_status::no_timeout;
       if (!timeout)
         m_events_condition.wait(lock);
       else
         result = m_events_condition.wait_for(lock, *timeout);
+      --m_num_waiters;
 
       if (result == std::cv_status::timeout) {
         log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EVENTS);
@@ -20,13 +20,20 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <assert.h>
 #if defined(_WIN32)
+#include <io.h>
 #include <process.h>
 #else
 #include <unistd.h>
@@ -37,6 +44,288 @@ using namespace lldb_private;
 
 llvm::ManagedStatic<Log::ChannelMap> Log::g_channel_map;
 
+// Set by the crash handler before it reads any ring buffer. From then on,
+// buffers that channels stop using are no longer freed.
+static std::atomic<bool> g_crash_dump_started{false};
+
+// Serializes the writes of logs with LLDB_LOG_OPTION_THREADSAFE.
+static std::recursive_mutex &GetThreadSafeMutex() {
+  static std::recursive_mutex g_LogThreadedMutex;
+  return g_LogThreadedMutex;
+}
+
+// A log message together with the information needed to write its header.
+// Capturing these values is cheap, so asynchronous logs leave formatting the
+// header to the writer thread.
+struct Log::Record {
+  std::shared_ptr<llvm::raw_ostream> stream_sp;
+  uint32_t options = 0;
+  // The number shown with LLDB_LOG_OPTION_PREPEND_SEQUENCE.
+  uint32_t sequence_id = 0;
+  // The order in which the messages of all channels were logged.
+  uint64_t order = 0;
+  std::chrono::system_clock::time_point time;
+  uint64_t thread_id = 0;
+  std::string message;
+};
+
+// Keeps the last bytes of the messages logged to a channel in flight recorder
+// mode, overwriting the oldest messages as it wraps around.
+class Log::RingBuffer {
+public:
+  explicit RingBuffer(size_t size) : m_data(size) {}
+
+  size_t GetSize() const { return m_data.size(); }
+
+  void Append(llvm::StringRef bytes) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const size_t size = m_data.size();
+    if (bytes.size() >= size) {
+      // Only the end of the message fits.
+      bytes = bytes.take_back(size);
+      std::copy(bytes.begin(), bytes.end(), m_data.begin());
+      m_pos = 0;
+      m_wrapped = true;
+      return;
+    }
+
+    size_t pos = m_pos.load(std::memory_order_relaxed);
+    const size_t head = std::min(bytes.size(), size - pos);
+    std::copy(bytes.begin(), bytes.begin() + head, m_data.begin() + pos);
+    pos += head;
+    if (pos == size) {
+      pos = 0;
+      m_wrapped = true;
+    }
+    bytes = bytes.drop_front(head);
+    std::copy(bytes.begin(), bytes.end(), m_data.begin() + pos);
+    m_pos = pos + bytes.size();
+  }
+
+  void Dump(llvm::raw_ostream &stream) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    llvm::StringRef older, newer;
+    GetContents(older, newer);
+    stream << older << newer;
+    stream.flush();
+  }
+
+  // Called from a signal handler, so this takes no locks and does not
+  // allocate. The buffer is dumped even if another thread might be in the
+  // middle of appending to it.
+  void DumpOnCrash(int fd) {
+    llvm::StringRef older, newer;
+    GetContents(older, newer);
+    WriteOnCrash(fd, older);
+    WriteOnCrash(fd, newer);
+  }
+
+  static void WriteOnCrash(int fd, llvm::StringRef bytes) {
+    while (!bytes.empty()) {
+#if defined(_WIN32)
+      int written = ::_write(fd, bytes.data(), bytes.size());
+#else
+      ssize_t written = ::write(fd, bytes.data(), bytes.size());
+#endif
+      if (written < 0 && errno == EINTR)
+        continue;
+      if (written <= 0)
+        return;
+      bytes = bytes.drop_front(written);
+    }
+  }
+
+private:
+  // Returns the buffered messages, oldest first, in two pieces.
+  void GetContents(llvm::StringRef &older, llvm::StringRef &newer) const {
+    const size_t pos = m_pos.load(std::memory_order_relaxed);
+    const bool wrapped = m_wrapped.load(std::memory_order_relaxed);
+    llvm::StringRef data(m_data.data(), m_data.size());
+    older = wrapped ? data.drop_front(pos) : "";
+    newer = data.take_front(pos);
+    if (wrapped) {
+      // Skip what is left of the message that was partially overwritten.
+      size_t newline = older.find('\n');
+      if (newline != llvm::StringRef::npos) {
+        older = older.drop_front(newline + 1);
+      } else {
+        older = "";
+        newline = newer.find('\n');
+        newer = newline == llvm::StringRef::npos
+                    ? ""
+                    : newer.drop_front(newline + 1);
+      }
+    }
+  }
+
+  std::mutex m_mutex;
+  std::vector<char> m_data;
+  // Atomic so that the crash handler can read them without the mutex.
+  std::atomic<size_t> m_pos{0};
+  std::atomic<bool> m_wrapped{false};
+};
+
+// Writes the messages of logs with LLDB_LOG_OPTION_ASYNC on a thread of its
+// own. Every logging thread hands its messages over through a queue of its
+// own, which it can add to without taking any locks.
+class Log::AsyncWriter {
+public:
+  static AsyncWriter &Get() {
+    // Leaked on purpose, messages can be logged during static destruction.
+    static AsyncWriter *g_writer = new AsyncWriter();
+    return *g_writer;
+  }
+
+  void Enqueue(Record &&record) {
+    ThreadQueue &queue = GetThreadQueue();
+    // Rather than dropping messages, let the writer catch up if it is behind.
+    while (!queue.TryPush(record)) {
+      Wake();
+      std::this_thread::yield();
+    }
+    Wake();
+  }
+
+  // Write out all queued messages on the calling thread.
+  void Flush() {
+    std::lock_guard<std::mutex> drain_guard(m_drain_mutex);
+
+    std::vector<std::shared_ptr<ThreadQueue>> queues;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      queues = m_queues;
+    }
+
+    // Gather the messages of all threads and write them in the order they
+    // were logged, batching the writes to each stream.
+    std::vector<std::pair<Record, llvm::StringRef>> records;
+    for (const auto &queue_sp : queues)
+      queue_sp->PopAll([&](Record &record) {
+        records.emplace_back(std::move(record), queue_sp->thread_name);
+      });
+    llvm::sort(records, [](const std::pair<Record, llvm::StringRef> &lhs,
+                           const std::pair<Record, llvm::StringRef> &rhs) {
+      return lhs.first.order < rhs.first.order;
+    });
+
+    std::vector<std::pair<Record *, std::string>> batches;
+    for (auto &entry : records) {
+      Record &record = entry.first;
+      auto batch = llvm::find_if(
+          batches, [&](const std::pair<Record *, std::string> &batch) {
+            return batch.first->stream_sp == record.stream_sp;
+          });
+      if (batch == batches.end())
+        batch = batches.insert(batches.end(), {&record, std::string()});
+      llvm::raw_string_ostream OS(batch->second);
+      WriteHeader(OS, record, entry.second);
+      OS << record.message;
+    }
+    for (auto &batch : batches) {
+      Flags options(batch.first->options);
+      std::unique_lock<std::recursive_mutex> lock(GetThreadSafeMutex(),
+                                                  std::defer_lock);
+      if (options.Test(LLDB_LOG_OPTION_THREADSAFE))
+        lock.lock();
+      *batch.first->stream_sp << batch.second;
+      batch.first->stream_sp->flush();
+    }
+
+    // Forget the queues of threads that have exited once they are empty.
+    queues.clear();
+    std::lock_guard<std::mutex> guard(m_mutex);
+    llvm::erase_if(m_queues, [](const std::shared_ptr<ThreadQueue> &queue_sp) {
+      return queue_sp.use_count() == 1 && queue_sp->IsEmpty();
+    });
+  }
+
+private:
+  // A single producer, single consumer queue. The logging thread pushes, and
+  // whichever thread holds m_drain_mutex pops.
+  class ThreadQueue {
+  public:
+    static constexpr size_t g_capacity = 256;
+
+    bool TryPush(Record &record) {
+      const size_t tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_head.load(std::memory_order_acquire) == g_capacity)
+        return false;
+      m_records[tail % g_capacity] = std::move(record);
+      m_tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    template <typename Callback> void PopAll(Callback callback) {
+      const size_t head = m_head.load(std::memory_order_relaxed);
+      const size_t tail = m_tail.load(std::memory_order_acquire);
+      for (size_t i = head; i != tail; ++i)
+        callback(m_records[i % g_capacity]);
+      m_head.store(tail, std::memory_order_release);
+    }
+
+    bool IsEmpty() const {
+      return m_head.load(std::memory_order_acquire) ==
+             m_tail.load(std::memory_order_acquire);
+    }
+
+    std::string thread_name;
+
+  private:
+    std::array<Record, g_capacity> m_records;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+  };
+
+  AsyncWriter() = default;
+
+  ThreadQueue &GetThreadQueue() {
+    static thread_local std::shared_ptr<ThreadQueue> t_queue_sp;
+    if (!t_queue_sp) {
+      t_queue_sp = std::make_shared<ThreadQueue>();
+      llvm::SmallString<32> thread_name;
+      llvm::get_thread_name(thread_name);
+      t_queue_sp->thread_name = thread_name.str();
+
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_queues.push_back(t_queue_sp);
+      if (!m_thread_started) {
+        m_thread_started = true;
+        std::thread(&AsyncWriter::WriterThread, this).detach();
+      }
+    }
+    return *t_queue_sp;
+  }
+
+  // Only the first message logged after the writer started draining the
+  // queues needs to take the mutex and wake it up.
+  void Wake() {
+    if (!m_pending.exchange(true)) {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_condition.notify_one();
+    }
+  }
+
+  void WriterThread() {
+    llvm::set_thread_name("lldb.log.writer");
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_pending.load(); });
+      }
+      m_pending = false;
+      Flush();
+    }
+  }
+
+  std::mutex m_mutex; // Protects m_queues and m_thread_started.
+  std::vector<std::shared_ptr<ThreadQueue>> m_queues;
+  bool m_thread_started = false;
+  std::condition_variable m_condition;
+  std::atomic<bool> m_pending{false};
+  // Only one thread at a time may pop messages off the queues.
+  std::mutex m_drain_mutex;
+};
+
 void Log::ForEachCategory(
     const Log::ChannelMap::value_type &entry,
     llvm::function_ref<void(llvm::StringRef, llvm::StringRef)> lambda) {
@@ -85,27 +374,55 @@ uint32_t Log::GetFlags(llvm::raw_ostream &stream, const ChannelMap::value_type &
 }
 
 void Log::Enable(const std::shared_ptr<llvm::raw_ostream> &stream_sp,
-                 uint32_t options, uint32_t flags) {
+                 uint32_t options, uint32_t flags, size_t buffer_size) {
   llvm::sys::ScopedWriter lock(m_mutex);
 
   uint32_t mask = m_mask.fetch_or(flags, std::memory_order_relaxed);
   if (mask | flags) {
     m_options.store(options, std::memory_order_relaxed);
     m_stream_sp = stream_sp;
+    if (buffer_size == 0) {
+      SetRingBuffer(nullptr);
+    } else if (!m_ring_buffer_sp ||
+               m_ring_buffer_sp->GetSize() != buffer_size) {
+      static std::once_flag g_once_flag;
+      std::call_once(g_once_flag, [] {
+        llvm::sys::AddSignalHandler(&Log::DumpRingBuffersOnCrash, nullptr);
+      });
+      SetRingBuffer(std::make_shared<RingBuffer>(buffer_size));
+    }
     m_channel.log_ptr.store(this, std::memory_order_relaxed);
   }
 }
 
 void Log::Disable(uint32_t flags) {
+  // Write out what was logged before the log got disabled.
+  if (GetOptions().Test(LLDB_LOG_OPTION_ASYNC))
+    AsyncWriter::Get().Flush();
+
   llvm::sys::ScopedWriter lock(m_mutex);
 
   uint32_t mask = m_mask.fetch_and(~flags, std::memory_order_relaxed);
   if (!(mask & ~flags)) {
     m_stream_sp.reset();
+    SetRingBuffer(nullptr);
     m_channel.log_ptr.store(nullptr, std::memory_order_relaxed);
   }
 }
 
+void Log::SetRingBuffer(std::shared_ptr<RingBuffer> ring_buffer_sp) {
+  std::shared_ptr<RingBuffer> old_ring_buffer_sp = std::move(m_ring_buffer_sp);
+  m_ring_buffer_sp = std::move(ring_buffer_sp);
+  m_crash_ring_buffer.store(m_ring_buffer_sp.get());
+
+  // A crash dump that starts after the store above only sees the new buffer,
+  // so the old one can be freed unless a dump had already started and may be
+  // reading it. Both accesses are sequentially consistent to order them with
+  // the ones in DumpRingBuffersOnCrash.
+  if (old_ring_buffer_sp && g_crash_dump_started.load())
+    m_crash_retired_ring_buffers.push_back(std::move(old_ring_buffer_sp));
+}
+
 const Flags Log::GetOptions() const {
   return m_options.load(std::memory_order_relaxed);
 }
@@ -129,16 +446,16 @@ void Log::Printf(const char *format, ...) {
 // callback registered, then we call the logging callback. If we have a valid
 // file handle, we also log to the file.
 void Log::VAPrintf(const char *format, va_list args) {
-  llvm::SmallString<64> FinalMessage;
-  llvm::raw_svector_ostream Stream(FinalMessage);
-  WriteHeader(Stream, "", "");
+  std::string FinalMessage;
+  llvm::raw_string_ostream Stream(FinalMessage);
+  WriteLocation(Stream, "", "");
 
   llvm::SmallString<64> Content;
   lldb_private::VASprintf(Content, format, args);
 
   Stream << Content << "\n";
 
-  WriteMessage(FinalMessage.str());
+  WriteMessage(std::move(Stream.str()));
 }
 
 // Printing of errors that are not fatal.
@@ -201,7 +518,8 @@ void Log::Unregister(llvm::StringRef name) {
 bool Log::EnableLogChannel(
     const std::shared_ptr<llvm::raw_ostream> &log_stream_sp,
     uint32_t log_options, llvm::StringRef channel,
-    llvm::ArrayRef<const char *> categories, llvm::raw_ostream &error_stream) {
+    llvm::ArrayRef<const char *> categories, llvm::raw_ostream &error_stream,
+    size_t buffer_size) {
   auto iter = g_channel_map->find(channel);
   if (iter == g_channel_map->end()) {
     error_stream << llvm::formatv("Invalid log channel '{0}'.\n", channel);
@@ -210,7 +528,7 @@ bool Log::EnableLogChannel(
   uint32_t flags = categories.empty()
                        ? iter->second.m_channel.default_flags
                        : GetFlags(error_stream, *iter, categories);
-  iter->second.Enable(log_stream_sp, log_options, flags);
+  iter->second.Enable(log_stream_sp, log_options, flags, buffer_size);
   return true;
 }
 
@@ -240,6 +558,30 @@ bool Log::ListChannelCategories(llvm::StringRef channel,
   return true;
 }
 
+bool Log::DumpLogChannel(llvm::StringRef channel,
+                         llvm::raw_ostream &output_stream,
+                         llvm::raw_ostream &error_stream) {
+  auto ch = g_channel_map->find(channel);
+  if (ch == g_channel_map->end()) {
+    error_stream << llvm::formatv("Invalid log channel '{0}'.\n", channel);
+    return false;
+  }
+  std::shared_ptr<RingBuffer> ring_buffer_sp;
+  {
+    llvm::sys::ScopedReader lock(ch->second.m_mutex);
+    ring_buffer_sp = ch->second.m_ring_buffer_sp;
+  }
+  if (!ring_buffer_sp) {
+    error_stream << llvm::formatv(
+        "Log channel '{0}' is not logging to a buffer.\n", channel);
+    return false;
+  }
+  ring_buffer_sp->Dump(output_stream);
+  return true;
+}
+
+void Log::FlushAsyncMessages() { AsyncWriter::Get().Flush(); }
+
 void Log::DisableAllLogChannels() {
   for (auto &entry : *g_channel_map)
     entry.second.Disable(UINT32_MAX);
@@ -276,37 +618,36 @@ bool Log::GetVerbose() const {
   return m_options.load(std::memory_order_relaxed) & LLDB_LOG_OPTION_VERBOSE;
 }
 
-void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
-                      llvm::StringRef function) {
-  Flags options = GetOptions();
-  static uint32_t g_sequence_id = 0;
+void Log::WriteHeader(llvm::raw_ostream &OS, const Record &record,
+                      llvm::StringRef thread_name) {
+  Flags options(record.options);
   // Add a sequence ID if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_SEQUENCE))
-    OS << ++g_sequence_id << " ";
+    OS << record.sequence_id << " ";
 
   // Timestamp if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_TIMESTAMP)) {
-    auto now = std::chrono::duration<double>(
-        std::chrono::system_clock::now().time_since_epoch());
+    auto now =
+        std::chrono::duration<double>(record.time.time_since_epoch());
     OS << llvm::formatv("{0:f9} ", now.count());
   }
 
   // Add the process and thread if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD))
-    OS << llvm::formatv("[{0,0+4}/{1,0+4}] ", getpid(),
-                        llvm::get_threadid());
+    OS << llvm::formatv("[{0,0+4}/{1,0+4}] ", getpid(), record.thread_id);
 
   // Add the thread name if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_THREAD_NAME)) {
-    llvm::SmallString<32> thread_name;
-    llvm::get_thread_name(thread_name);
-
     llvm::SmallString<12> format_str;
     llvm::raw_svector_ostream format_os(format_str);
     format_os << "{0,-" << llvm::alignTo<16>(thread_name.size()) << "} ";
     OS << llvm::formatv(format_str.c_str(), thread_name);
   }
+}
 
+void Log::WriteLocation(llvm::raw_ostream &OS, llvm::StringRef file,
+                        llvm::StringRef function) {
+  Flags options = GetOptions();
   if (options.Test(LLDB_LOG_OPTION_BACKTRACE))
     llvm::sys::PrintStackTrace(OS);
 
@@ -318,21 +659,57 @@ void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
   }
 }
 
-void Log::WriteMessage(const std::string &message) {
+void Log::WriteMessage(std::string message) {
   // Make a copy of our stream shared pointer in case someone disables our log
   // while we are logging and releases the stream
-  auto stream_sp = GetStream();
-  if (!stream_sp)
+  std::shared_ptr<llvm::raw_ostream> stream_sp;
+  std::shared_ptr<RingBuffer> ring_buffer_sp;
+  {
+    llvm::sys::ScopedReader lock(m_mutex);
+    stream_sp = m_stream_sp;
+    ring_buffer_sp = m_ring_buffer_sp;
+  }
+  if (!stream_sp && !ring_buffer_sp)
     return;
 
-  Flags options = GetOptions();
+  static std::atomic<uint32_t> g_sequence_id(0);
+  static std::atomic<uint64_t> g_order(0);
+  Record record;
+  record.options = GetOptions().Get();
+  Flags options(record.options);
+  if (options.Test(LLDB_LOG_OPTION_PREPEND_SEQUENCE))
+    record.sequence_id = ++g_sequence_id;
+  record.order = g_order++;
+  record.time = std::chrono::system_clock::now();
+  record.thread_id = llvm::get_threadid();
+
+  if (options.Test(LLDB_LOG_OPTION_ASYNC) && !ring_buffer_sp) {
+    record.stream_sp = std::move(stream_sp);
+    record.message = std::move(message);
+    AsyncWriter::Get().Enqueue(std::move(record));
+    return;
+  }
+
+  llvm::SmallString<32> thread_name;
+  if (options.Test(LLDB_LOG_OPTION_PREPEND_THREAD_NAME))
+    llvm::get_thread_name(thread_name);
+  std::string final_message;
+  llvm::raw_string_ostream OS(final_message);
+  WriteHeader(OS, record, thread_name);
+  OS << message;
+  OS.flush();
+
+  if (ring_buffer_sp) {
+    ring_buffer_sp->Append(final_message);
+    return;
+  }
+
   if (options.Test(LLDB_LOG_OPTION_THREADSAFE)) {
-    static std::recursive_mutex g_LogThreadedMutex;
-    std::lock_guard<std::recursive_mutex> guard(g_LogThreadedMutex);
-    *stream_sp << message;
+    std::lock_guard<std::recursive_mutex> guard(GetThreadSafeMutex());
+    *stream_sp << final_message;
     stream_sp->flush();
   } else {
-    *stream_sp << message;
+    *stream_sp << final_message;
     stream_sp->flush();
   }
 }
@@ -341,9 +718,9 @@ void Log::Format(llvm::StringRef file, llvm::StringRef function,
                  const llvm::formatv_object_base &payload) {
   std::string message_string;
   llvm::raw_string_ostream message(message_string);
-  WriteHeader(message, file, function);
+  WriteLocation(message, file, function);
   message << payload << "\n";
-  WriteMessage(message.str());
+  WriteMessage(std::move(message.str()));
 }
 
 void Log::DisableLoggingChild() {
@@ -353,3 +730,17 @@ void Log::DisableLoggingChild() {
   for (auto &c: *g_channel_map)
     c.second.m_channel.log_ptr.store(nullptr, std::memory_order_relaxed);
 }
+
+void Log::DumpRingBuffersOnCrash(void *) {
+  g_crash_dump_started.store(true);
+  const int fd = 2;
+  for (auto &entry : *g_channel_map) {
+    RingBuffer *ring_buffer = entry.second.m_crash_ring_buffer.load();
+    if (!ring_buffer)
+      continue;
+    RingBuffer::WriteOnCrash(fd, "--- Last messages of log channel '");
+    RingBuffer::WriteOnCrash(fd, entry.first());
+    RingBuffer::WriteOnCrash(fd, "' ---\n");
+    ring_buffer->DumpOnCrash(fd);
+  }
+}
@@ -15,17 +15,182 @@ using namespace lldb_private;
 RegularExpression::RegularExpression(llvm::StringRef str)
     : m_regex_text(str),
       // m_regex does not reference str anymore after it is constructed.
-      m_regex(llvm::Regex(str)) {}
+      m_regex(llvm::Regex(str)) {
+  if (IsValid())
+    AnalyzeLiterals();
+}
 
 RegularExpression::RegularExpression(const RegularExpression &rhs)
     : RegularExpression(rhs.GetText()) {}
 
+void RegularExpression::AnalyzeLiterals() {
+  llvm::StringRef text = m_regex_text;
+
+  // Anything that may make a part of the expression optional, other than a
+  // quantifier right after a literal character, makes us give up.
+  if (text.find('|') != llvm::StringRef::npos)
+    return;
+
+  const bool anchored_start = text.consume_front("^");
+  bool anchored_end = false;
+
+  // The literal runs of the expression, and whether the whole expression is
+  // a single run.
+  std::string run;
+  std::string longest_run;
+  bool only_literals = true;
+  auto end_run = [&]() {
+    if (run.size() > longest_run.size())
+      longest_run = run;
+    run.clear();
+  };
+
+  int depth = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    const char c = text[i];
+    switch (c) {
+    case '\\':
+      if (i + 1 < text.size() &&
+          llvm::StringRef(".[](){}|*+?^$\\").contains(text[i + 1])) {
+        if (depth == 0)
+          run += text[++i];
+        else
+          ++i;
+        continue;
+      }
+      return;
+    case '$':
+      if (i + 1 == text.size() && depth == 0) {
+        anchored_end = true;
+        continue;
+      }
+      only_literals = false;
+      end_run();
+      continue;
+    case '*':
+    case '?':
+    case '{':
+      // The preceding character may not be there at all.
+      if (!run.empty())
+        run.pop_back();
+      only_literals = false;
+      end_run();
+      if (c == '{') {
+        i = text.find('}', i);
+        if (i == llvm::StringRef::npos)
+          return;
+      }
+      continue;
+    case '+':
+      // The preceding character is there, but may be followed by more of it.
+      only_literals = false;
+      end_run();
+      continue;
+    case '(':
+      // Whether a group is required depends on what follows it, so only runs
+      // outside of groups count.
+      only_literals = false;
+      end_run();
+      ++depth;
+      continue;
+    case ')':
+      if (depth == 0)
+        return;
+      --depth;
+      continue;
+    case '}':
+      return;
+    case '[': {
+      only_literals = false;
+      end_run();
+      // Skip the bracket expression. A ']' right after the opening '[' or
+      // '[^' is part of it.
+      size_t j = i + 1;
+      if (j < text.size() && text[j] == '^')
+        ++j;
+      if (j < text.size() && text[j] == ']')
+        ++j;
+      while (j < text.size() && text[j] != ']') {
+        if (text[j] == '[' && j + 1 < text.size() &&
+            llvm::StringRef(":.=").contains(text[j + 1])) {
+          // Skip a character class like [:alpha:].
+          const char delimiter[] = {text[j + 1], ']', '\0'};
+          j = text.find(delimiter, j + 2);
+          if (j == llvm::StringRef::npos)
+            return;
+          ++j;
+        }
+        ++j;
+      }
+      if (j >= text.size())
+        return;
+      i = j;
+      continue;
+    }
+    case '.':
+    case '^':
+      only_literals = false;
+      end_run();
+      continue;
+    default:
+      if (depth == 0)
+        run += c;
+      continue;
+    }
+  }
+  if (depth != 0)
+    return;
+  end_run();
+  m_required_substring = longest_run;
+
+  if (!only_literals || m_required_substring.empty())
+    return;
+  if (anchored_start && anchored_end)
+    m_literal_match = LiteralMatch::Exact;
+  else if (anchored_start)
+    m_literal_match = LiteralMatch::Prefix;
+  else if (anchored_end)
+    m_literal_match = LiteralMatch::Suffix;
+  else
+    m_literal_match = LiteralMatch::Substring;
+}
+
 bool RegularExpression::Execute(
     llvm::StringRef str,
     llvm::SmallVectorImpl<llvm::StringRef> *matches) const {
   if (!IsValid())
     return false;
-  return m_regex.match(str, matches);
+
+  const llvm::StringRef literal = m_required_substring;
+  size_t pos = llvm::StringRef::npos;
+  switch (m_literal_match) {
+  case LiteralMatch::None:
+    if (str.find(literal) == llvm::StringRef::npos)
+      return false;
+    return m_regex.match(str, matches);
+  case LiteralMatch::Substring:
+    pos = str.find(literal);
+    break;
+  case LiteralMatch::Prefix:
+    if (str.startswith(literal))
+      pos = 0;
+    break;
+  case LiteralMatch::Suffix:
+    if (str.endswith(literal))
+      pos = str.size() - literal.size();
+    break;
+  case LiteralMatch::Exact:
+    if (str == literal)
+      pos = 0;
+    break;
+  }
+  if (pos == llvm::StringRef::npos)
+    return false;
+  if (matches) {
+    matches->clear();
+    matches->push_back(str.substr(pos, literal.size()));
+  }
+  return true;
 }
 
 bool RegularExpression::IsValid() const { return m_regex.isValid(); }
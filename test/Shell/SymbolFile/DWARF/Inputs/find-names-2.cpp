@@ -0,0 +1,4 @@
+struct Bar {
+  int x;
+};
+Bar g_bar;
@@ -0,0 +1,96 @@
+# Test that file:line breakpoints are set in every compile unit that refers to
+# the file, when several units have files with the same base name, and that
+# the index of compile units by file name is restored from the symbol cache.
+# The objects are built from this file, one compile unit each.
+
+# REQUIRES: lld, x86
+
+# RUN: llvm-mc -triple x86_64-pc-linux %s -filetype=obj --defsym CU=1 > %t-1.o
+# RUN: llvm-mc -triple x86_64-pc-linux %s -filetype=obj --defsym CU=2 > %t-2.o
+# RUN: llvm-mc -triple x86_64-pc-linux %s -filetype=obj --defsym CU=3 > %t-3.o
+# RUN: ld.lld %t-1.o %t-2.o %t-3.o -o %t --build-id -z separate-code
+# RUN: rm -rf %t.cache
+# RUN: %lldb -b -o "settings set symbols.symbol-cache-path %t.cache" \
+# RUN:   -s %S/Inputs/file-to-cu-index.lldbinit %t | FileCheck %s
+# RUN: ls %t.cache/.cache/*/ | FileCheck --check-prefix=ENTRY %s
+# RUN: %lldb -b -o "settings set symbols.symbol-cache-path %t.cache" \
+# RUN:   -s %S/Inputs/file-to-cu-index.lldbinit %t | FileCheck %s
+
+# CHECK-LABEL: breakpoint set -f a.c -l 1
+# CHECK: Breakpoint 1: 2 locations.
+
+# CHECK-LABEL: breakpoint set -f /tmp/two/a.c -l 1
+# CHECK: Breakpoint 2: {{.*}}`two,
+
+# CHECK-LABEL: breakpoint set -f Foo.c -l 1
+# CHECK: Breakpoint 3: {{.*}}`three,
+
+# CHECK-LABEL: breakpoint list -f
+# CHECK: 1: file = 'a.c', line = 1, exact_match = 0, locations = 2
+# CHECK: 1.1: {{.*}}`_start
+# CHECK: 1.2: {{.*}}`two
+
+# ENTRY: file-to-cu-index.s.tmp.cufiles
+
+	.text
+.if CU == 1
+	.globl	_start
+_start:
+	.file	1 "/tmp/one/a.c"
+.elseif CU == 2
+	.globl	two
+two:
+	.file	1 "/tmp/two/a.c"
+.else
+	.globl	three
+three:
+	.file	1 "C:\\tmp\\Foo.c"
+.endif
+	.loc	1 1 0
+	nop
+
+	.section	.debug_str,"MS",@progbits,1
+.Linfo_string1:
+.if CU == 1
+	.asciz	"a.c"
+.Linfo_string2:
+	.asciz	"/tmp/one"
+.elseif CU == 2
+	.asciz	"a.c"
+.Linfo_string2:
+	.asciz	"/tmp/two"
+.else
+	.asciz	"Foo.c"
+.Linfo_string2:
+	.asciz	"C:\\tmp"
+.endif
+	.section	.debug_abbrev,"",@progbits
+	.byte	1                       # Abbreviation Code
+	.byte	17                      # DW_TAG_compile_unit
+	.byte	0                       # DW_CHILDREN_no
+	.byte	19                      # DW_AT_language
+	.byte	5                       # DW_FORM_data2
+	.byte	3                       # DW_AT_name
+	.byte	14                      # DW_FORM_strp
+	.byte	16                      # DW_AT_stmt_list
+	.byte	23                      # DW_FORM_sec_offset
+	.byte	27                      # DW_AT_comp_dir
+	.byte	14                      # DW_FORM_strp
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	0                       # EOM(3)
+	.section	.debug_info,"",@progbits
+.Lcu_begin0:
+	.long	.Lcu_end0-.Lcu_start0   # Length of Unit
+.Lcu_start0:
+	.short	4                       # DWARF version number
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.byte	8                       # Address Size (in bytes)
+	.byte	1                       # Abbrev [1] DW_TAG_compile_unit
+	.short	12                      # DW_AT_language
+	.long	.Linfo_string1          # DW_AT_name
+	.long	.Lline_table_start0     # DW_AT_stmt_list
+	.long	.Linfo_string2          # DW_AT_comp_dir
+.Lcu_end0:
+	.section	.debug_line,"",@progbits
+.Lline_table_start0:
@@ -0,0 +1,62 @@
+// Test the bulk name lookup of the DWARF indexes, and that preloading names
+// only extracts the units defining them.
+
+// REQUIRES: lld
+
+// RUN: %clang -g -c -o %t-1.o --target=x86_64-pc-linux -mllvm -accel-tables=Disable %s
+// RUN: %clang -g -c -o %t-2.o --target=x86_64-pc-linux -mllvm -accel-tables=Disable %S/Inputs/find-names-2.cpp
+// RUN: ld.lld %t-1.o %t-2.o -o %t
+// RUN: lldb-test symbols --name=ns,Foo,foo,g_foo,not_there --find=names %t | \
+// RUN:   FileCheck --check-prefixes=ONE,NAMES %s
+// RUN: lldb-test symbols --name=Bar --find=names %t | \
+// RUN:   FileCheck --check-prefix=TWO %s
+
+// Only the unqualified names of an expression are preloaded. Qualifiers,
+// the names they qualify and members are not.
+// RUN: %lldb -b -o "settings set target.preload-expression-names true" \
+// RUN:   -o "log enable lldb expr" \
+// RUN:   -o "expr sizeof(ns::Foo) + sizeof(g_bar.x) + sizeof(g_bar)" %t \
+// RUN:   | FileCheck --check-prefix=EXPR %s
+
+// RUN: %clang -g -c -o %t-1.o --target=x86_64-pc-linux -mllvm -accel-tables=Dwarf %s
+// RUN: %clang -g -c -o %t-2.o --target=x86_64-pc-linux -mllvm -accel-tables=Dwarf %S/Inputs/find-names-2.cpp
+// RUN: ld.lld %t-1.o %t-2.o -o %t
+// RUN: lldb-test symbols --name=ns,Foo,foo,g_foo,not_there --find=names %t | \
+// RUN:   FileCheck --check-prefixes=ONE,NAMES %s
+// RUN: lldb-test symbols --name=Bar --find=names %t | \
+// RUN:   FileCheck --check-prefix=TWO %s
+
+// RUN: %clang %s -g -c -o %t --target=x86_64-apple-macosx
+// RUN: lldb-test symbols --name=ns,Foo,foo,g_foo,not_there --find=names %t | \
+// RUN:   FileCheck --check-prefixes=ONE,NAMES %s
+
+// ONE: Extracted unit: {{.*}}find-names.cpp
+// ONE-NOT: Extracted unit
+
+// NAMES: Found {{[1-9][0-9]*}} DIEs for Foo:
+// NAMES-NEXT: DW_TAG_structure_type
+// NAMES: Found {{[1-9][0-9]*}} DIEs for foo:
+// NAMES-NEXT: DW_TAG_subprogram
+// NAMES: Found {{[1-9][0-9]*}} DIEs for g_foo:
+// NAMES-NEXT: DW_TAG_variable
+// NAMES: Found 0 DIEs for not_there:
+// NAMES-NEXT: Found {{[1-9][0-9]*}} DIEs for ns:
+// NAMES-NEXT: DW_TAG_namespace
+
+// TWO: Extracted unit: {{.*}}find-names-2.cpp
+// TWO-NOT: Extracted unit
+// TWO: Found {{[1-9][0-9]*}} DIEs for Bar:
+// TWO-NEXT: DW_TAG_structure_type
+
+// EXPR: CEDM::PreloadNames preloading 'g_bar'
+// EXPR-NOT: CEDM::PreloadNames preloading
+
+namespace ns {
+struct Foo {
+  int method();
+};
+int Foo::method() { return 0; }
+int g_foo;
+} // namespace ns
+
+int foo() { return 0; }
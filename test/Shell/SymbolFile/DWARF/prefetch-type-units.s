@@ -0,0 +1,255 @@
+# Test that completing a type extracts the units that the types it completes
+# along the way are defined in as one batch. A holds B, a typedef of C, D and
+# F by value, and D holds E. Each of B, C and E is defined in a unit of its
+# own, F in a type unit whose signature doesn't fit in 32 bits. The
+# completions of B, C, D, E and F, which happen while completing A, don't
+# prefetch anything themselves.
+
+# REQUIRES: lld, x86
+
+# RUN: llvm-mc -triple x86_64-pc-linux %s -filetype=obj > %t.o
+# RUN: ld.lld %t.o -o %t
+# RUN: %lldb -b -o "log enable dwarf comp" -o "type lookup A" %t | FileCheck %s
+
+# CHECK-NOT: Prefetching
+# CHECK: Prefetching 4 units to complete 'A'
+# CHECK-NOT: Prefetching
+# CHECK: struct A {
+# CHECK-NEXT: B b;
+# CHECK-NEXT: T c;
+# CHECK-NEXT: D d;
+# CHECK-NEXT: F f;
+# CHECK-NEXT: }
+
+	.section	.debug_abbrev,"",@progbits
+	.byte	1                       # Abbreviation Code
+	.byte	17                      # DW_TAG_compile_unit
+	.byte	1                       # DW_CHILDREN_yes
+	.byte	19                      # DW_AT_language
+	.byte	5                       # DW_FORM_data2
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	2                       # Abbreviation Code
+	.byte	19                      # DW_TAG_structure_type
+	.byte	1                       # DW_CHILDREN_yes
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	11                      # DW_AT_byte_size
+	.byte	11                      # DW_FORM_data1
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	3                       # Abbreviation Code
+	.byte	13                      # DW_TAG_member
+	.byte	0                       # DW_CHILDREN_no
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	73                      # DW_AT_type
+	.byte	19                      # DW_FORM_ref4
+	.byte	56                      # DW_AT_data_member_location
+	.byte	11                      # DW_FORM_data1
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	4                       # Abbreviation Code
+	.byte	13                      # DW_TAG_member
+	.byte	0                       # DW_CHILDREN_no
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	73                      # DW_AT_type
+	.byte	16                      # DW_FORM_ref_addr
+	.byte	56                      # DW_AT_data_member_location
+	.byte	11                      # DW_FORM_data1
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	5                       # Abbreviation Code
+	.byte	36                      # DW_TAG_base_type
+	.byte	0                       # DW_CHILDREN_no
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	62                      # DW_AT_encoding
+	.byte	11                      # DW_FORM_data1
+	.byte	11                      # DW_AT_byte_size
+	.byte	11                      # DW_FORM_data1
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	6                       # Abbreviation Code
+	.byte	22                      # DW_TAG_typedef
+	.byte	0                       # DW_CHILDREN_no
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	73                      # DW_AT_type
+	.byte	16                      # DW_FORM_ref_addr
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	7                       # Abbreviation Code
+	.byte	13                      # DW_TAG_member
+	.byte	0                       # DW_CHILDREN_no
+	.byte	3                       # DW_AT_name
+	.byte	8                       # DW_FORM_string
+	.byte	73                      # DW_AT_type
+	.byte	32                      # DW_FORM_ref_sig8
+	.byte	56                      # DW_AT_data_member_location
+	.byte	11                      # DW_FORM_data1
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	8                       # Abbreviation Code
+	.byte	65                      # DW_TAG_type_unit
+	.byte	1                       # DW_CHILDREN_yes
+	.byte	19                      # DW_AT_language
+	.byte	5                       # DW_FORM_data2
+	.byte	0                       # EOM(1)
+	.byte	0                       # EOM(2)
+	.byte	0                       # EOM(3)
+
+	.section	.debug_info,"",@progbits
+.Lcu_begin0:
+	.long	.Lcu_end0-.Lcu_start0   # Length of Unit
+.Lcu_start0:
+	.short	4                       # DWARF version number
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.byte	8                       # Address Size (in bytes)
+	.byte	1                       # Abbrev [1] DW_TAG_compile_unit
+	.short	4                       # DW_AT_language
+	.asciz	"a.cpp"                 # DW_AT_name
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"A"                     # DW_AT_name
+	.byte	16                      # DW_AT_byte_size
+	.byte	4                       # Abbrev [4] DW_TAG_member
+	.asciz	"b"                     # DW_AT_name
+	.long	.LB                     # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"c"                     # DW_AT_name
+	.long	.LT-.Lcu_begin0         # DW_AT_type
+	.byte	4                       # DW_AT_data_member_location
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"d"                     # DW_AT_name
+	.long	.LD-.Lcu_begin0         # DW_AT_type
+	.byte	8                       # DW_AT_data_member_location
+	.byte	7                       # Abbrev [7] DW_TAG_member
+	.asciz	"f"                     # DW_AT_name
+	.quad	0x1122334455667788      # DW_AT_type
+	.byte	12                      # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+.LT:
+	.byte	6                       # Abbrev [6] DW_TAG_typedef
+	.asciz	"T"                     # DW_AT_name
+	.long	.LC                     # DW_AT_type
+.LD:
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"D"                     # DW_AT_name
+	.byte	4                       # DW_AT_byte_size
+	.byte	4                       # Abbrev [4] DW_TAG_member
+	.asciz	"e"                     # DW_AT_name
+	.long	.LE                     # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+	.byte	0                       # End Of Children Mark
+.Lcu_end0:
+
+.Lcu_begin1:
+	.long	.Lcu_end1-.Lcu_start1   # Length of Unit
+.Lcu_start1:
+	.short	4                       # DWARF version number
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.byte	8                       # Address Size (in bytes)
+	.byte	1                       # Abbrev [1] DW_TAG_compile_unit
+	.short	4                       # DW_AT_language
+	.asciz	"b.cpp"                 # DW_AT_name
+.LB:
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"B"                     # DW_AT_name
+	.byte	4                       # DW_AT_byte_size
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"x"                     # DW_AT_name
+	.long	.Lint1-.Lcu_begin1      # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+.Lint1:
+	.byte	5                       # Abbrev [5] DW_TAG_base_type
+	.asciz	"int"                   # DW_AT_name
+	.byte	5                       # DW_AT_encoding
+	.byte	4                       # DW_AT_byte_size
+	.byte	0                       # End Of Children Mark
+.Lcu_end1:
+
+.Lcu_begin2:
+	.long	.Lcu_end2-.Lcu_start2   # Length of Unit
+.Lcu_start2:
+	.short	4                       # DWARF version number
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.byte	8                       # Address Size (in bytes)
+	.byte	1                       # Abbrev [1] DW_TAG_compile_unit
+	.short	4                       # DW_AT_language
+	.asciz	"c.cpp"                 # DW_AT_name
+.LC:
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"C"                     # DW_AT_name
+	.byte	4                       # DW_AT_byte_size
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"x"                     # DW_AT_name
+	.long	.Lint2-.Lcu_begin2      # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+.Lint2:
+	.byte	5                       # Abbrev [5] DW_TAG_base_type
+	.asciz	"int"                   # DW_AT_name
+	.byte	5                       # DW_AT_encoding
+	.byte	4                       # DW_AT_byte_size
+	.byte	0                       # End Of Children Mark
+.Lcu_end2:
+
+.Lcu_begin3:
+	.long	.Lcu_end3-.Lcu_start3   # Length of Unit
+.Lcu_start3:
+	.short	4                       # DWARF version number
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.byte	8                       # Address Size (in bytes)
+	.byte	1                       # Abbrev [1] DW_TAG_compile_unit
+	.short	4                       # DW_AT_language
+	.asciz	"e.cpp"                 # DW_AT_name
+.LE:
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"E"                     # DW_AT_name
+	.byte	4                       # DW_AT_byte_size
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"x"                     # DW_AT_name
+	.long	.Lint3-.Lcu_begin3      # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+.Lint3:
+	.byte	5                       # Abbrev [5] DW_TAG_base_type
+	.asciz	"int"                   # DW_AT_name
+	.byte	5                       # DW_AT_encoding
+	.byte	4                       # DW_AT_byte_size
+	.byte	0                       # End Of Children Mark
+.Lcu_end3:
+
+.Ltu_begin0:
+	.long	.Ltu_end0-.Ltu_start0   # Length of Unit
+.Ltu_start0:
+	.short	5                       # DWARF version number
+	.byte	2                       # DWARF Unit Type
+	.byte	8                       # Address Size (in bytes)
+	.long	.debug_abbrev           # Offset Into Abbrev. Section
+	.quad	0x1122334455667788      # Type Signature
+	.long	.LF-.Ltu_begin0         # Type DIE Offset
+	.byte	8                       # Abbrev [8] DW_TAG_type_unit
+	.short	4                       # DW_AT_language
+.LF:
+	.byte	2                       # Abbrev [2] DW_TAG_structure_type
+	.asciz	"F"                     # DW_AT_name
+	.byte	4                       # DW_AT_byte_size
+	.byte	3                       # Abbrev [3] DW_TAG_member
+	.asciz	"x"                     # DW_AT_name
+	.long	.Lint4-.Ltu_begin0      # DW_AT_type
+	.byte	0                       # DW_AT_data_member_location
+	.byte	0                       # End Of Children Mark
+.Lint4:
+	.byte	5                       # Abbrev [5] DW_TAG_base_type
+	.asciz	"int"                   # DW_AT_name
+	.byte	5                       # DW_AT_encoding
+	.byte	4                       # DW_AT_byte_size
+	.byte	0                       # End Of Children Mark
+.Ltu_end0:
@@ -9,6 +9,8 @@
 #include "FormatUtil.h"
 #include "SystemInitializerTest.h"
 
+#include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
+#include "Plugins/SymbolFile/DWARF/DWARFUnit.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Core/Debugger.h"
@@ -23,6 +25,7 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/LineTable.h"
 #include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Symbol/TypeList.h"
 #include "lldb/Symbol/TypeMap.h"
 #include "lldb/Symbol/VariableList.h"
@@ -95,6 +98,11 @@ cl::opt<bool> SectionContents("contents",
 cl::opt<bool> SectionDependentModules("dep-modules",
                                       cl::desc("Dump each dependent module"),
                                       cl::sub(ObjectFileSubcommand));
+cl::opt<std::string> VerifySymtabCache(
+    "verify-symtab-cache",
+    cl::desc("Compare the symbol table cached in the given directory with a "
+             "freshly built one, caching it first if need be"),
+    cl::sub(ObjectFileSubcommand));
 cl::list<std::string> InputFilenames(cl::Positional, cl::desc("<input files>"),
                                      cl::OneOrMore,
                                      cl::sub(ObjectFileSubcommand));
@@ -116,6 +124,7 @@ enum class FindType {
   Namespace,
   Type,
   Variable,
+  Names,
 };
 static cl::opt<FindType> Find(
     "find", cl::desc("Choose search type:"),
@@ -125,7 +134,10 @@ static cl::opt<FindType> Find(
         clEnumValN(FindType::Block, "block", "Find blocks."),
         clEnumValN(FindType::Namespace, "namespace", "Find namespaces."),
         clEnumValN(FindType::Type, "type", "Find types."),
-        clEnumValN(FindType::Variable, "variable", "Find global variables.")),
+        clEnumValN(FindType::Variable, "variable", "Find global variables."),
+        clEnumValN(FindType::Names, "names",
+                   "Look up a comma separated list of names in the DWARF "
+                   "index and preload them.")),
     cl::sub(SymbolsSubcommand));
 
 static cl::opt<std::string> Name("name", cl::desc("Name to find."),
@@ -186,6 +198,7 @@ static Error findBlocks(lldb_private::Module &Module);
 static Error findNamespaces(lldb_private::Module &Module);
 static Error findTypes(lldb_private::Module &Module);
 static Error findVariables(lldb_private::Module &Module);
+static Error findNames(lldb_private::Module &Module);
 static Error dumpModule(lldb_private::Module &Module);
 static Error dumpAST(lldb_private::Module &Module);
 static Error verify(lldb_private::Module &Module);
@@ -570,6 +583,45 @@ Error opts::symbols::findVariables(lldb_private::Module &Module) {
   return Error::success();
 }
 
+Error opts::symbols::findNames(lldb_private::Module &Module) {
+  SymbolFile &Symfile = *Module.GetSymbolFile();
+  if (Symfile.GetPluginName() != SymbolFileDWARF::GetPluginNameStatic())
+    return make_string_error("Name lookups are only supported for DWARF.");
+  auto &Dwarf = static_cast<SymbolFileDWARF &>(Symfile);
+  DWARFIndex *Index = Dwarf.GetIndex();
+  DWARFDebugInfo *DebugInfo = Dwarf.DebugInfo();
+  if (!Index || !DebugInfo)
+    return make_string_error("Module has no DWARF index.");
+
+  SmallVector<StringRef, 4> Parts;
+  StringRef(Name).split(Parts, ',');
+  std::vector<ConstString> Names;
+  for (StringRef Part : Parts)
+    Names.push_back(ConstString(Part));
+  llvm::sort(Names.begin(), Names.end());
+  Names.erase(std::unique(Names.begin(), Names.end()), Names.end());
+
+  // Look the names up first, the index lookups don't extract any units.
+  std::vector<DIEArray> DIEs;
+  Index->GetDIEsForNames(Names, DIEs);
+
+  Symfile.PreloadNames(Names);
+  for (size_t Ind = 0; Ind < DebugInfo->GetNumUnits(); ++Ind) {
+    ::DWARFUnit *Unit = DebugInfo->GetUnitAtIndex(Ind);
+    if (Unit->GetDIEIfExtracted(Unit->GetFirstDIEOffset()))
+      outs() << formatv("Extracted unit: {0}\n",
+                        Unit->GetUnitDIEOnly().GetName());
+  }
+
+  for (size_t Ind = 0; Ind < Names.size(); ++Ind) {
+    outs() << formatv("Found {0} DIEs for {1}:\n", DIEs[Ind].size(),
+                      Names[Ind].GetStringRef());
+    for (const DIERef &Ref : DIEs[Ind])
+      outs() << formatv("  {0}\n", Dwarf.GetDIE(Ref).GetTagAsCString());
+  }
+  return Error::success();
+}
+
 Error opts::symbols::dumpModule(lldb_private::Module &Module) {
   StreamString Stream;
   Module.ParseAllDebugSymbols();
@@ -746,6 +798,15 @@ Expected<Error (*)(lldb_private::Module &)> opts::symbols::getAction() {
       return make_string_error("Cannot search for variables "
                                "using line numbers.");
     return findVariables;
+
+  case FindType::Names:
+    if (Name.empty())
+      return make_string_error("Name lookups need a -name.");
+    if (Regex || !Context.empty() || !File.empty() || Line != 0)
+      return make_string_error("Cannot look up names using regular "
+                               "expressions, contexts, file names or line "
+                               "numbers.");
+    return findNames;
   }
 
   llvm_unreachable("Unsupported symbol action.");
@@ -814,11 +875,116 @@ static void dumpSectionList(LinePrinter &Printer, const SectionList &List, bool
   }
 }
 
+static ObjectFile *loadObjectFile(StringRef File, ModuleSP &ModulePtr) {
+  ModuleSpec Spec{FileSpec(File)};
+  ModulePtr = std::make_shared<lldb_private::Module>(Spec);
+  // Let the symbol vendor add the sections of any separate debug file.
+  ModulePtr->GetSymbolFile();
+  return ModulePtr->GetObjectFile();
+}
+
+static bool sameSymbolIndexes(Symtab &Fresh, Symtab &Cached, ConstString Name) {
+  std::vector<uint32_t> FreshIndexes, CachedIndexes;
+  Fresh.AppendSymbolIndexesWithName(Name, FreshIndexes);
+  Cached.AppendSymbolIndexesWithName(Name, CachedIndexes);
+  llvm::sort(FreshIndexes);
+  llvm::sort(CachedIndexes);
+  if (FreshIndexes != CachedIndexes)
+    return false;
+
+  SymbolContextList FreshFunctions, CachedFunctions;
+  const uint32_t NameTypeMask = eFunctionNameTypeBase |
+                                eFunctionNameTypeMethod |
+                                eFunctionNameTypeSelector;
+  Fresh.FindFunctionSymbols(Name, NameTypeMask, FreshFunctions);
+  Cached.FindFunctionSymbols(Name, NameTypeMask, CachedFunctions);
+  return FreshFunctions.GetSize() == CachedFunctions.GetSize();
+}
+
+static bool sameSymbols(Symtab &Fresh, Symtab &Cached, uint32_t I) {
+  const Symbol &L = *Fresh.SymbolAtIndex(I);
+  const Symbol &R = *Cached.SymbolAtIndex(I);
+  if (L.GetID() != R.GetID() || L.GetType() != R.GetType() ||
+      L.GetFlags() != R.GetFlags() || L.IsExternal() != R.IsExternal() ||
+      L.IsDebug() != R.IsDebug() || L.IsSynthetic() != R.IsSynthetic() ||
+      L.GetByteSize() != R.GetByteSize() ||
+      L.GetMangled().GetMangledName() != R.GetMangled().GetMangledName() ||
+      L.GetMangled().GetDemangledName(L.GetLanguage()) !=
+          R.GetMangled().GetDemangledName(R.GetLanguage()) ||
+      L.GetAddressRef().GetSection() != R.GetAddressRef().GetSection() ||
+      L.GetAddressRef().GetOffset() != R.GetAddressRef().GetOffset())
+    return false;
+
+  if (!L.ValueIsAddress())
+    return true;
+  const addr_t FileAddr = L.GetAddressRef().GetFileAddress();
+  Symbol *FreshContaining = Fresh.FindSymbolContainingFileAddress(FileAddr);
+  Symbol *CachedContaining = Cached.FindSymbolContainingFileAddress(FileAddr);
+  return (FreshContaining ? Fresh.GetIndexForSymbol(FreshContaining)
+                          : UINT32_MAX) ==
+         (CachedContaining ? Cached.GetIndexForSymbol(CachedContaining)
+                           : UINT32_MAX);
+}
+
+static int verifySymtabCache(StringRef File, LinePrinter &Printer) {
+  ModuleListProperties &Properties =
+      ModuleList::GetGlobalModuleListProperties();
+
+  // Build one symbol table with the cache disabled. Then have a second module
+  // load its symbol table with the cache enabled, which writes the cache
+  // entry if there is no up to date one yet, and read that entry back for
+  // the first module, so that both symbol tables refer to the same sections.
+  Properties.SetSymbolCachePath("");
+  ModuleSP FreshModule;
+  ObjectFile *FreshObj = loadObjectFile(File, FreshModule);
+  Symtab *Fresh = FreshObj ? FreshObj->GetSymtab() : nullptr;
+
+  Properties.SetSymbolCachePath(opts::object::VerifySymtabCache);
+  ModuleSP CachingModule;
+  if (ObjectFile *CachingObj = loadObjectFile(File, CachingModule))
+    CachingObj->GetSymtab();
+  std::unique_ptr<Symtab> Cached =
+      FreshObj ? FreshObj->ReadCachedSymtab() : nullptr;
+  Properties.SetSymbolCachePath("");
+
+  if (!Fresh || !Cached) {
+    WithColor::error() << File << ": no cached symbol table\n";
+    return 1;
+  }
+  if (Fresh->GetNumSymbols() != Cached->GetNumSymbols()) {
+    WithColor::error() << formatv("{0}: {1} symbols, but {2} cached\n", File,
+                                  Fresh->GetNumSymbols(),
+                                  Cached->GetNumSymbols());
+    return 1;
+  }
+
+  int HadErrors = 0;
+  for (uint32_t I = 0; I < Fresh->GetNumSymbols(); ++I) {
+    ConstString Name = Fresh->SymbolAtIndex(I)->GetMangled().GetName(
+        Fresh->SymbolAtIndex(I)->GetLanguage(), Mangled::ePreferMangled);
+    if (!sameSymbols(*Fresh, *Cached, I) ||
+        (Name && !sameSymbolIndexes(*Fresh, *Cached, Name))) {
+      WithColor::error() << formatv("{0}: cached symbol {1} ({2}) differs\n",
+                                    File, I, Name);
+      HadErrors = 1;
+    }
+  }
+  if (!HadErrors)
+    Printer.formatLine("Symbol table cache: {0} symbols match",
+                       Fresh->GetNumSymbols());
+  return HadErrors;
+}
+
 static int dumpObjectFiles(Debugger &Dbg) {
   LinePrinter Printer(4, llvm::outs());
 
   int HadErrors = 0;
   for (const auto &File : opts::object::InputFilenames) {
+    if (!opts::object::VerifySymtabCache.empty()) {
+      HadErrors |= verifySymtabCache(File, Printer);
+      continue;
+    }
+
     ModuleSpec Spec{FileSpec(File)};
 
     auto ModulePtr = std::make_shared<lldb_private::Module>(Spec);
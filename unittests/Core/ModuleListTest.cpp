@@ -0,0 +1,110 @@
+//===-- ModuleListTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/SymbolFile/DWARF/SymbolFileDWARF.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Symbol/TypeList.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+class ModuleListTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    SymbolFileDWARF::Initialize();
+    ClangASTContext::Initialize();
+  }
+
+  void TearDown() override {
+    ModuleList::GetGlobalModuleListProperties().SetParallelModuleSearch(false);
+    ClangASTContext::Terminate();
+    SymbolFileDWARF::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+  }
+};
+} // namespace
+
+// An ELF file whose DWARF defines "struct Foo".
+static const char *g_yaml = R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_EXEC
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .debug_abbrev
+    Type:            SHT_PROGBITS
+    AddressAlign:    0x0000000000000001
+    Content:         01110103081305000002130003080B0B000000
+  - Name:            .debug_info
+    Type:            SHT_PROGBITS
+    AddressAlign:    0x0000000000000001
+    Content:         150000000400000000000801612E63000C0002466F6F000400
+...
+)";
+
+/// Searches \a num_modules modules for "Foo", with the modules searched in
+/// parallel or not, and returns the number of types found. The first module
+/// is listed twice, so its symbol file must only be searched once.
+static size_t FindTypesInModules(llvm::StringRef path, size_t num_modules,
+                                 bool parallel) {
+  ModuleList modules;
+  for (size_t i = 0; i < num_modules; ++i)
+    modules.Append(std::make_shared<Module>(ModuleSpec(FileSpec(path))));
+  modules.Append(modules.GetModuleAtIndex(0));
+
+  ModuleList::GetGlobalModuleListProperties().SetParallelModuleSearch(
+      parallel);
+  llvm::DenseSet<SymbolFile *> searched_symbol_files;
+  TypeList types;
+  auto start = std::chrono::steady_clock::now();
+  modules.FindTypes(nullptr, ConstString("Foo"), false, UINT32_MAX,
+                    searched_symbol_files, types);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  llvm::errs() << llvm::formatv(
+      "FindTypes over {0} modules, {1}: {2:f3}s\n", num_modules,
+      parallel ? "parallel" : "serial", elapsed.count());
+
+  EXPECT_EQ(num_modules, searched_symbol_files.size());
+  return types.GetSize();
+}
+
+TEST_F(ModuleListTest, ParallelFindTypesIn500Modules) {
+  auto ExpectedFile = TestFile::fromYaml(g_yaml);
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  // Every module gets its own symbol file, so the first search indexes the
+  // DWARF of all of them, which is what the parallel search speeds up.
+  const size_t num_modules = 500;
+  EXPECT_EQ(num_modules,
+            FindTypesInModules(ExpectedFile->name(), num_modules, false));
+  EXPECT_EQ(num_modules,
+            FindTypesInModules(ExpectedFile->name(), num_modules, true));
+}
@@ -0,0 +1,67 @@
+//===-- NameCorpusTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/NameCorpus.h"
+#include "lldb/Utility/RegularExpression.h"
+#include "gmock/gmock.h"
+
+#include "llvm/Support/FormatVariadic.h"
+
+using namespace lldb_private;
+using testing::ElementsAre;
+
+TEST(NameCorpus, FindValues) {
+  NameCorpus corpus;
+  corpus.Append(ConstString("foo"), 3);
+  corpus.Append(ConstString("foobar"), 1);
+  corpus.Append(ConstString("bar"), 2);
+  corpus.Append(ConstString("foo"), 0);
+  corpus.Finalize();
+  EXPECT_EQ(3u, corpus.GetSize());
+
+  auto find = [&](llvm::StringRef text) {
+    std::vector<uint32_t> values;
+    corpus.FindValues(RegularExpression(text), values);
+    return values;
+  };
+  EXPECT_THAT(find("foo"), ElementsAre(0, 1, 3));
+  EXPECT_THAT(find("^foo$"), ElementsAre(0, 3));
+  EXPECT_THAT(find("bar$"), ElementsAre(1, 2));
+  EXPECT_THAT(find("^b"), ElementsAre(2));
+  EXPECT_THAT(find("o+b"), ElementsAre(1));
+  EXPECT_THAT(find("foo|bar"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(find("baz"), ElementsAre());
+  EXPECT_THAT(find("a[b-"), ElementsAre());
+}
+
+TEST(NameCorpus, MatchesRegularExpression) {
+  // Enough names for the search to be split into several chunks.
+  NameCorpus corpus;
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < 50000; ++i) {
+    names.push_back(
+        llvm::formatv("ns{0}::Class{1}::method{2}", i % 7, i % 101, i).str());
+    corpus.Append(ConstString(names.back()), i);
+  }
+  corpus.Finalize();
+
+  for (llvm::StringRef text :
+       {"Class42::", "^ns3::Class1[0-9]::", "method4999$", "::method[0-9]+7$",
+        "ns[25].*Class9[0-9]", "^ns6::Class99::method49993$"}) {
+    RegularExpression regex(text);
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < names.size(); ++i)
+      if (regex.Execute(names[i]))
+        expected.push_back(i);
+
+    std::vector<uint32_t> values;
+    corpus.FindValues(regex, values);
+    EXPECT_EQ(expected, values) << text;
+    EXPECT_FALSE(values.empty()) << text;
+  }
+}
@@ -51,3 +51,22 @@ TEST(UniqueCStringMap, NoDefaultConstructor) {
   EXPECT_THAT(Map.GetValues(Bar, Values), 0);
   EXPECT_THAT(Values, testing::IsEmpty());
 }
+
+TEST(UniqueCStringMap, GetValuesForSeveralNames) {
+  UniqueCStringMap<int> Map;
+  ConstString Foo("foo"), Bar("bar"), Baz("baz"), Missing("missing");
+
+  Map.Append(Foo, 1);
+  Map.Append(Bar, 2);
+  Map.Append(Foo, 3);
+  Map.Append(Baz, 4);
+  Map.Sort();
+
+  std::vector<std::vector<int>> Values;
+  Map.GetValues({Missing, Foo, Baz, Bar}, Values);
+  ASSERT_EQ(4u, Values.size());
+  EXPECT_THAT(Values[0], testing::IsEmpty());
+  EXPECT_THAT(Values[1], testing::UnorderedElementsAre(1, 3));
+  EXPECT_THAT(Values[2], testing::ElementsAre(4));
+  EXPECT_THAT(Values[3], testing::ElementsAre(2));
+}
@@ -0,0 +1,88 @@
+//===-- StringPrinterTests.cpp ----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/DataFormatters/StringPrinter.h"
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/StreamString.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+using ElemType = StringPrinter::StringElementType;
+
+template <ElemType elem_type>
+static std::string Dump(llvm::StringRef input, bool escape = true,
+                        bool zero_is_terminator = true) {
+  DataBufferSP buffer_sp =
+      std::make_shared<DataBufferHeap>(input.data(), input.size());
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  StreamString stream;
+  StringPrinter::ReadBufferAndDumpToStreamOptions opts;
+  opts.SetData(data);
+  opts.SetSourceSize(input.size());
+  opts.SetStream(&stream);
+  opts.SetQuote('"');
+  opts.SetEscapeNonPrintables(escape);
+  opts.SetBinaryZeroIsTerminator(zero_is_terminator);
+  EXPECT_TRUE(StringPrinter::ReadBufferAndDumpToStream<elem_type>(opts));
+  return stream.GetString().str();
+}
+
+TEST(StringPrinterTest, PlainASCII) {
+  EXPECT_EQ("\"\"", Dump<ElemType::UTF8>(""));
+  EXPECT_EQ("\"a\"", Dump<ElemType::UTF8>("a"));
+  // Long enough to be scanned a word at a time, with a tail.
+  llvm::StringRef fox("The quick brown fox jumps over the lazy dog.");
+  EXPECT_EQ(("\"" + fox + "\"").str(), Dump<ElemType::UTF8>(fox));
+}
+
+TEST(StringPrinterTest, EscapesInsidePlainRuns) {
+  EXPECT_EQ("\"abcdefgh\\\"ijklmnop\\\\q\"",
+            Dump<ElemType::UTF8>("abcdefgh\"ijklmnop\\q"));
+  EXPECT_EQ("\"line one\\nline two\\tand\\x7f\"",
+            Dump<ElemType::UTF8>("line one\nline two\tand\x7f"));
+  EXPECT_EQ("\"\\x01\\x02abcdefghijk\\r\"",
+            Dump<ElemType::ASCII>("\x01\x02" "abcdefghijk\r"));
+  EXPECT_EQ("\"café au lait, s'il vous plaît\"",
+            Dump<ElemType::UTF8>("café au lait, s'il vous plaît"));
+}
+
+TEST(StringPrinterTest, Unescaped) {
+  EXPECT_EQ("\"a\"b\\c\nd\"", Dump<ElemType::UTF8>("a\"b\\c\nd", false));
+}
+
+TEST(StringPrinterTest, ZeroTerminator) {
+  llvm::StringRef input("abcdefghijklmnop\0qrstuvwxyz", 27);
+  EXPECT_EQ("\"abcdefghijklmnop\"", Dump<ElemType::UTF8>(input));
+  EXPECT_EQ("\"abcdefghijklmnop\\0qrstuvwxyz\"",
+            Dump<ElemType::UTF8>(input, true, false));
+}
+
+TEST(StringPrinterTest, UTF16) {
+  const char16_t str[] = u"hello, world\n";
+  llvm::StringRef input(reinterpret_cast<const char *>(str),
+                        sizeof(str) - sizeof(char16_t));
+  DataBufferSP buffer_sp =
+      std::make_shared<DataBufferHeap>(input.data(), input.size());
+  DataExtractor data(buffer_sp, eByteOrderLittle, 8);
+
+  StreamString stream;
+  StringPrinter::ReadBufferAndDumpToStreamOptions opts;
+  opts.SetData(data);
+  opts.SetSourceSize(input.size() / sizeof(char16_t));
+  opts.SetStream(&stream);
+  opts.SetQuote('"');
+  opts.SetEscapeNonPrintables(true);
+  EXPECT_TRUE(
+      StringPrinter::ReadBufferAndDumpToStream<ElemType::UTF16>(opts));
+  EXPECT_EQ("\"hello, world\\n\"", stream.GetString());
+}
@@ -0,0 +1,101 @@
+//===-- TestDisassemblerCache.cpp -------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/Address.h"
+#include "lldb/Core/AddressRange.h"
+#include "lldb/Core/Disassembler.h"
+#include "lldb/Utility/ArchSpec.h"
+
+#include "Plugins/Disassembler/llvm/DisassemblerLLVMC.h"
+#include "llvm/Support/TargetSelect.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+class TestDisassemblerCache : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    llvm::InitializeAllTargets();
+    llvm::InitializeAllAsmPrinters();
+    llvm::InitializeAllTargetMCs();
+    llvm::InitializeAllDisassemblers();
+    DisassemblerLLVMC::Initialize();
+  }
+
+  static void TearDownTestCase() { DisassemblerLLVMC::Terminate(); }
+
+protected:
+  DisassemblerSP Disassemble(addr_t file_addr) {
+    const uint8_t data[] = {
+        0x00, 0x00, 0x00, 0x94, // bl     #0
+        0xc0, 0x03, 0x5f, 0xd6, // ret
+        0x1f, 0x20, 0x03, 0xd5, // nop
+    };
+    return Disassembler::DisassembleBytes(m_arch, nullptr, nullptr,
+                                          Address(file_addr), data,
+                                          sizeof(data), UINT32_MAX, true);
+  }
+
+  ArchSpec m_arch{"arm64-apple-ios"};
+};
+
+TEST_F(TestDisassemblerCache, ControlFlowClass) {
+  DisassemblerSP disasm_sp = Disassemble(0x1000);
+  ASSERT_NE(nullptr, disasm_sp);
+  InstructionList &insts = disasm_sp->GetInstructionList();
+  ASSERT_EQ(3u, insts.GetSize());
+
+  EXPECT_TRUE(insts.GetInstructionAtIndex(0)->DoesBranch());
+  EXPECT_TRUE(insts.GetInstructionAtIndex(0)->IsCall());
+  EXPECT_TRUE(insts.GetInstructionAtIndex(1)->DoesBranch());
+  EXPECT_FALSE(insts.GetInstructionAtIndex(1)->IsCall());
+  EXPECT_FALSE(insts.GetInstructionAtIndex(2)->DoesBranch());
+  EXPECT_FALSE(insts.GetInstructionAtIndex(2)->IsCall());
+  EXPECT_FALSE(insts.GetInstructionAtIndex(2)->HasDelaySlot());
+}
+
+TEST_F(TestDisassemblerCache, FindAndInvalidate) {
+  DisassemblerCache cache;
+  DisassemblerSP first_sp = Disassemble(0x1000);
+  DisassemblerSP second_sp = Disassemble(0x2000);
+  ASSERT_NE(nullptr, first_sp);
+  ASSERT_NE(nullptr, second_sp);
+
+  const AddressRange first(Address(0x1000), 12);
+  const AddressRange second(Address(0x2000), 12);
+  cache.Insert(first, m_arch, "", "", first_sp);
+  cache.Insert(second, m_arch, "", "", second_sp);
+  EXPECT_EQ(2u, cache.GetSize());
+
+  EXPECT_EQ(first_sp, cache.Find(first, m_arch, "", ""));
+  EXPECT_EQ(second_sp, cache.Find(second, m_arch, "", ""));
+  // Only the exact range decoded the same way is found.
+  EXPECT_EQ(nullptr, cache.Find(AddressRange(Address(0x1000), 8), m_arch, "",
+                                ""));
+  EXPECT_EQ(nullptr, cache.Find(AddressRange(Address(0x1004), 8), m_arch, "",
+                                ""));
+  EXPECT_EQ(nullptr, cache.Find(first, m_arch, "intel", ""));
+  EXPECT_EQ(nullptr, cache.Find(first, m_arch, "", "llvm-mc"));
+  EXPECT_EQ(nullptr, cache.Find(first, ArchSpec("x86_64-apple-macosx"), "",
+                                ""));
+
+  // Writes next to a range leave it alone.
+  cache.Invalidate(0x100c, 0x100);
+  cache.Invalidate(0xff0, 0x10);
+  EXPECT_EQ(2u, cache.GetSize());
+
+  // A write into the middle of a range drops just that range.
+  cache.Invalidate(0x1008, 1);
+  EXPECT_EQ(nullptr, cache.Find(first, m_arch, "", ""));
+  EXPECT_EQ(second_sp, cache.Find(second, m_arch, "", ""));
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.GetSize());
+}
@@ -8,8 +8,11 @@
 
 #include "lldb/Host/MainLoop.h"
 #include "lldb/Host/ConnectionFileDescriptor.h"
+#include "lldb/Host/File.h"
 #include "lldb/Host/PseudoTerminal.h"
 #include "lldb/Host/common/TCPSocket.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 #include <future>
@@ -102,6 +105,26 @@ TEST_F(MainLoopTest, TerminatesImmediately) {
 }
 
 #ifdef LLVM_ON_UNIX
+TEST_F(MainLoopTest, ReadRegularFile) {
+  // Regular files can't be waited for with some of the polling mechanisms,
+  // but they never block, so they are always readable. The Windows MainLoop
+  // only accepts sockets, hence this test is Unix-only.
+  llvm::SmallString<128> name;
+  int fd;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("MainLoopTest", "test", fd, name));
+  llvm::FileRemover remover(name);
+  auto file_sp = std::make_shared<NativeFile>(fd, File::eOpenOptionRead, true);
+
+  MainLoop loop;
+  Status error;
+  auto handle = loop.RegisterReadObject(file_sp, make_callback(), error);
+  ASSERT_TRUE(error.Success()) << error.AsCString();
+  ASSERT_TRUE(handle);
+  ASSERT_TRUE(loop.Run().Success());
+  ASSERT_EQ(1u, callback_count);
+}
+
 // NetBSD currently does not report slave pty EOF via kevent
 // causing this test to hang forever.
 #ifndef __NetBSD__
@@ -2,6 +2,9 @@
 
 #include "lldb/Host/TaskPool.h"
 
+#include <atomic>
+#include <vector>
+
 using namespace lldb_private;
 
 TEST(TaskPoolTest, AddTask) {
@@ -43,3 +46,19 @@ TEST(TaskPoolTest, TaskMap) {
   ASSERT_EQ(data[2], 4);
   ASSERT_EQ(data[3], 9);
 }
+
+TEST(TaskPoolTest, NestedTaskMap) {
+  // Fill the pool with tasks that each wait on a nested TaskMapOverInt.
+  const size_t outer = 2 * GetHardwareConcurrencyHint();
+  const size_t inner = 16;
+  std::vector<std::atomic<size_t>> sums(outer);
+  for (auto &sum : sums)
+    sum = 0;
+
+  TaskMapOverInt(0, outer, [&](size_t i) {
+    TaskMapOverInt(0, inner, [&](size_t j) { sums[i] += j; });
+  });
+
+  for (auto &sum : sums)
+    ASSERT_EQ(inner * (inner - 1) / 2, sum.load());
+}
@@ -359,3 +359,135 @@ TEST_F(GDBRemoteClientBaseTest, SendPacketAndReceiveResponseWithOutputSupport) {
   ASSERT_EQ("OK", response.GetStringRef());
   ASSERT_EQ("Hello, world", command_output.GetString().str());
 }
+
+TEST_F(GDBRemoteClientBaseTest, SendPipelinedPackets) {
+  StringExtractorGDBRemote response;
+  std::vector<StringExtractorGDBRemote> responses;
+  const std::vector<std::string> payloads = {"x1000,10", "m1010,10", "p1",
+                                             "qMemoryRegionInfo:1000"};
+
+  std::future<PacketResult> result = std::async(std::launch::async, [&] {
+    return client.SendPipelinedPacketsAndWaitForResponses(payloads, responses,
+                                                          true);
+  });
+
+  // All packets are sent before any of them got a response.
+  for (const std::string &payload : payloads) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+    ASSERT_EQ(payload, response.GetStringRef());
+  }
+  for (const char *reply : {"R1", "R2", "R3", "E01"})
+    ASSERT_EQ(PacketResult::Success, server.SendPacket(reply));
+
+  ASSERT_EQ(PacketResult::Success, result.get());
+  ASSERT_EQ(4u, responses.size());
+  EXPECT_EQ("R1", responses[0].GetStringRef());
+  EXPECT_EQ("R2", responses[1].GetStringRef());
+  EXPECT_EQ("R3", responses[2].GetStringRef());
+  EXPECT_EQ("E01", responses[3].GetStringRef());
+
+  // A batch with packets that change state still gets its responses.
+  const std::vector<std::string> write_payloads = {"m1000,1", "M1000,1:00"};
+  result = std::async(std::launch::async, [&] {
+    return client.SendPipelinedPacketsAndWaitForResponses(write_payloads,
+                                                          responses, true);
+  });
+  ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+  ASSERT_EQ("m1000,1", response.GetStringRef());
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("ff"));
+  ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+  ASSERT_EQ("M1000,1:00", response.GetStringRef());
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("OK"));
+  ASSERT_EQ(PacketResult::Success, result.get());
+  ASSERT_EQ(2u, responses.size());
+  EXPECT_EQ("ff", responses[0].GetStringRef());
+  EXPECT_EQ("OK", responses[1].GetStringRef());
+}
+
+TEST_F(GDBRemoteClientBaseTest, SendPipelinedPacketsAsync) {
+  StringExtractorGDBRemote response;
+  const std::vector<std::string> payloads = {"m1000,10", "m1010,10"};
+
+  std::future<std::vector<StringExtractorGDBRemote>> result =
+      client.SendPipelinedPacketsAsync(payloads);
+  for (const std::string &payload : payloads) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+    ASSERT_EQ(payload, response.GetStringRef());
+  }
+  for (const char *reply : {"R1", "R2"})
+    ASSERT_EQ(PacketResult::Success, server.SendPacket(reply));
+
+  std::vector<StringExtractorGDBRemote> responses = result.get();
+  ASSERT_EQ(2u, responses.size());
+  EXPECT_EQ("R1", responses[0].GetStringRef());
+  EXPECT_EQ("R2", responses[1].GetStringRef());
+}
+
+TEST_F(GDBRemoteClientBaseTest, SendPipelinedPacketsTimeout) {
+  StringExtractorGDBRemote response;
+  std::vector<StringExtractorGDBRemote> responses;
+  const std::vector<std::string> payloads = {"m1000,10", "m1010,10",
+                                             "m1020,10"};
+  client.SetPacketTimeout(std::chrono::seconds(1));
+
+  std::future<PacketResult> result = std::async(std::launch::async, [&] {
+    return client.SendPipelinedPacketsAndWaitForResponses(payloads, responses,
+                                                          true);
+  });
+  for (const std::string &payload : payloads) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+    ASSERT_EQ(payload, response.GetStringRef());
+  }
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("R1"));
+
+  // The second response is late. The client only syncs once it has waited for
+  // the responses in flight, and skips the late ones that come before the
+  // sync reply.
+  PacketResult packet_result;
+  for (int i = 0; i < 5; ++i) {
+    packet_result = server.GetPacket(response);
+    if (packet_result != PacketResult::ErrorReplyTimeout)
+      break;
+  }
+  ASSERT_EQ(PacketResult::Success, packet_result);
+  ASSERT_EQ("qC", response.GetStringRef());
+  for (const char *reply : {"R2", "R3", "QC1"})
+    ASSERT_EQ(PacketResult::Success, server.SendPacket(reply));
+
+  ASSERT_EQ(PacketResult::ErrorReplyTimeout, result.get());
+  ASSERT_EQ(1u, responses.size());
+  EXPECT_EQ("R1", responses[0].GetStringRef());
+
+  // The next packet gets its own response.
+  result = std::async(std::launch::async, [&] {
+    return client.SendPacketAndWaitForResponse("p1", response, true);
+  });
+  StringExtractorGDBRemote packet;
+  ASSERT_EQ(PacketResult::Success, server.GetPacket(packet));
+  ASSERT_EQ("p1", packet.GetStringRef());
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("R4"));
+  ASSERT_EQ(PacketResult::Success, result.get());
+  EXPECT_EQ("R4", response.GetStringRef());
+  EXPECT_TRUE(client.IsConnected());
+}
+
+TEST_F(GDBRemoteClientBaseTest, SendPipelinedPacketsDisconnect) {
+  StringExtractorGDBRemote response;
+  std::vector<StringExtractorGDBRemote> responses;
+  const std::vector<std::string> payloads = {"m1000,10", "m1010,10"};
+
+  std::future<PacketResult> result = std::async(std::launch::async, [&] {
+    return client.SendPipelinedPacketsAndWaitForResponses(payloads, responses,
+                                                          true);
+  });
+  for (const std::string &payload : payloads) {
+    ASSERT_EQ(PacketResult::Success, server.GetPacket(response));
+    ASSERT_EQ(payload, response.GetStringRef());
+  }
+  ASSERT_EQ(PacketResult::Success, server.SendPacket("R1"));
+  server.Disconnect();
+
+  ASSERT_EQ(PacketResult::ErrorDisconnected, result.get());
+  ASSERT_EQ(1u, responses.size());
+  EXPECT_EQ("R1", responses[0].GetStringRef());
+}
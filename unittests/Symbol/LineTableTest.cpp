@@ -0,0 +1,217 @@
+//===-- LineTableTest.cpp ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/LineTable.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+struct Row {
+  addr_t file_addr;
+  uint32_t line;
+  uint16_t file_idx;
+  bool is_terminal_entry;
+};
+
+// Exposes the address lookup, which otherwise needs a module to resolve
+// addresses.
+class TestLineTable : public LineTable {
+public:
+  TestLineTable() : LineTable(nullptr) {}
+
+  using LineTable::LowerBoundForAddress;
+};
+} // namespace
+
+// Build num_sequences sequences of rows_per_sequence rows each, spread over a
+// few files, with some gaps between the sequences that don't fit the compact
+// address encoding.
+static std::vector<Row> MakeRows(uint32_t num_sequences,
+                                 uint32_t rows_per_sequence) {
+  std::vector<Row> rows;
+  uint32_t state = 0x12345678;
+  addr_t file_addr = 0x1000;
+  for (uint32_t seq = 0; seq < num_sequences; ++seq) {
+    const uint16_t file_idx = seq % 7;
+    uint32_t line = 1 + (seq * 13) % 500;
+    for (uint32_t i = 0; i < rows_per_sequence; ++i) {
+      state = state * 1103515245 + 12345;
+      rows.push_back({file_addr, line, file_idx, false});
+      file_addr += 1 + (state >> 28);
+      line += (state >> 16) % 5;
+    }
+    rows.push_back({file_addr, line, file_idx, true});
+    file_addr += seq % 5 == 0 ? 0x20000 : 0x10;
+  }
+  return rows;
+}
+
+static void InsertRows(LineTable &table, const std::vector<Row> &rows) {
+  std::unique_ptr<LineSequence> sequence(table.CreateLineSequenceContainer());
+  for (const Row &row : rows) {
+    table.AppendLineEntryToSequence(sequence.get(), row.file_addr, row.line, 0,
+                                    row.file_idx, true, false, false, false,
+                                    row.is_terminal_entry);
+    if (row.is_terminal_entry) {
+      table.InsertSequence(sequence.get());
+      sequence->Clear();
+    }
+  }
+}
+
+// The linear search the line table used to do.
+static uint32_t FindByLine(const std::vector<Row> &rows, uint32_t start_idx,
+                           uint32_t file_idx, uint32_t line, bool exact) {
+  uint32_t best_match = UINT32_MAX;
+  for (uint32_t idx = start_idx; idx < rows.size(); ++idx) {
+    const Row &row = rows[idx];
+    if (row.is_terminal_entry || row.file_idx != file_idx || row.line < line)
+      continue;
+    if (row.line == line)
+      return idx;
+    if (!exact &&
+        (best_match == UINT32_MAX || row.line < rows[best_match].line))
+      best_match = idx;
+  }
+  return best_match;
+}
+
+TEST(LineTableTest, FindLineEntryIndexByFileIndex) {
+  const std::vector<Row> rows = MakeRows(200, 40);
+  TestLineTable table;
+  InsertRows(table, rows);
+  table.Finalize();
+  ASSERT_EQ(rows.size(), table.GetSize());
+
+  for (uint32_t file_idx = 0; file_idx < 8; ++file_idx)
+    for (uint32_t line = 0; line < 700; line += 3)
+      for (uint32_t start_idx : {0u, 1u, 1000u, 5000u})
+        for (bool exact : {false, true})
+          ASSERT_EQ(FindByLine(rows, start_idx, file_idx, line, exact),
+                    table.FindLineEntryIndexByFileIndex(start_idx, file_idx,
+                                                        line, exact, nullptr))
+              << "file " << file_idx << " line " << line << " start "
+              << start_idx << " exact " << exact;
+
+  // Several files at once prefer an exact match in any of them.
+  for (uint32_t line = 0; line < 700; line += 7) {
+    uint32_t expected = UINT32_MAX;
+    for (uint32_t file_idx : {2u, 5u}) {
+      const uint32_t idx = FindByLine(rows, 0, file_idx, line, true);
+      if (idx < expected)
+        expected = idx;
+    }
+    if (expected == UINT32_MAX) {
+      for (uint32_t file_idx : {2u, 5u}) {
+        const uint32_t idx = FindByLine(rows, 0, file_idx, line, false);
+        if (idx != UINT32_MAX &&
+            (expected == UINT32_MAX || rows[idx].line < rows[expected].line ||
+             (rows[idx].line == rows[expected].line && idx < expected)))
+          expected = idx;
+      }
+    }
+    EXPECT_EQ(expected, table.FindLineEntryIndexByFileIndex(0, {2u, 5u}, line,
+                                                            false, nullptr))
+        << "line " << line;
+  }
+}
+
+TEST(LineTableTest, LowerBoundForAddress) {
+  const std::vector<Row> rows = MakeRows(50, 37);
+  TestLineTable table;
+  InsertRows(table, rows);
+  table.Finalize();
+
+  auto expected = [&](addr_t file_addr) -> uint32_t {
+    return std::lower_bound(rows.begin(), rows.end(), file_addr,
+                            [](const Row &row, addr_t file_addr) {
+                              return row.file_addr < file_addr;
+                            }) -
+           rows.begin();
+  };
+  for (const Row &row : rows)
+    for (addr_t file_addr :
+         {row.file_addr - 1, row.file_addr, row.file_addr + 1})
+      ASSERT_EQ(expected(file_addr), table.LowerBoundForAddress(file_addr))
+          << "address " << file_addr;
+  EXPECT_EQ(rows.size(), table.LowerBoundForAddress(LLDB_INVALID_ADDRESS));
+}
+
+TEST(LineTableTest, InsertAfterFinalize) {
+  const std::vector<Row> rows = MakeRows(20, 10);
+  std::vector<Row> first(rows.begin(), rows.begin() + rows.size() / 2);
+  std::vector<Row> second(rows.begin() + rows.size() / 2, rows.end());
+  while (!first.back().is_terminal_entry) {
+    second.insert(second.begin(), first.back());
+    first.pop_back();
+  }
+
+  // Insert the second half first so that the remaining sequences have to be
+  // inserted in front of the packed ones.
+  TestLineTable table;
+  InsertRows(table, second);
+  table.Finalize();
+  EXPECT_EQ(second.size(), table.GetSize());
+  InsertRows(table, first);
+  EXPECT_EQ(rows.size(), table.GetSize());
+
+  for (uint32_t line = 0; line < 600; line += 5)
+    ASSERT_EQ(FindByLine(rows, 0, 3, line, false),
+              table.FindLineEntryIndexByFileIndex(0, 3, line, false, nullptr))
+        << "line " << line;
+}
+
+TEST(LineTableTest, MemoryAndLookupBenchmark) {
+  const std::vector<Row> rows = MakeRows(2000, 100);
+  TestLineTable table;
+  InsertRows(table, rows);
+  table.Finalize();
+
+  // The old representation took 16 bytes per row, and the line index adds 4.
+  const size_t packed_size = table.MemorySize();
+  EXPECT_LT(packed_size, rows.size() * 12);
+  RecordProperty("bytes_per_row", packed_size / rows.size());
+
+  // Build the line index outside of the timed lookups.
+  table.FindLineEntryIndexByFileIndex(0, 0, 0, true, nullptr);
+
+  auto start = std::chrono::steady_clock::now();
+  uint32_t found = 0;
+  for (uint32_t file_idx = 0; file_idx < 7; ++file_idx)
+    for (uint32_t line = 0; line < 1000; ++line)
+      if (table.FindLineEntryIndexByFileIndex(0, file_idx, line, true,
+                                              nullptr) != UINT32_MAX)
+        ++found;
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_GT(found, 0u);
+  EXPECT_LT(table.MemorySize(), rows.size() * 16);
+  RecordProperty(
+      "line_lookup_ns",
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+              .count() /
+          7000);
+
+  start = std::chrono::steady_clock::now();
+  uint32_t checksum = 0;
+  for (const Row &row : rows)
+    checksum += table.LowerBoundForAddress(row.file_addr + 1);
+  end = std::chrono::steady_clock::now();
+  EXPECT_GT(checksum, 0u);
+  RecordProperty(
+      "address_lookup_ns",
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+              .count() /
+          rows.size());
+}
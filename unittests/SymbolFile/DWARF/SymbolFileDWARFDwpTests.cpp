@@ -0,0 +1,159 @@
+//===-- SymbolFileDWARFDwpTests.cpp -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwp.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Testing/Support/Error.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+class SymbolFileDWARFDwpTests : public testing::Test {
+public:
+  void SetUp() override {
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+  }
+
+  void TearDown() override {
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+  }
+};
+
+static void AppendHex(std::string &hex, uint64_t value, unsigned byte_size) {
+  for (unsigned i = 0; i < byte_size; ++i)
+    hex += llvm::formatv("{0:x-2}", (value >> (8 * i)) & 0xff).str();
+}
+
+static uint64_t GetSignature(uint32_t unit) {
+  return 0x1000000000000000ULL + unit;
+}
+
+TEST_F(SymbolFileDWARFDwpTests, ReadsOnlyTheRequestedUnit) {
+  const uint32_t num_units = 4;
+  const uint32_t num_slots = 8;
+  const uint32_t info_size = 256 * 1024;
+  const uint32_t abbrev_size = 4;
+
+  // A version 2 .debug_cu_index with .debug_info.dwo and .debug_abbrev.dwo
+  // columns, and unit i in slot i.
+  std::string cu_index;
+  AppendHex(cu_index, 2, 4);
+  AppendHex(cu_index, 2, 4);
+  AppendHex(cu_index, num_units, 4);
+  AppendHex(cu_index, num_slots, 4);
+  for (uint32_t slot = 0; slot < num_slots; ++slot)
+    AppendHex(cu_index, slot < num_units ? GetSignature(slot) : 0, 8);
+  for (uint32_t slot = 0; slot < num_slots; ++slot)
+    AppendHex(cu_index, slot < num_units ? slot + 1 : 0, 4);
+  AppendHex(cu_index, llvm::DW_SECT_INFO, 4);
+  AppendHex(cu_index, llvm::DW_SECT_ABBREV, 4);
+  for (uint32_t unit = 0; unit < num_units; ++unit) {
+    AppendHex(cu_index, unit * info_size, 4);
+    AppendHex(cu_index, unit * abbrev_size, 4);
+  }
+  for (uint32_t unit = 0; unit < num_units; ++unit) {
+    AppendHex(cu_index, info_size, 4);
+    AppendHex(cu_index, abbrev_size, 4);
+  }
+
+  // Each unit's abbreviations hold its number, so we can tell them apart.
+  std::string abbrev;
+  for (uint32_t unit = 0; unit < num_units; ++unit)
+    AppendHex(abbrev, unit, abbrev_size);
+
+  const std::string yaml = llvm::formatv(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_REL
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .debug_info.dwo
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_EXCLUDE ]
+    Size:            {0}
+  - Name:            .debug_abbrev.dwo
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_EXCLUDE ]
+    Content:         {1}
+  - Name:            .debug_str.dwo
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_EXCLUDE, SHF_MERGE, SHF_STRINGS ]
+    Content:         6100
+  - Name:            .debug_cu_index
+    Type:            SHT_PROGBITS
+    Content:         {2}
+...
+)",
+                                         num_units * info_size, abbrev,
+                                         cu_index)
+                               .str();
+  auto ExpectedFile = TestFile::fromYaml(yaml);
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  FileSpec file(ExpectedFile->name());
+  auto module_sp = std::make_shared<Module>(ModuleSpec(file));
+  std::unique_ptr<SymbolFileDWARFDwp> dwp =
+      SymbolFileDWARFDwp::Create(module_sp, file);
+  ASSERT_NE(nullptr, dwp);
+
+  // Opening the package only reads its headers and index.
+  const uint64_t file_size = FileSystem::Instance().GetByteSize(file);
+  const uint64_t index_loaded = dwp->GetLoadedByteSize();
+  EXPECT_GT(file_size, num_units * info_size);
+  EXPECT_LT(index_loaded, 4096u);
+
+  EXPECT_EQ(nullptr, dwp->GetObjectFileForDwoId(GetSignature(num_units)));
+  EXPECT_EQ(index_loaded, dwp->GetLoadedByteSize());
+
+  ObjectFileSP unit_sp = dwp->GetObjectFileForDwoId(GetSignature(2));
+  ASSERT_NE(nullptr, unit_sp);
+  SectionList *sections = unit_sp->GetSectionList(false);
+  ASSERT_NE(nullptr, sections);
+
+  SectionSP info_sp =
+      sections->FindSectionByType(eSectionTypeDWARFDebugInfoDwo, false);
+  ASSERT_NE(nullptr, info_sp);
+  EXPECT_EQ(info_size, info_sp->GetFileSize());
+
+  SectionSP abbrev_sp =
+      sections->FindSectionByType(eSectionTypeDWARFDebugAbbrevDwo, false);
+  ASSERT_NE(nullptr, abbrev_sp);
+  DataExtractor abbrev_data;
+  ASSERT_EQ(abbrev_size, abbrev_sp->GetSectionData(abbrev_data));
+  lldb::offset_t offset = 0;
+  EXPECT_EQ(2u, abbrev_data.GetU32(&offset));
+
+  SectionSP str_sp =
+      sections->FindSectionByType(eSectionTypeDWARFDebugStrDwo, false);
+  ASSERT_NE(nullptr, str_sp);
+  DataExtractor str_data;
+  ASSERT_EQ(2u, str_sp->GetSectionData(str_data));
+  EXPECT_STREQ("a", str_data.PeekCStr(0));
+
+  // Only the unit's contributions and the shared strings were read.
+  EXPECT_EQ(index_loaded + info_size + abbrev_size + 2,
+            dwp->GetLoadedByteSize());
+
+  // Another unit reuses the strings.
+  ASSERT_NE(nullptr, dwp->GetObjectFileForDwoId(GetSignature(0)));
+  EXPECT_EQ(index_loaded + 2 * (info_size + abbrev_size) + 2,
+            dwp->GetLoadedByteSize());
+}
@@ -0,0 +1,177 @@
+//===-- LazyModuleParsingTest.cpp -------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Target/Platform.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/Reproducer.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+using namespace lldb_private::repro;
+using namespace lldb;
+
+namespace {
+class LazyModuleParsingTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    llvm::cantFail(Reproducer::Initialize(ReproducerMode::Off, llvm::None));
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    SymbolFileSymtab::Initialize();
+    platform_linux::PlatformLinux::Initialize();
+
+    ArchSpec arch("x86_64-pc-linux");
+    Platform::SetHostPlatform(
+        platform_linux::PlatformLinux::CreateInstance(true, &arch));
+    m_debugger_sp = Debugger::CreateInstance();
+  }
+
+  void TearDown() override {
+    m_debugger_sp->SetPropertyValue(nullptr, eVarSetOperationClear,
+                                    "target.lazy-module-parsing", "");
+    Debugger::Destroy(m_debugger_sp);
+    platform_linux::PlatformLinux::Terminate();
+    SymbolFileSymtab::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+    Reproducer::Terminate();
+  }
+
+protected:
+  /// Load the module described by \a spec into a new target, with module
+  /// parsing lazy or not, and look up the load address of its base address
+  /// and symbols, and what these addresses resolve to.
+  std::vector<std::string> LoadAndLookUp(const ModuleSpec &spec, bool lazy,
+                                         bool &sections_parsed_on_load) {
+    std::vector<std::string> results;
+    EXPECT_TRUE(m_debugger_sp
+                    ->SetPropertyValue(nullptr, eVarSetOperationAssign,
+                                       "target.lazy-module-parsing",
+                                       lazy ? "true" : "false")
+                    .Success());
+
+    TargetSP target_sp;
+    PlatformSP platform_sp;
+    m_debugger_sp->GetTargetList().CreateTarget(
+        *m_debugger_sp, "", ArchSpec("x86_64-pc-linux"), eLoadDependentsNo,
+        platform_sp, target_sp);
+    EXPECT_TRUE(target_sp);
+    if (!target_sp)
+      return results;
+    EXPECT_EQ(lazy, target_sp->GetLazyModuleParsing());
+
+    auto module_sp = std::make_shared<Module>(spec);
+    bool changed = false;
+    EXPECT_TRUE(module_sp->SetLoadAddress(*target_sp, 0x10000, true, changed));
+    sections_parsed_on_load = module_sp->HasParsedSections();
+
+    results.push_back(llvm::formatv(
+        "base {0:x}",
+        module_sp->GetObjectFile()->GetBaseAddress().GetLoadAddress(
+            target_sp.get())));
+
+    for (const char *name : {"_start", "Y"}) {
+      const Symbol *symbol = module_sp->FindFirstSymbolWithNameAndType(
+          ConstString(name), eSymbolTypeAny);
+      EXPECT_NE(nullptr, symbol) << name;
+      if (!symbol)
+        continue;
+      const addr_t load_addr =
+          symbol->GetAddress().GetLoadAddress(target_sp.get());
+      Address resolved;
+      EXPECT_TRUE(target_sp->ResolveLoadAddress(load_addr, resolved));
+      SectionSP section_sp = resolved.GetSection();
+      results.push_back(llvm::formatv(
+          "{0} {1:x} {2}+{3:x}", name, load_addr,
+          section_sp ? section_sp->GetName().GetStringRef() : "<none>",
+          resolved.GetOffset()));
+    }
+    return results;
+  }
+
+  DebuggerSP m_debugger_sp;
+};
+} // namespace
+
+TEST_F(LazyModuleParsingTest, LookupsMatchEagerParsing) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_EXEC
+  Machine:         EM_X86_64
+  Entry:           0x0000000000400000
+Sections:
+  - Name:            .text
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC, SHF_EXECINSTR ]
+    Address:         0x0000000000400000
+    AddressAlign:    0x0000000000000010
+    Content:         554889E58B042510004000890425000000
+  - Name:            .data
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_WRITE, SHF_ALLOC ]
+    Address:         0x0000000000400020
+    AddressAlign:    0x0000000000000010
+    Content:         2F000000
+ProgramHeaders:
+  - Type: PT_LOAD
+    Flags: [ PF_X, PF_W, PF_R ]
+    VAddr: 0x400000
+    Align: 0x1000
+    Sections:
+      - Section: .text
+      - Section: .data
+Symbols:
+  - Name:            _start
+    Type:            STT_FUNC
+    Section:         .text
+    Value:           0x0000000000400000
+    Size:            0x0000000000000011
+    Binding:         STB_GLOBAL
+  - Name:            Y
+    Type:            STT_OBJECT
+    Section:         .data
+    Value:           0x0000000000400020
+    Size:            0x0000000000000004
+    Binding:         STB_GLOBAL
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+  ModuleSpec spec{FileSpec(ExpectedFile->name())};
+
+  bool eager_parsed = false;
+  std::vector<std::string> eager = LoadAndLookUp(spec, false, eager_parsed);
+  EXPECT_TRUE(eager_parsed);
+  EXPECT_EQ(std::vector<std::string>({"base 0x410000",
+                                      "_start 0x410000 .text+0x0",
+                                      "Y 0x410020 .data+0x0"}),
+            eager);
+
+  bool lazy_parsed = true;
+  std::vector<std::string> lazy = LoadAndLookUp(spec, true, lazy_parsed);
+  EXPECT_FALSE(lazy_parsed);
+  EXPECT_EQ(eager, lazy);
+}
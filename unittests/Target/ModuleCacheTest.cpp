@@ -3,6 +3,8 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
 #include "Plugins/SymbolFile/Symtab/SymbolFileSymtab.h"
@@ -136,6 +138,15 @@ void ModuleCacheTest::TryGetAndPut(const FileSpec &cache_dir,
   EXPECT_STREQ(module_uuid, module_sp->GetUUID().GetAsString().c_str());
 }
 
+static void SetModificationTime(const FileSpec &file_spec,
+                                llvm::sys::TimePoint<> time) {
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::openFileForWrite(
+      file_spec.GetPath(), fd, llvm::sys::fs::CD_OpenExisting));
+  llvm::sys::fs::setLastAccessAndModificationTime(fd, time);
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+}
+
 TEST_F(ModuleCacheTest, GetAndPut) {
   FileSpec test_cache_dir = s_cache_dir;
   test_cache_dir.AppendPathComponent("GetAndPut");
@@ -169,3 +180,129 @@ TEST_F(ModuleCacheTest, GetAndPutStrangeHostname) {
   TryGetAndPut(test_cache_dir, "tab\tcolon:asterisk*", expect_download);
   VerifyDiskState(test_cache_dir, "tab_colon_asterisk_");
 }
+
+TEST_F(ModuleCacheTest, PutAndGetEntry) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PutAndGetEntry");
+
+  UUID uuid;
+  uuid.SetFromStringRef(module_uuid, uuid_bytes);
+  EXPECT_FALSE(ModuleCache::GetEntry(test_cache_dir, uuid, "data"));
+
+  const uint8_t data[] = {1, 2, 3, 4};
+  Status error = ModuleCache::PutEntry(test_cache_dir, uuid, "data", data);
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  FileSpec entry = ModuleCache::GetEntry(test_cache_dir, uuid, "data");
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(sizeof(data), FileSystem::Instance().GetByteSize(entry));
+
+  error = ModuleCache::PutEntry(test_cache_dir, uuid, module_name,
+                                FileSpec(s_test_executable));
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  FileSpec uuid_view = GetUuidView(test_cache_dir);
+  EXPECT_EQ(uuid_view,
+            ModuleCache::GetEntry(test_cache_dir, uuid, module_name));
+  EXPECT_EQ(module_size, FileSystem::Instance().GetByteSize(uuid_view));
+}
+
+TEST_F(ModuleCacheTest, Prune) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("Prune");
+
+  UUID old_uuid, new_uuid;
+  old_uuid.SetFromStringRef("11111111-2222-3333-4444-555555555555");
+  new_uuid.SetFromStringRef("66666666-7777-8888-9999-AAAAAAAAAAAA");
+  const std::vector<uint8_t> data(1000, 0);
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, old_uuid, "data", data).Success());
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, new_uuid, "data", data).Success());
+
+  // Looking up an entry doesn't change the cached file.
+  const llvm::sys::TimePoint<> file_time(std::chrono::seconds(1));
+  FileSpec old_entry = ModuleCache::GetEntry(test_cache_dir, old_uuid, "data");
+  ASSERT_TRUE(old_entry);
+  SetModificationTime(old_entry, file_time);
+  ASSERT_TRUE(ModuleCache::GetEntry(test_cache_dir, old_uuid, "data"));
+  EXPECT_EQ(file_time,
+            FileSystem::Instance().GetModificationTime(old_entry));
+
+  // Make the first module the least recently used one.
+  FileSpec last_used(old_entry.GetDirectory().GetStringRef());
+  last_used.AppendPathComponent(".last-used");
+  ASSERT_TRUE(FileSystem::Instance().Exists(last_used));
+  SetModificationTime(last_used, file_time);
+
+  EXPECT_EQ(2 * data.size(),
+            ModuleCache::Prune(test_cache_dir, 2 * data.size()));
+  EXPECT_TRUE(FileSystem::Instance().Exists(old_entry));
+
+  EXPECT_EQ(data.size(), ModuleCache::Prune(test_cache_dir, data.size()));
+  EXPECT_FALSE(ModuleCache::GetEntry(test_cache_dir, old_uuid, "data"));
+  EXPECT_TRUE(ModuleCache::GetEntry(test_cache_dir, new_uuid, "data"));
+}
+
+TEST_F(ModuleCacheTest, PruneRemovesTempEntries) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PruneRemovesTempEntries");
+
+  UUID uuid;
+  uuid.SetFromStringRef("11111111-2222-3333-4444-555555555555");
+  const std::vector<uint8_t> data(1000, 0);
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, uuid, "data", data).Success());
+
+  // Leave behind the temporary file of an interrupted write.
+  FileSpec entry = ModuleCache::GetEntry(test_cache_dir, uuid, "data");
+  ASSERT_TRUE(entry);
+  FileSpec temp_entry(entry.GetDirectory().GetStringRef());
+  temp_entry.AppendPathComponent(".entry-12345678");
+  {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(temp_entry.GetPath(), ec);
+    ASSERT_FALSE(ec);
+    os.write(reinterpret_cast<const char *>(data.data()), data.size());
+  }
+
+  // It doesn't count towards the size of the cache, and is removed.
+  EXPECT_EQ(data.size(), ModuleCache::Prune(test_cache_dir, 2 * data.size()));
+  EXPECT_FALSE(FileSystem::Instance().Exists(temp_entry));
+  EXPECT_TRUE(ModuleCache::GetEntry(test_cache_dir, uuid, "data"));
+}
+
+TEST_F(ModuleCacheTest, PruneIfNeeded) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PruneIfNeeded");
+
+  UUID uuids[3];
+  uuids[0].SetFromStringRef("11111111-2222-3333-4444-555555555555");
+  uuids[1].SetFromStringRef("66666666-7777-8888-9999-AAAAAAAAAAAA");
+  uuids[2].SetFromStringRef("BBBBBBBB-CCCC-DDDD-EEEE-FFFFFFFFFFFF");
+  const std::vector<uint8_t> data(1000, 0);
+  const uint64_t max_size = 2 * data.size();
+
+  // The first entry makes the cache get scanned.
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, uuids[0], "data", data).Success());
+  ModuleCache::PruneIfNeeded(test_cache_dir, max_size, data.size());
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, uuids[1], "data", data).Success());
+  ModuleCache::PruneIfNeeded(test_cache_dir, max_size, data.size());
+  EXPECT_TRUE(ModuleCache::GetEntry(test_cache_dir, uuids[0], "data"));
+
+  // The third entry crosses the limit, so the least recently used module is
+  // evicted.
+  ASSERT_TRUE(
+      ModuleCache::PutEntry(test_cache_dir, uuids[2], "data", data).Success());
+  FileSpec last_used(
+      ModuleCache::GetEntry(test_cache_dir, uuids[0], "data")
+          .GetDirectory()
+          .GetStringRef());
+  last_used.AppendPathComponent(".last-used");
+  SetModificationTime(last_used,
+                      llvm::sys::TimePoint<>(std::chrono::seconds(1)));
+  ModuleCache::PruneIfNeeded(test_cache_dir, max_size, data.size());
+  EXPECT_FALSE(ModuleCache::GetEntry(test_cache_dir, uuids[0], "data"));
+  EXPECT_TRUE(ModuleCache::GetEntry(test_cache_dir, uuids[1], "data"));
+  EXPECT_TRUE(ModuleCache::GetEntry(test_cache_dir, uuids[2], "data"));
+}
@@ -0,0 +1,66 @@
+//===-- CRC32Test.cpp -------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/CRC32.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <vector>
+
+using namespace lldb_private;
+
+static llvm::ArrayRef<uint8_t> Bytes(llvm::StringRef str) {
+  return llvm::ArrayRef<uint8_t>(str.bytes_begin(), str.bytes_end());
+}
+
+static std::vector<uint8_t> MakeData(size_t size) {
+  std::vector<uint8_t> data(size);
+  uint32_t state = 0x12345678;
+  for (uint8_t &byte : data) {
+    state = state * 1103515245 + 12345;
+    byte = state >> 24;
+  }
+  return data;
+}
+
+TEST(CRC32Test, KnownValues) {
+  EXPECT_EQ(0u, CalculateCRC32(0, {}));
+  EXPECT_EQ(0xcbf43926u, CalculateCRC32(0, Bytes("123456789")));
+  EXPECT_EQ(0x414fa339u,
+            CalculateCRC32(0, Bytes("The quick brown fox jumps over the "
+                                    "lazy dog")));
+  EXPECT_EQ(0xcbf43926u,
+            CalculateCRC32(CalculateCRC32(0, Bytes("1234")), Bytes("56789")));
+}
+
+TEST(CRC32Test, MatchesPortable) {
+  std::vector<uint8_t> data = MakeData(70000);
+  llvm::ArrayRef<uint8_t> ref(data);
+  for (size_t size : {0, 1, 15, 16, 63, 64, 65, 100, 128, 4097, 70000})
+    for (size_t offset : {0, 1, 7})
+      if (offset + size <= ref.size()) {
+        llvm::ArrayRef<uint8_t> slice = ref.slice(offset, size);
+        EXPECT_EQ(CalculateCRC32Portable(0x1234, slice),
+                  CalculateCRC32(0x1234, slice))
+            << "size " << size << " offset " << offset;
+      }
+}
+
+TEST(CRC32Test, Combine) {
+  std::vector<uint8_t> data = MakeData(10000);
+  llvm::ArrayRef<uint8_t> ref(data);
+  const uint32_t whole = CalculateCRC32(0, ref);
+  for (size_t split : {0, 1, 64, 1000, 9999, 10000}) {
+    llvm::ArrayRef<uint8_t> a = ref.take_front(split);
+    llvm::ArrayRef<uint8_t> b = ref.drop_front(split);
+    EXPECT_EQ(whole, CombineCRC32(CalculateCRC32(0, a), CalculateCRC32(0, b),
+                                  b.size()))
+        << "split " << split;
+  }
+}
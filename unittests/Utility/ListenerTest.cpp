@@ -9,9 +9,14 @@
 #include "gtest/gtest.h"
 
 #include "lldb/Utility/Broadcaster.h"
+#include "lldb/Utility/Event.h"
 #include "lldb/Utility/Listener.h"
+#include <chrono>
 #include <future>
+#include <map>
+#include <memory>
 #include <thread>
+#include <vector>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -111,3 +116,71 @@ TEST(ListenerTest, GetEventWait) {
       &broadcaster, event_mask, event_sp, llvm::None));
   async_broadcast.get();
 }
+
+// Broadcast num_events events from each of the broadcasters on a thread of
+// its own, using the sequence number as the event type, and receive them all.
+static void
+BroadcastConcurrently(std::vector<std::unique_ptr<Broadcaster>> &broadcasters,
+                      uint32_t num_events,
+                      std::map<Broadcaster *, uint32_t> &received) {
+  ListenerSP listener_sp = Listener::MakeListener("test-listener");
+  for (auto &broadcaster_up : broadcasters)
+    ASSERT_EQ(UINT32_MAX, listener_sp->StartListeningForEvents(
+                              broadcaster_up.get(), UINT32_MAX));
+
+  std::vector<std::future<void>> senders;
+  for (auto &broadcaster_up : broadcasters) {
+    Broadcaster *broadcaster = broadcaster_up.get();
+    senders.push_back(std::async(std::launch::async, [=] {
+      for (uint32_t i = 1; i <= num_events; ++i)
+        broadcaster->BroadcastEvent(i, nullptr);
+    }));
+  }
+
+  EventSP event_sp;
+  for (size_t i = 0; i < broadcasters.size() * num_events; ++i) {
+    ASSERT_TRUE(listener_sp->GetEvent(event_sp, std::chrono::seconds(10)));
+    // Each broadcaster's events arrive in the order they were sent.
+    uint32_t &last = received[event_sp->GetBroadcaster()];
+    ASSERT_EQ(last + 1, event_sp->GetType());
+    last = event_sp->GetType();
+  }
+  for (std::future<void> &sender : senders)
+    sender.get();
+  EXPECT_FALSE(listener_sp->GetEvent(event_sp, std::chrono::seconds(0)));
+}
+
+static std::vector<std::unique_ptr<Broadcaster>>
+MakeBroadcasters(size_t count) {
+  std::vector<std::unique_ptr<Broadcaster>> broadcasters;
+  for (size_t i = 0; i < count; ++i)
+    broadcasters.push_back(
+        std::make_unique<Broadcaster>(nullptr, "test-broadcaster"));
+  return broadcasters;
+}
+
+TEST(ListenerTest, ConcurrentBroadcasters) {
+  std::vector<std::unique_ptr<Broadcaster>> broadcasters = MakeBroadcasters(4);
+  std::map<Broadcaster *, uint32_t> received;
+  BroadcastConcurrently(broadcasters, 1000, received);
+  ASSERT_EQ(broadcasters.size(), received.size());
+  for (const auto &entry : received)
+    EXPECT_EQ(1000u, entry.second);
+}
+
+TEST(ListenerTest, EventThroughputBenchmark) {
+  const uint32_t num_events = 50000;
+  std::vector<std::unique_ptr<Broadcaster>> broadcasters = MakeBroadcasters(8);
+  std::map<Broadcaster *, uint32_t> received;
+  auto start = std::chrono::steady_clock::now();
+  BroadcastConcurrently(broadcasters, num_events, received);
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(broadcasters.size(), received.size());
+
+  const int64_t elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+          .count();
+  RecordProperty("events_per_second",
+                 int(broadcasters.size() * num_events * 1000000 /
+                     std::max<int64_t>(elapsed_us, 1)));
+}
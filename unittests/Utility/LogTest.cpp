@@ -45,6 +45,12 @@ static bool DisableChannel(llvm::StringRef channel,
   return Log::DisableLogChannel(channel, categories, error_stream);
 }
 
+static bool DumpChannel(llvm::StringRef channel, std::string &result) {
+  result.clear();
+  llvm::raw_string_ostream result_stream(result);
+  return Log::DumpLogChannel(channel, result_stream, result_stream);
+}
+
 static bool ListCategories(llvm::StringRef channel, std::string &result) {
   result.clear();
   llvm::raw_string_ostream result_stream(result);
@@ -311,3 +317,66 @@ TEST_F(LogChannelEnabledTest, LogGetLogThread) {
   // any undefined behavior (run the test under TSAN to verify this).
   EXPECT_THAT(mask, testing::AnyOf(0, FOO));
 }
+
+TEST_F(LogChannelEnabledTest, LogAsync) {
+  std::string err;
+  EXPECT_TRUE(EnableChannel(getStream(),
+                            LLDB_LOG_OPTION_ASYNC |
+                                LLDB_LOG_OPTION_PREPEND_SEQUENCE,
+                            "chan", {}, err));
+
+  // Messages from each thread come out in the order they were logged in.
+  const int num_threads = 4, num_messages = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+    threads.emplace_back([this, t] {
+      for (int i = 0; i < num_messages; ++i)
+        LLDB_LOG(getLog(), "{0} {1}", t, i);
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+  Log::FlushAsyncMessages();
+
+  llvm::SmallVector<llvm::StringRef, 0> lines;
+  takeOutput().split(lines, '\n', -1, false);
+  ASSERT_EQ(size_t(num_threads * num_messages), lines.size());
+  std::vector<int> next(num_threads, 0);
+  for (llvm::StringRef line : lines) {
+    unsigned seq;
+    int t, i;
+    ASSERT_EQ(3, sscanf(line.str().c_str(), "%u %d %d", &seq, &t, &i))
+        << line.str();
+    ASSERT_EQ(next[t], i) << line.str();
+    ++next[t];
+  }
+
+  // Disabling the channel writes out what is still queued.
+  LLDB_LOG(getLog(), "Hello World");
+  EXPECT_TRUE(DisableChannel("chan", {}, err));
+  EXPECT_THAT(takeOutput().str(), testing::EndsWith(" Hello World\n"));
+}
+
+TEST_F(LogChannelEnabledTest, LogBuffer) {
+  std::string err, dump;
+  EXPECT_FALSE(DumpChannel("chan", dump));
+  EXPECT_EQ("Log channel 'chan' is not logging to a buffer.\n", dump);
+  EXPECT_FALSE(DumpChannel("chanchan", dump));
+
+  llvm::raw_string_ostream error_stream(err);
+  ASSERT_TRUE(Log::EnableLogChannel(getStream(), 0, "chan", {}, error_stream,
+                                    64));
+  Log *log = test_channel.GetLogIfAll(FOO);
+  ASSERT_NE(nullptr, log);
+  LLDB_LOG(log, "Hello World");
+  EXPECT_EQ("", takeOutput());
+  EXPECT_TRUE(DumpChannel("chan", dump));
+  EXPECT_EQ("Hello World\n", dump);
+
+  // Only whole lines of the most recent messages are kept.
+  for (int i = 0; i < 100; ++i)
+    LLDB_LOG(log, "message {0}", i);
+  EXPECT_TRUE(DumpChannel("chan", dump));
+  EXPECT_EQ("message 95\nmessage 96\nmessage 97\nmessage 98\nmessage 99\n",
+            dump);
+  EXPECT_EQ("", takeOutput());
+}
@@ -63,3 +63,38 @@ TEST(RegularExpression, Match) {
   EXPECT_EQ("a", matches[1].str());
   EXPECT_EQ("513", matches[2].str());
 }
+
+TEST(RegularExpression, RequiredSubstring) {
+  EXPECT_EQ("foo", RegularExpression("foo").GetRequiredSubstring());
+  EXPECT_EQ("foo", RegularExpression("^foo$").GetRequiredSubstring());
+  EXPECT_EQ("Bar::", RegularExpression("^Bar::.*").GetRequiredSubstring());
+  EXPECT_EQ("ab", RegularExpression("abc?d").GetRequiredSubstring());
+  EXPECT_EQ("get_",
+            RegularExpression("[a-z]+get_[0-9]").GetRequiredSubstring());
+  EXPECT_EQ("a.b", RegularExpression("a\\.b").GetRequiredSubstring());
+  EXPECT_EQ("ef", RegularExpression("a(bcd)?ef").GetRequiredSubstring());
+  EXPECT_EQ("", RegularExpression("foo|bar").GetRequiredSubstring());
+  EXPECT_EQ("", RegularExpression("[[:alpha:]]*").GetRequiredSubstring());
+
+  EXPECT_TRUE(RegularExpression("foo").IsSubstringMatch());
+  EXPECT_FALSE(RegularExpression("^foo").IsSubstringMatch());
+  EXPECT_FALSE(RegularExpression("fo+").IsSubstringMatch());
+}
+
+TEST(RegularExpression, LiteralMatch) {
+  for (StringRef text : {"foo", "^foo", "foo$", "^foo$", "f\\.o", "^f\\.o$",
+                         "fo+", "f.o", "^foo.*$", "(foo)", "x?foo"}) {
+    RegularExpression regex(text);
+    Regex reference(text);
+    for (StringRef str : {"", "foo", "xfoo", "foox", "xfoox", "f.o", "fo",
+                          "ffoo", "foofoo", "afoobfoo"}) {
+      SmallVector<StringRef, 2> expected_matches;
+      SmallVector<StringRef, 2> matches;
+      const bool expected = reference.match(str, &expected_matches);
+      EXPECT_EQ(expected, regex.Execute(str)) << text << " " << str;
+      EXPECT_EQ(expected, regex.Execute(str, &matches)) << text << " " << str;
+      if (expected)
+        EXPECT_EQ(expected_matches[0], matches[0]) << text << " " << str;
+    }
+  }
+}